@@ -0,0 +1,57 @@
+#include "../headers/s21_map.h"
+#include "benchmark.h"
+
+namespace s21_bench {
+inline void AggregateBenchmark() {
+  const int count = 1000000;
+  const int queries = 2000;
+  const int window = 100000;
+  using volume_map = s21::map<int, long, std::less<int>,
+                              s21::summary_traits<s21::mapped_sum<long>>>;
+  s21::map<int, long> plain;
+  volume_map summed;
+  for (int key = 0; key < count; ++key) {
+    plain.insert(key, key % 97);
+    summed.insert(key, key % 97);
+  }
+  std::vector<int> starts = RandomKeys(queries);
+  for (int &start : starts) {
+    start %= count - window;
+  }
+
+  Title("2K window sums of 100K keys over a 1M map");
+  long total = 0;
+  Report("s21::map iterator walk", Measure([&] {
+           for (int start : starts) {
+             for (auto it = plain.find(start);
+                  it != plain.end() && (*it).first < start + window; ++it) {
+               total += (*it).second;
+             }
+           }
+         }),
+         queries);
+  Report("summary_traits aggregate()", Measure([&] {
+           for (int start : starts) {
+             total += summed.aggregate(start, start + window);
+           }
+         }),
+         queries);
+  s21::map<int, long> plain_insert;
+  volume_map summed_insert;
+  std::vector<int> keys = RandomKeys(count);
+  Report("s21::map insert", Measure([&] {
+           for (int key : keys) {
+             plain_insert.insert(key, key);
+           }
+         }),
+         count);
+  Report("summary_traits insert", Measure([&] {
+           for (int key : keys) {
+             summed_insert.insert(key, key);
+           }
+         }),
+         count);
+  DoNotOptimize(total);
+}
+
+}  // namespace s21_bench
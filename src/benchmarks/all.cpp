@@ -0,0 +1,62 @@
+#include <cstring>
+
+#include "aggregate_bench.h"
+#include "art_bench.h"
+#include "batch_bench.h"
+#include "btree_bench.h"
+#include "concurrent_map_bench.h"
+#include "copy_bench.h"
+#include "counted_bench.h"
+#include "emplace_bench.h"
+#include "erase_bench.h"
+#include "frozen_bench.h"
+#include "hint_bench.h"
+#include "interval_bench.h"
+#include "memory_bench.h"
+#include "mapped_bench.h"
+#include "merge_bench.h"
+#include "node_handle_bench.h"
+#include "node_pool_bench.h"
+#include "rcu_bench.h"
+#include "set_algebra_bench.h"
+#include "snapshot_bench.h"
+#include "stats_bench.h"
+#include "threaded_bench.h"
+
+struct Benchmark {
+  const char *name;
+  void (*run)();
+};
+
+int main(int argc, char **argv) {
+  const Benchmark benchmarks[] = {
+      {"node_pool", s21_bench::NodePoolBenchmark},
+      {"merge", s21_bench::MergeBenchmark},
+      {"set_algebra", s21_bench::SetAlgebraBenchmark},
+      {"btree", s21_bench::BtreeBenchmark},
+      {"hint", s21_bench::HintBenchmark},
+      {"copy", s21_bench::CopyBenchmark},
+      {"memory", s21_bench::MemoryBenchmark},
+      {"snapshot", s21_bench::SnapshotBenchmark},
+      {"rcu", s21_bench::RcuBenchmark},
+      {"concurrent_map", s21_bench::ConcurrentMapBenchmark},
+      {"frozen", s21_bench::FrozenBenchmark},
+      {"batch", s21_bench::BatchBenchmark},
+      {"erase", s21_bench::EraseBenchmark},
+      {"node_handle", s21_bench::NodeHandleBenchmark},
+      {"emplace", s21_bench::EmplaceBenchmark},
+      {"counted", s21_bench::CountedBenchmark},
+      {"aggregate", s21_bench::AggregateBenchmark},
+      {"interval", s21_bench::IntervalBenchmark},
+      {"stats", s21_bench::StatsBenchmark},
+      {"threaded", s21_bench::ThreadedBenchmark},
+      {"mapped", s21_bench::MappedBenchmark},
+      {"art", s21_bench::ArtBenchmark},
+  };
+  for (const Benchmark &benchmark : benchmarks) {
+    if (argc < 2 || std::strstr(benchmark.name, argv[1]) != nullptr) {
+      benchmark.run();
+    }
+  }
+  return 0;
+}
@@ -0,0 +1,93 @@
+#include <cstdint>
+#include <string>
+
+#include "../headers/s21_art_map.h"
+#include "../headers/s21_art_set.h"
+#include "../headers/s21_map.h"
+#include "../headers/s21_set.h"
+#include "benchmark.h"
+
+namespace s21_bench {
+template <typename Map>
+void RunArtMapWorkload(const char *name,
+                       const std::vector<std::uint64_t> &keys) {
+  char label[64];
+  Map map;
+  std::snprintf(label, sizeof(label), "%s insert", name);
+  Report(label, Measure([&] {
+           for (std::uint64_t key : keys) {
+             map.insert(key, key);
+           }
+         }),
+         keys.size());
+  std::uint64_t sum = 0;
+  std::snprintf(label, sizeof(label), "%s find", name);
+  Report(label, Measure([&] {
+           for (std::uint64_t key : keys) {
+             sum += map.find(key) != map.end() ? 1 : 0;
+           }
+         }),
+         keys.size());
+  DoNotOptimize(sum);
+}
+
+template <typename Set>
+void RunArtSetWorkload(const char *name, const std::vector<std::string> &keys) {
+  char label[64];
+  Set set;
+  std::snprintf(label, sizeof(label), "%s insert", name);
+  Report(label, Measure([&] {
+           for (const std::string &key : keys) {
+             set.insert(key);
+           }
+         }),
+         keys.size());
+  std::size_t found = 0;
+  std::snprintf(label, sizeof(label), "%s find", name);
+  Report(label, Measure([&] {
+           for (const std::string &key : keys) {
+             found += set.contains(key) ? 1 : 0;
+           }
+         }),
+         keys.size());
+  DoNotOptimize(found);
+}
+
+inline void ArtBenchmark() {
+  const std::size_t count = 1000000;
+  std::vector<int> order = RandomKeys(count);
+  std::vector<std::uint64_t> numbers;
+  std::vector<std::string> strings;
+  std::mt19937_64 random(25);
+  for (int index : order) {
+    numbers.push_back(random());
+    strings.push_back("tenant/" + std::to_string(index % 100) + "/user/" +
+                      std::to_string(index));
+  }
+
+  Title("1M random uint64_t keys: red-black tree against radix tree");
+  RunArtMapWorkload<s21::map<std::uint64_t, std::uint64_t>>("s21::map",
+                                                            numbers);
+  RunArtMapWorkload<s21::art_map<std::uint64_t, std::uint64_t>>(
+      "s21::art_map", numbers);
+
+  Title("1M \"tenant/N/user/M\" strings: red-black tree against radix tree");
+  RunArtSetWorkload<s21::set<std::string>>("s21::set", strings);
+  RunArtSetWorkload<s21::art_set<std::string>>("s21::art_set", strings);
+
+  s21::art_set<std::string> set(strings.begin(), strings.end());
+  std::size_t matched = 0;
+  Report("s21::art_set prefix_range x100", Measure([&] {
+           for (int tenant = 0; tenant < 100; ++tenant) {
+             auto range =
+                 set.prefix_range("tenant/" + std::to_string(tenant) + "/");
+             for (auto it = range.first; it != range.second; ++it) {
+               ++matched;
+             }
+           }
+         }),
+         count);
+  DoNotOptimize(matched);
+}
+
+}  // namespace s21_bench
@@ -0,0 +1,61 @@
+#include <algorithm>
+#include <cstdio>
+#include <iterator>
+
+#include "../headers/s21_set.h"
+#include "benchmark.h"
+
+namespace s21_bench {
+inline void BatchBenchmark() {
+  const std::size_t batch = 512;
+  for (std::size_t count : {std::size_t{1000}, std::size_t{4000000}}) {
+    const std::vector<int> keys = RandomKeys(count);
+    std::vector<int> probes = RandomKeys(2 * count, 5);
+    probes.resize(std::min(probes.size(), std::size_t{4000000}));
+    s21::set<int> set(keys.begin(), keys.end());
+
+    char title[96];
+    std::snprintf(title, sizeof(title),
+                  "%zu random lookups in %zu ints, batches of %zu",
+                  probes.size(), count, batch);
+    Title(title);
+    std::vector<bool> one_by_one(batch);
+    Report("s21::set contains(), one key at a time", Measure([&] {
+             for (std::size_t first = 0; first < probes.size();
+                  first += batch) {
+               std::size_t last = std::min(first + batch, probes.size());
+               for (std::size_t i = first; i < last; ++i) {
+                 one_by_one[i - first] = set.contains(probes[i]);
+               }
+             }
+           }),
+           probes.size());
+    bool batched[batch];
+    Report("s21::set contains_batch()", Measure([&] {
+             for (std::size_t first = 0; first < probes.size();
+                  first += batch) {
+               std::size_t last = std::min(first + batch, probes.size());
+               set.contains_batch(probes.begin() + first,
+                                  probes.begin() + last, batched);
+             }
+           }),
+           probes.size());
+    std::vector<s21::set<int>::iterator> found;
+    found.reserve(batch);
+    Report("s21::set find_batch()", Measure([&] {
+             for (std::size_t first = 0; first < probes.size();
+                  first += batch) {
+               std::size_t last = std::min(first + batch, probes.size());
+               found.clear();
+               set.find_batch(probes.begin() + first, probes.begin() + last,
+                              std::back_inserter(found));
+             }
+           }),
+           probes.size());
+    DoNotOptimize(one_by_one);
+    DoNotOptimize(batched);
+    DoNotOptimize(found);
+  }
+}
+
+}  // namespace s21_bench
@@ -0,0 +1,48 @@
+#ifndef CONTAINERS_BENCHMARKS_BENCHMARK_H_
+#define CONTAINERS_BENCHMARKS_BENCHMARK_H_
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <numeric>
+#include <random>
+#include <vector>
+
+namespace s21_bench {
+template <typename Function>
+double Measure(Function &&function) {
+  auto start = std::chrono::steady_clock::now();
+  function();
+  auto finish = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::milli>(finish - start).count();
+}
+
+inline void Report(const char *name, double milliseconds,
+                   std::size_t operations) {
+  double mops = milliseconds > 0 ? operations / milliseconds / 1000.0 : 0.0;
+  std::printf("  %-44s %10.2f ms %10.2f Mops/s\n", name, milliseconds, mops);
+}
+
+inline void Title(const char *name) { std::printf("\n%s\n", name); }
+
+inline std::vector<int> SortedKeys(std::size_t count) {
+  std::vector<int> keys(count);
+  std::iota(keys.begin(), keys.end(), 0);
+  return keys;
+}
+
+inline std::vector<int> RandomKeys(std::size_t count, unsigned seed = 21) {
+  std::vector<int> keys = SortedKeys(count);
+  std::shuffle(keys.begin(), keys.end(), std::mt19937(seed));
+  return keys;
+}
+
+// Keeps the optimizer from discarding a computed value.
+template <typename T>
+inline void DoNotOptimize(const T &value) {
+  asm volatile("" : : "g"(&value) : "memory");
+}
+
+}  // namespace s21_bench
+
+#endif  // CONTAINERS_BENCHMARKS_BENCHMARK_H_
@@ -0,0 +1,59 @@
+#include "../headers/s21_btree_set.h"
+#include "../headers/s21_set.h"
+#include "benchmark.h"
+
+namespace s21_bench {
+template <typename Set>
+void RunSetWorkload(const char *name, const std::vector<int> &keys,
+                    const std::vector<int> &probes) {
+  char label[64];
+  Set set;
+  std::snprintf(label, sizeof(label), "%s insert random", name);
+  Report(label, Measure([&] {
+           for (int key : keys) {
+             set.insert(key);
+           }
+         }),
+         keys.size());
+
+  std::size_t found = 0;
+  std::snprintf(label, sizeof(label), "%s find random", name);
+  Report(label, Measure([&] {
+           for (int key : probes) {
+             found += set.contains(key) ? 1 : 0;
+           }
+         }),
+         probes.size());
+  DoNotOptimize(found);
+
+  long long sum = 0;
+  std::snprintf(label, sizeof(label), "%s iterate", name);
+  Report(label, Measure([&] {
+           for (int key : set) {
+             sum += key;
+           }
+         }),
+         set.size());
+  DoNotOptimize(sum);
+
+  Set ascending;
+  std::snprintf(label, sizeof(label), "%s insert ascending", name);
+  Report(label, Measure([&] {
+           for (std::size_t key = 0; key < keys.size(); ++key) {
+             ascending.insert(static_cast<int>(key));
+           }
+         }),
+         keys.size());
+}
+
+inline void BtreeBenchmark() {
+  const std::size_t count = 1000000;
+  const std::vector<int> keys = RandomKeys(count);
+  const std::vector<int> probes = RandomKeys(count * 2, 7);
+
+  Title("red-black s21::set vs B+-tree s21::btree_set, 1M int keys");
+  RunSetWorkload<s21::set<int>>("s21::set", keys, probes);
+  RunSetWorkload<s21::btree_set<int>>("s21::btree_set", keys, probes);
+}
+
+}  // namespace s21_bench
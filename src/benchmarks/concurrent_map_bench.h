@@ -0,0 +1,77 @@
+#include <mutex>
+#include <thread>
+
+#include "../headers/s21_concurrent_map.h"
+#include "../headers/s21_map.h"
+#include "benchmark.h"
+
+namespace s21_bench {
+// Splits keys between threads writers and returns the wall time of all of
+// them inserting their part.
+template <typename Insert>
+double RunWriters(std::size_t threads, const std::vector<int> &keys,
+                  Insert insert) {
+  return Measure([&] {
+    std::vector<std::thread> writers;
+    for (std::size_t writer = 0; writer < threads; ++writer) {
+      writers.emplace_back([&, writer] {
+        for (std::size_t i = writer; i < keys.size(); i += threads) {
+          insert(keys[i]);
+        }
+      });
+    }
+    for (std::thread &writer : writers) {
+      writer.join();
+    }
+  });
+}
+
+inline void ConcurrentMapBenchmark() {
+  const std::vector<int> keys = RandomKeys(1000000);
+
+  Title("write scaling, 1M random int inserts split between writers");
+  std::size_t cores = std::thread::hardware_concurrency();
+  for (std::size_t threads = 1;; threads *= 2) {
+    threads = std::min(threads, cores > 0 ? cores : 1);
+    char label[64];
+    s21::map<int, int> locked_map;
+    std::mutex mutex;
+    std::snprintf(label, sizeof(label), "mutex + s21::map, %zu writers",
+                  threads);
+    Report(label, RunWriters(threads, keys,
+                             [&](int key) {
+                               std::lock_guard<std::mutex> lock(mutex);
+                               locked_map.insert(key, key);
+                             }),
+           keys.size());
+    s21::concurrent_map<int, int, 64> sharded_map;
+    std::snprintf(label, sizeof(label), "s21::concurrent_map, %zu writers",
+                  threads);
+    Report(label, RunWriters(threads, keys,
+                             [&](int key) { sharded_map.insert(key, key); }),
+           keys.size());
+    if (threads >= cores) {
+      break;
+    }
+  }
+
+  std::vector<std::pair<int, int>> items;
+  for (int key : keys) {
+    items.emplace_back(key, key);
+  }
+  s21::concurrent_map<int, int, 64> batched_map;
+  Report("s21::concurrent_map insert_many", Measure([&] {
+           batched_map.insert_many(items.begin(), items.end());
+         }),
+         items.size());
+  long long sum = 0;
+  Report("s21::concurrent_map ordered scan", Measure([&] {
+           for (const auto &item : batched_map.ordered()) {
+             sum += item.second;
+           }
+         }),
+         items.size());
+  DoNotOptimize(sum);
+}
+
+}  // namespace s21_bench
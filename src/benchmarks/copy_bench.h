@@ -0,0 +1,45 @@
+#include <map>
+#include <set>
+#include <string>
+
+#include "../headers/s21_map.h"
+#include "../headers/s21_set.h"
+#include "benchmark.h"
+
+namespace s21_bench {
+template <typename Set>
+void RunCopyWorkload(const char *name, const Set &source) {
+  char label[64];
+  std::snprintf(label, sizeof(label), "%s copy", name);
+  Set copy;
+  Report(label, Measure([&] { copy = source; }), source.size());
+  std::snprintf(label, sizeof(label), "%s clear", name);
+  Report(label, Measure([&] { copy.clear(); }), source.size());
+}
+
+inline void CopyBenchmark() {
+  const std::vector<int> keys = RandomKeys(4000000);
+
+  Title("copy and clear, 4M int keys");
+  s21::set<int> s21_set;
+  std::set<int> std_set;
+  for (int key : keys) {
+    s21_set.insert(key);
+    std_set.insert(key);
+  }
+  RunCopyWorkload("s21::set<int>", s21_set);
+  RunCopyWorkload("std::set<int>", std_set);
+
+  Title("copy and clear, 4M int -> 32-char string entries");
+  const std::string value(32, 'v');
+  s21::map<int, std::string> s21_map;
+  std::map<int, std::string> std_map;
+  for (int key : keys) {
+    s21_map.insert(key, value);
+    std_map.emplace(key, value);
+  }
+  RunCopyWorkload("s21::map<int, string>", s21_map);
+  RunCopyWorkload("std::map<int, string>", std_map);
+}
+
+}  // namespace s21_bench
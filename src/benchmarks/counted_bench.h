@@ -0,0 +1,51 @@
+#include "../headers/s21_multiset.h"
+#include "benchmark.h"
+
+namespace s21_bench {
+inline void CountedBenchmark() {
+  const std::size_t count = 4000000;
+  const int categories = 4096;
+  std::vector<int> events = RandomKeys(count);
+  for (int &event : events) {
+    event %= categories;
+  }
+  using counted_multiset =
+      s21::multiset<int, std::less<int>, s21::counted_traits>;
+
+  Title("4M events over 4096 keys: multiset vs counted_traits");
+  s21::multiset<int> plain;
+  Report("s21::multiset insert", Measure([&] {
+           for (int event : events) {
+             plain.insert(event);
+           }
+         }),
+         count);
+  counted_multiset counted;
+  Report("counted_traits insert", Measure([&] {
+           for (int event : events) {
+             counted.insert(event);
+           }
+         }),
+         count);
+  std::size_t total = 0;
+  Report("s21::multiset count() of every key", Measure([&] {
+           for (int key = 0; key < categories; ++key) {
+             total += plain.count(key);
+           }
+         }),
+         categories);
+  Report("counted_traits count() of every key", Measure([&] {
+           for (int key = 0; key < categories; ++key) {
+             total += counted.count(key);
+           }
+         }),
+         categories);
+  std::printf("  nodes: %zu vs %zu, %zu vs %zu bytes\n", plain.size(),
+              counted.distinct_size(),
+              plain.size() * s21::multiset<int>::tree_type::NodeSize(),
+              counted.distinct_size() *
+                  counted_multiset::tree_type::NodeSize());
+  DoNotOptimize(total);
+}
+
+}  // namespace s21_bench
@@ -0,0 +1,45 @@
+#include <string>
+
+#include "../headers/s21_map.h"
+#include "benchmark.h"
+
+namespace s21_bench {
+inline void EmplaceBenchmark() {
+  const std::vector<int> keys = RandomKeys(20000);
+  std::vector<int> upserts = RandomKeys(40000, 5);
+  upserts.resize(400000, 0);
+  for (std::size_t i = 40000; i < upserts.size(); ++i) {
+    upserts[i] = upserts[i % 40000];
+  }
+
+  Title("400K upserts of 40K keys into a 20K int -> string map");
+  s21::map<int, std::string> inserted;
+  s21::map<int, std::string> emplaced;
+  s21::map<int, std::string> indexed;
+  for (int key : keys) {
+    inserted.insert(key, std::string(48, 'x'));
+    emplaced.insert(key, std::string(48, 'x'));
+    indexed.insert(key, std::string(48, 'x'));
+  }
+  Report("insert(key, std::string(48, 'y'))", Measure([&] {
+           for (int key : upserts) {
+             inserted.insert(key, std::string(48, 'y'));
+           }
+         }),
+         upserts.size());
+  Report("try_emplace(key, 48, 'y')", Measure([&] {
+           for (int key : upserts) {
+             emplaced.try_emplace(key, 48, 'y');
+           }
+         }),
+         upserts.size());
+  Report("operator[](key)", Measure([&] {
+           for (int key : upserts) {
+             indexed[key];
+           }
+         }),
+         upserts.size());
+  DoNotOptimize(inserted.size() + emplaced.size() + indexed.size());
+}
+
+}  // namespace s21_bench
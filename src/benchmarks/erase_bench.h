@@ -0,0 +1,55 @@
+#include <set>
+
+#include "../headers/s21_set.h"
+#include "benchmark.h"
+
+namespace s21_bench {
+inline void EraseBenchmark() {
+  const std::vector<int> keys = RandomKeys(1000000);
+  const int expired = 250000;
+
+  Title("expire the 250K smallest of 1M int keys");
+  s21::set<int> one_by_one(keys.begin(), keys.end());
+  Report("s21::set erase(iterator) per element", Measure([&] {
+           for (auto it = one_by_one.begin(); *it < expired;) {
+             auto next = it;
+             ++next;
+             one_by_one.erase(it);
+             it = next;
+           }
+         }),
+         expired);
+  s21::set<int> ranged(keys.begin(), keys.end());
+  Report("s21::set erase(first, last)", Measure([&] {
+           ranged.erase(ranged.begin(), ranged.find(expired));
+         }),
+         expired);
+  std::set<int> std_ranged(keys.begin(), keys.end());
+  Report("std::set erase(first, last)", Measure([&] {
+           std_ranged.erase(std_ranged.begin(), std_ranged.find(expired));
+         }),
+         expired);
+
+  Title("drop the odd keys of 1M ints");
+  s21::set<int> filtered(keys.begin(), keys.end());
+  Report("s21::set erase(iterator) per match", Measure([&] {
+           for (auto it = filtered.begin(); it != filtered.end();) {
+             auto next = it;
+             ++next;
+             if (*it % 2 != 0) {
+               filtered.erase(it);
+             }
+             it = next;
+           }
+         }),
+         keys.size());
+  s21::set<int> predicated(keys.begin(), keys.end());
+  Report("s21::set erase_if()", Measure([&] {
+           predicated.erase_if([](int key) { return key % 2 != 0; });
+         }),
+         keys.size());
+  DoNotOptimize(one_by_one.size() + ranged.size() + std_ranged.size() +
+                filtered.size() + predicated.size());
+}
+
+}  // namespace s21_bench
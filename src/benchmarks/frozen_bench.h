@@ -0,0 +1,53 @@
+#include <algorithm>
+#include <cstdio>
+
+#include "../headers/s21_set.h"
+#include "benchmark.h"
+
+namespace s21_bench {
+template <typename Lookup>
+void RunLookups(const char *name, const std::vector<int> &probes,
+                Lookup lookup) {
+  std::size_t found = 0;
+  Report(name, Measure([&] {
+           for (int probe : probes) {
+             found += lookup(probe) ? 1 : 0;
+           }
+         }),
+         probes.size());
+  DoNotOptimize(found);
+}
+
+inline void FrozenBenchmark() {
+  const std::size_t probe_count = 4000000;
+  for (std::size_t count : {std::size_t{1000}, std::size_t{4000000}}) {
+    const std::vector<int> keys = RandomKeys(count);
+    std::vector<int> probes = RandomKeys(count * 2, 5);
+    probes.resize(std::min(probes.size(), probe_count));
+    while (probes.size() < probe_count) {
+      probes.push_back(probes[probes.size() % (count * 2)]);
+    }
+
+    char title[96];
+    std::snprintf(title, sizeof(title),
+                  "4M random lookups in %zu ints, half of them hits", count);
+    Title(title);
+    s21::set<int> live(keys.begin(), keys.end());
+    s21::frozen_set<int> frozen = live.freeze();
+    std::vector<int> sorted(live.begin(), live.end());
+    RunLookups("s21::set contains()", probes,
+               [&](int key) { return live.contains(key); });
+    RunLookups("s21::frozen_set contains()", probes,
+               [&](int key) { return frozen.contains(key); });
+    RunLookups("std::binary_search on a sorted vector", probes, [&](int key) {
+      return std::binary_search(sorted.begin(), sorted.end(), key);
+    });
+    RunLookups("s21::frozen_set lower_bound()", probes, [&](int key) {
+      return frozen.lower_bound(key) != frozen.end();
+    });
+    Report("s21::set freeze()", Measure([&] { frozen = live.freeze(); }),
+           count);
+  }
+}
+
+}  // namespace s21_bench
@@ -0,0 +1,37 @@
+#include <set>
+
+#include "../headers/s21_set.h"
+#include "benchmark.h"
+
+namespace s21_bench {
+inline void HintBenchmark() {
+  const std::vector<int> keys = SortedKeys(1000000);
+
+  Title("in-order ingestion of 1M int keys, plain vs end() hint");
+  s21::set<int> plain;
+  Report("s21::set insert(value)", Measure([&] {
+           for (int key : keys) {
+             plain.insert(key);
+           }
+         }),
+         keys.size());
+
+  s21::set<int> hinted;
+  Report("s21::set insert(end(), value)", Measure([&] {
+           for (int key : keys) {
+             hinted.insert(hinted.end(), key);
+           }
+         }),
+         keys.size());
+
+  std::set<int> std_hinted;
+  Report("std::set insert(end(), value)", Measure([&] {
+           for (int key : keys) {
+             std_hinted.insert(std_hinted.end(), key);
+           }
+         }),
+         keys.size());
+  DoNotOptimize(plain.size() + hinted.size() + std_hinted.size());
+}
+
+}  // namespace s21_bench
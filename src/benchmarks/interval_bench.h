@@ -0,0 +1,57 @@
+#include "../headers/s21_interval_map.h"
+#include "../headers/s21_multiset.h"
+#include "benchmark.h"
+
+namespace s21_bench {
+inline void IntervalBenchmark() {
+  const std::size_t count = 50000;
+  const std::size_t queries = 2000;
+  const int spacing = 500;
+  std::vector<int> starts = RandomKeys(count);
+  std::vector<int> points = RandomKeys(queries, 7);
+  s21::multiset<std::pair<int, int>> ranges;
+  s21::interval_map<int, int> intervals;
+  for (std::size_t index = 0; index < count; ++index) {
+    int low = starts[index] * spacing;
+    int high = low + starts[index] * 7919 % 5000;
+    ranges.insert({low, high});
+    intervals.insert({low, high}, static_cast<int>(index));
+  }
+  for (int &point : points) {
+    point = point * (spacing * static_cast<int>(count / queries)) + 17;
+  }
+
+  Title("2K stabbing queries over 50K intervals");
+  std::size_t matches = 0;
+  Report("s21::multiset scan up to lower_bound", Measure([&] {
+           for (int point : points) {
+             auto last = ranges.lower_bound({point + 1, 0});
+             for (auto it = ranges.begin(); it != last; ++it) {
+               matches += (*it).second >= point ? 1 : 0;
+             }
+           }
+         }),
+         queries);
+  std::vector<s21::interval_map<int, int>::iterator> found;
+  Report("s21::interval_map stab", Measure([&] {
+           for (int point : points) {
+             found.clear();
+             intervals.stab(point, std::back_inserter(found));
+             matches += found.size();
+           }
+         }),
+         queries);
+  std::vector<std::pair<int, int>> windows;
+  for (int point : points) {
+    windows.emplace_back(point, point + 1000);
+  }
+  Report("overlap_batch of 1K-wide windows", Measure([&] {
+           intervals.overlap_batch(
+               windows.begin(), windows.end(),
+               [&](const std::pair<int, int> &, auto) { ++matches; });
+         }),
+         queries);
+  DoNotOptimize(matches);
+}
+
+}  // namespace s21_bench
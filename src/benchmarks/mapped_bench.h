@@ -0,0 +1,49 @@
+#include <cstdio>
+#include <string>
+
+#include "../headers/s21_map.h"
+#include "benchmark.h"
+
+namespace s21_bench {
+inline void MappedBenchmark() {
+  const std::size_t count = 1000000;
+  std::vector<int> keys = RandomKeys(count);
+  std::string path = "mapped_bench.img";
+
+  Title("Reloading a 1M map: inserts against save() and open_mapped()");
+  s21::map<int, long> original;
+  for (int key : keys) {
+    original.insert(key, key * 2L);
+  }
+  Report("s21::map rebuild by inserts", Measure([&] {
+           s21::map<int, long> rebuilt;
+           for (int key : keys) {
+             rebuilt.insert(key, key * 2L);
+           }
+           DoNotOptimize(rebuilt);
+         }),
+         count);
+  Report("save()", Measure([&] { original.save(path); }), count);
+  s21::frozen_map<int, long> mapped;
+  Report("open_mapped()", Measure([&] {
+           mapped = s21::map<int, long>::open_mapped(path);
+         }),
+         1);
+  long sum = 0;
+  Report("open_mapped() first 1M finds", Measure([&] {
+           for (int key : keys) {
+             sum += mapped.find(key)->second;
+           }
+         }),
+         count);
+  Report("open_mapped() warm 1M finds", Measure([&] {
+           for (int key : keys) {
+             sum += mapped.find(key)->second;
+           }
+         }),
+         count);
+  DoNotOptimize(sum);
+  std::remove(path.c_str());
+}
+
+}  // namespace s21_bench
@@ -0,0 +1,68 @@
+#include <string>
+
+#include "../headers/s21_map.h"
+#include "../headers/s21_set.h"
+#include "benchmark.h"
+
+namespace s21_bench {
+template <typename Plain, typename Compact>
+void ReportNodeSize(const char *name, std::size_t count) {
+  std::size_t plain = Plain::tree_type::NodeSize();
+  std::size_t compact = Compact::tree_type::NodeSize();
+  std::printf("  %-28s %4zu B %4zu B %8.1f MB -> %6.1f MB\n", name, plain,
+              compact, plain * count / 1e6, compact * count / 1e6);
+}
+
+template <typename Set>
+void RunCompactWorkload(const char *name, const std::vector<int> &keys) {
+  char label[64];
+  Set set;
+  std::snprintf(label, sizeof(label), "%s insert random", name);
+  Report(label, Measure([&] {
+           for (int key : keys) {
+             set.insert(key);
+           }
+         }),
+         keys.size());
+  std::size_t found = 0;
+  std::snprintf(label, sizeof(label), "%s find random", name);
+  Report(label, Measure([&] {
+           for (int key : keys) {
+             found += set.contains(key) ? 1 : 0;
+           }
+         }),
+         keys.size());
+  DoNotOptimize(found);
+}
+
+inline void MemoryBenchmark() {
+  const std::size_t count = 1000000;
+  using s21::compact_traits;
+
+  Title("node size, tree_traits vs compact_traits (total for 1M elements)");
+  ReportNodeSize<s21::set<int>, s21::set<int, std::less<int>, compact_traits>>(
+      "set<int>", count);
+  ReportNodeSize<s21::set<long>,
+                 s21::set<long, std::less<long>, compact_traits>>("set<long>",
+                                                                  count);
+  ReportNodeSize<s21::set<double>,
+                 s21::set<double, std::less<double>, compact_traits>>(
+      "set<double>", count);
+  ReportNodeSize<s21::map<int, int>,
+                 s21::map<int, int, std::less<int>, compact_traits>>(
+      "map<int, int>", count);
+  ReportNodeSize<s21::map<long, long>,
+                 s21::map<long, long, std::less<long>, compact_traits>>(
+      "map<long, long>", count);
+  ReportNodeSize<s21::set<std::string>,
+                 s21::set<std::string, std::less<std::string>,
+                          compact_traits>>("set<string>", count);
+
+  const std::vector<int> keys = RandomKeys(count);
+  Title("cost of the packed color bit, 1M long keys");
+  RunCompactWorkload<s21::set<long>>("s21::set<long>", keys);
+  RunCompactWorkload<s21::set<long, std::less<long>, compact_traits>>(
+      "compact s21::set<long>", keys);
+}
+
+}  // namespace s21_bench
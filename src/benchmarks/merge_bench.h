@@ -0,0 +1,29 @@
+#include <set>
+
+#include "../headers/s21_set.h"
+#include "benchmark.h"
+
+namespace s21_bench {
+inline void MergeBenchmark() {
+  const std::size_t count = 1000000;
+  const std::vector<int> keys = RandomKeys(count * 2);
+
+  Title("merge m random keys into a 1M-key set");
+  for (std::size_t other_count : {1000, 100000, 1000000}) {
+    std::set<int> std_target(keys.begin(), keys.begin() + count);
+    std::set<int> std_source(keys.begin() + count,
+                             keys.begin() + count + other_count);
+    s21::set<int> s21_target(keys.begin(), keys.begin() + count);
+    s21::set<int> s21_source(keys.begin() + count,
+                             keys.begin() + count + other_count);
+    char name[64];
+    std::snprintf(name, sizeof(name), "std::set::merge  m = %zu", other_count);
+    Report(name, Measure([&] { std_target.merge(std_source); }),
+           other_count);
+    std::snprintf(name, sizeof(name), "s21::set::merge  m = %zu", other_count);
+    Report(name, Measure([&] { s21_target.merge(s21_source); }),
+           other_count);
+  }
+}
+
+}  // namespace s21_bench
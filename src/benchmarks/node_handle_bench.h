@@ -0,0 +1,33 @@
+#include <string>
+
+#include "../headers/s21_map.h"
+#include "benchmark.h"
+
+namespace s21_bench {
+inline void NodeHandleBenchmark() {
+  const std::vector<int> keys = RandomKeys(1000000);
+
+  Title("drain 1M int -> string entries into another map");
+  s21::map<int, std::string> source;
+  for (int key : keys) {
+    source.insert(key, "payload of key " + std::to_string(key));
+  }
+  s21::map<int, std::string> copied;
+  Report("insert(*begin()), erase(begin())", Measure([&] {
+           while (!source.empty()) {
+             copied.insert(copied.end(), *source.begin());
+             source.erase(source.begin());
+           }
+         }),
+         keys.size());
+  s21::map<int, std::string> moved;
+  Report("insert(extract(begin()))", Measure([&] {
+           while (!copied.empty()) {
+             moved.insert(copied.extract(copied.begin()));
+           }
+         }),
+         keys.size());
+  DoNotOptimize(moved.size());
+}
+
+}  // namespace s21_bench
@@ -0,0 +1,60 @@
+#include <set>
+
+#include "../headers/s21_node_pool.h"
+#include "../headers/s21_set.h"
+#include "benchmark.h"
+
+namespace s21_bench {
+// Same footprint as a tree node holding an int: three links, key and color.
+struct PoolBenchNode {
+  PoolBenchNode *links[3];
+  int key;
+  int color;
+};
+
+inline void NodePoolBenchmark() {
+  const std::size_t count = 1000000;
+  const std::vector<int> keys = RandomKeys(count);
+  std::vector<PoolBenchNode *> nodes(count);
+
+  Title("node_pool vs plain new (1M nodes, allocate / free half / refill)");
+  double plain = Measure([&] {
+    for (std::size_t i = 0; i < count; ++i) nodes[i] = new PoolBenchNode{};
+    for (std::size_t i = 0; i < count; i += 2) delete nodes[keys[i]];
+    for (std::size_t i = 0; i < count; i += 2) {
+      nodes[keys[i]] = new PoolBenchNode{};
+    }
+    for (PoolBenchNode *node : nodes) delete node;
+  });
+  Report("new / delete", plain, count * 3);
+  double pooled = Measure([&] {
+    s21::node_pool<PoolBenchNode> pool;
+    for (std::size_t i = 0; i < count; ++i) nodes[i] = pool.Allocate();
+    for (std::size_t i = 0; i < count; i += 2) pool.Deallocate(nodes[keys[i]]);
+    for (std::size_t i = 0; i < count; i += 2) {
+      nodes[keys[i]] = pool.Allocate();
+    }
+    pool.Release();
+  });
+  Report("node_pool Allocate / Deallocate / Release", pooled, count * 3);
+
+  Title("set churn: insert 1M, erase half, reinsert, clear");
+  double std_set = Measure([&] {
+    std::set<int> set;
+    for (int key : keys) set.insert(key);
+    for (std::size_t i = 0; i < count; i += 2) set.erase(keys[i]);
+    for (std::size_t i = 0; i < count; i += 2) set.insert(keys[i]);
+    set.clear();
+  });
+  Report("std::set (new per node)", std_set, count * 3);
+  double s21_set = Measure([&] {
+    s21::set<int> set;
+    for (int key : keys) set.insert(key);
+    for (std::size_t i = 0; i < count; i += 2) set.erase(set.find(keys[i]));
+    for (std::size_t i = 0; i < count; i += 2) set.insert(keys[i]);
+    set.clear();
+  });
+  Report("s21::set (node_pool)", s21_set, count * 3);
+}
+
+}  // namespace s21_bench
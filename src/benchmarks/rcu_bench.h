@@ -0,0 +1,88 @@
+#include <atomic>
+#include <mutex>
+#include <thread>
+
+#include "../headers/s21_map.h"
+#include "../headers/s21_rcu_map.h"
+#include "benchmark.h"
+
+namespace s21_bench {
+// Runs threads readers doing lookups while one writer keeps updating
+// entries; returns the wall time of the readers.
+template <typename Lookup, typename Write>
+double RunReaders(std::size_t threads, const std::vector<int> &probes,
+                  Lookup lookup, Write write) {
+  std::atomic<bool> reading{true};
+  std::thread writer([&] {
+    for (int key = 0; reading.load(std::memory_order_relaxed); ++key) {
+      write(key % static_cast<int>(probes.size()));
+      std::this_thread::yield();
+    }
+  });
+  double milliseconds = Measure([&] {
+    std::vector<std::thread> readers;
+    for (std::size_t reader = 0; reader < threads; ++reader) {
+      readers.emplace_back([&, reader] {
+        std::size_t found = 0;
+        for (std::size_t i = reader; i < probes.size() + reader; ++i) {
+          found += lookup(probes[i % probes.size()]) ? 1 : 0;
+        }
+        DoNotOptimize(found);
+      });
+    }
+    for (std::thread &reader : readers) {
+      reader.join();
+    }
+  });
+  reading = false;
+  writer.join();
+  return milliseconds;
+}
+
+inline void RcuBenchmark() {
+  const std::size_t count = 1000000;
+  const std::vector<int> keys = RandomKeys(count);
+  const std::vector<int> probes = RandomKeys(count, 3);
+
+  s21::map<int, int> locked_map;
+  std::mutex mutex;
+  s21::rcu_map<int, int> rcu_map;
+  rcu_map.update([&](auto &version) {
+    for (int key : keys) {
+      version.insert(key, key);
+      locked_map.insert(key, key);
+    }
+  });
+
+  Title("read scaling, 1M lookups per reader and one writer, 1M int keys");
+  std::size_t cores = std::thread::hardware_concurrency();
+  for (std::size_t threads = 1;; threads *= 2) {
+    threads = std::min(threads, cores > 0 ? cores : 1);
+    char label[64];
+    std::snprintf(label, sizeof(label), "mutex + s21::map, %zu readers",
+                  threads);
+    Report(label,
+           RunReaders(
+               threads, probes,
+               [&](int key) {
+                 std::lock_guard<std::mutex> lock(mutex);
+                 return locked_map.contains(key);
+               },
+               [&](int key) {
+                 std::lock_guard<std::mutex> lock(mutex);
+                 locked_map.insert_or_assign(key, -key);
+               }),
+           probes.size() * threads);
+    std::snprintf(label, sizeof(label), "s21::rcu_map, %zu readers", threads);
+    Report(label,
+           RunReaders(
+               threads, probes, [&](int key) { return rcu_map.contains(key); },
+               [&](int key) { rcu_map.insert_or_assign(key, -key); }),
+           probes.size() * threads);
+    if (threads >= cores) {
+      break;
+    }
+  }
+}
+
+}  // namespace s21_bench
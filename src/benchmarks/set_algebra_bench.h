@@ -0,0 +1,43 @@
+#include "../headers/s21_set.h"
+#include "benchmark.h"
+
+namespace s21_bench {
+inline void SetAlgebraBenchmark() {
+  const std::size_t count = 10000000;
+  s21::set<int> first;
+  s21::set<int> second;
+  {
+    std::vector<int> keys(count);
+    for (std::size_t i = 0; i < count; ++i) keys[i] = static_cast<int>(i * 2);
+    first.assign_sorted(keys.begin(), keys.end());
+    for (std::size_t i = 0; i < count; ++i) keys[i] = static_cast<int>(i * 3);
+    second.assign_sorted(keys.begin(), keys.end());
+  }
+
+  Title("set algebra on two 10M-key sets by thread count");
+  for (std::size_t threads = 1; threads <= s21::thread_pool::DefaultSize();
+       threads *= 2) {
+    s21::thread_pool pool(threads);
+    char name[64];
+    std::snprintf(name, sizeof(name), "set_union         threads = %zu",
+                  threads);
+    Report(name, Measure([&] {
+             DoNotOptimize(s21::set_union(first, second, pool).size());
+           }),
+           count * 2);
+    std::snprintf(name, sizeof(name), "set_intersection  threads = %zu",
+                  threads);
+    Report(name, Measure([&] {
+             DoNotOptimize(s21::set_intersection(first, second, pool).size());
+           }),
+           count * 2);
+    std::snprintf(name, sizeof(name), "set_difference    threads = %zu",
+                  threads);
+    Report(name, Measure([&] {
+             DoNotOptimize(s21::set_difference(first, second, pool).size());
+           }),
+           count * 2);
+  }
+}
+
+}  // namespace s21_bench
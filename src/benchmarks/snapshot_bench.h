@@ -0,0 +1,47 @@
+#include "../headers/s21_map.h"
+#include "../headers/s21_persistent_map.h"
+#include "benchmark.h"
+
+namespace s21_bench {
+inline void SnapshotBenchmark() {
+  const std::size_t count = 1000000;
+  const std::vector<int> keys = RandomKeys(count);
+  const std::vector<int> updates = RandomKeys(count, 5);
+
+  Title("consistent view of a 1M int map: deep copy vs snapshot");
+  s21::map<int, int> map;
+  s21::persistent_map<int, int> persistent;
+  for (int key : keys) {
+    map.insert(key, key);
+    persistent.insert(key, key);
+  }
+  s21::map<int, int> copy;
+  Report("s21::map copy", Measure([&] { copy = map; }), count);
+  s21::persistent_map<int, int> snapshot;
+  Report("s21::persistent_map snapshot()",
+         Measure([&] { snapshot = persistent.snapshot(); }), count);
+
+  Title("1M updates of existing keys: unshared vs with a live snapshot");
+  Report("s21::map operator[]", Measure([&] {
+           for (int key : updates) {
+             ++map[key];
+           }
+         }),
+         updates.size());
+  Report("s21::persistent_map operator[], snapshot live", Measure([&] {
+           for (int key : updates) {
+             ++persistent[key];
+           }
+         }),
+         updates.size());
+  snapshot.clear();
+  Report("s21::persistent_map operator[], unshared", Measure([&] {
+           for (int key : updates) {
+             ++persistent[key];
+           }
+         }),
+         updates.size());
+  DoNotOptimize(copy.size());
+}
+
+}  // namespace s21_bench
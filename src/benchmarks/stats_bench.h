@@ -0,0 +1,48 @@
+#include "../headers/s21_set.h"
+#include "benchmark.h"
+
+namespace s21_bench {
+inline void StatsBenchmark() {
+  const std::size_t count = 1000000;
+  std::vector<int> keys = RandomKeys(count);
+  using stats_set = s21::set<int, std::less<int>, s21::statistics_traits>;
+
+  Title("1M random inserts and lookups with and without statistics_traits");
+  s21::set<int> plain;
+  Report("s21::set insert", Measure([&] {
+           for (int key : keys) {
+             plain.insert(key);
+           }
+         }),
+         count);
+  stats_set counted;
+  Report("statistics_traits insert", Measure([&] {
+           for (int key : keys) {
+             counted.insert(key);
+           }
+         }),
+         count);
+  std::size_t found = 0;
+  Report("s21::set find", Measure([&] {
+           for (int key : keys) {
+             found += plain.find(key) != plain.end() ? 1 : 0;
+           }
+         }),
+         count);
+  Report("statistics_traits find", Measure([&] {
+           for (int key : keys) {
+             found += counted.find(key) != counted.end() ? 1 : 0;
+           }
+         }),
+         count);
+  s21::tree_stats stats;
+  Report("stats()", Measure([&] { stats = counted.stats(); }), 1);
+  std::printf(
+      "  %zu comparisons, %zu rotations, %zu recolorings, %zu allocations, "
+      "depth %zu\n",
+      stats.comparisons, stats.rotations, stats.recolorings,
+      stats.allocations, stats.depth_histogram.size());
+  DoNotOptimize(found);
+}
+
+}  // namespace s21_bench
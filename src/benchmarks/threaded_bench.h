@@ -0,0 +1,50 @@
+#include "../headers/s21_set.h"
+#include "benchmark.h"
+
+namespace s21_bench {
+inline void ThreadedBenchmark() {
+  const std::size_t count = 1000000;
+  const int scans = 10;
+  std::vector<int> keys = RandomKeys(count);
+  using threaded_set = s21::set<int, std::less<int>, s21::threaded_traits>;
+
+  Title("10 forward and reverse scans of 1M random keys, threaded or not");
+  s21::set<int> plain(keys.begin(), keys.end());
+  threaded_set threaded(keys.begin(), keys.end());
+  long long sum = 0;
+  Report("s21::set forward scan", Measure([&] {
+           for (int i = 0; i < scans; ++i) {
+             for (int key : plain) {
+               sum += key;
+             }
+           }
+         }),
+         count * scans);
+  Report("threaded_traits forward scan", Measure([&] {
+           for (int i = 0; i < scans; ++i) {
+             for (int key : threaded) {
+               sum += key;
+             }
+           }
+         }),
+         count * scans);
+  Report("s21::set reverse scan", Measure([&] {
+           for (int i = 0; i < scans; ++i) {
+             for (auto it = plain.rbegin(); it != plain.rend(); ++it) {
+               sum += *it;
+             }
+           }
+         }),
+         count * scans);
+  Report("threaded_traits reverse scan", Measure([&] {
+           for (int i = 0; i < scans; ++i) {
+             for (auto it = threaded.rbegin(); it != threaded.rend(); ++it) {
+               sum += *it;
+             }
+           }
+         }),
+         count * scans);
+  DoNotOptimize(sum);
+}
+
+}  // namespace s21_bench
@@ -0,0 +1,1208 @@
+#ifndef CONTAINERS_S21_ART_H_
+#define CONTAINERS_S21_ART_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <new>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace s21 {
+// Byte encoding of the keys of s21::art: Size(key) bytes, read one at a time
+// with Byte(key, index). Keys must sort like their encodings compared as
+// unsigned byte strings and be equal exactly when the encodings are.
+// Specialize it to use other key types.
+template <typename Key, typename = void>
+struct art_key;
+
+// Integers are encoded big-endian with the sign bit flipped, which puts
+// negative numbers first.
+template <typename Key>
+struct art_key<Key, std::enable_if_t<std::is_integral_v<Key> &&
+                                     !std::is_same_v<Key, bool>>> {
+  static constexpr std::size_t Size(Key) noexcept { return sizeof(Key); }
+
+  static constexpr unsigned char Byte(Key key, std::size_t index) noexcept {
+    using unsigned_type = std::make_unsigned_t<Key>;
+    unsigned_type bits = static_cast<unsigned_type>(key);
+    if constexpr (std::is_signed_v<Key>) {
+      bits ^= static_cast<unsigned_type>(unsigned_type(1)
+                                         << (8 * sizeof(Key) - 1));
+    }
+    return static_cast<unsigned char>(bits >> (8 * (sizeof(Key) - 1 - index)));
+  }
+};
+
+// Strings are encoded as their characters, so a string sorts before the
+// strings it is a prefix of.
+template <>
+struct art_key<std::string> {
+  static std::size_t Size(const std::string &key) noexcept {
+    return key.size();
+  }
+
+  static unsigned char Byte(const std::string &key,
+                            std::size_t index) noexcept {
+    return static_cast<unsigned char>(key[index]);
+  }
+};
+
+// Key extractors of s21::art: sets store bare keys, maps store pairs.
+struct art_identity {
+  template <typename T>
+  const T &operator()(const T &value) const noexcept {
+    return value;
+  }
+};
+
+struct art_select_first {
+  template <typename Pair>
+  const typename Pair::first_type &operator()(
+      const Pair &value) const noexcept {
+    return value.first;
+  }
+};
+
+// Adaptive radix tree engine of art_set and art_map. Inner nodes branch on
+// one byte of the art_key encoding of the keys, so a lookup costs O(key
+// length) byte steps and touches a few small nodes instead of comparing
+// whole keys at O(log n) nodes. Inner nodes hold up to 4, 16, 48 or 256
+// children and change size as children come and go; Node16 is searched
+// with SSE2 where available. The bytes shared by all keys below a node are
+// kept in the node (path compression), and a key is kept in a leaf at the
+// first byte no other key shares (lazy expansion). A key that ends at an
+// inner node, as a string ends where longer strings go on, is its terminal
+// leaf.
+//
+// Leaves are also linked in key order, so iteration never visits inner
+// nodes. Insertion and erasure leave iterators to other elements valid.
+template <typename Key, typename Value = Key,
+          typename KeyOfValue = art_identity,
+          typename Codec = art_key<Key>>
+class art {
+ private:
+  struct Links;
+  struct Leaf;
+  struct Iterator;
+  struct IteratorConst;
+
+ public:
+  using key_type = Key;
+  using value_type = Value;
+  using reference = value_type &;
+  using const_reference = const value_type &;
+  using iterator = Iterator;
+  using const_iterator = IteratorConst;
+  using size_type = std::size_t;
+
+  // Prefix bytes stored in an inner node; longer prefixes are read from a
+  // leaf below it.
+  static constexpr size_type kMaxPrefix = 8;
+
+  art() = default;
+
+  art(const art &other) {
+    for (const_iterator it = other.Begin(); it != other.End(); ++it) {
+      TryEmplace(KeyOf(*it), *it);
+    }
+  }
+
+  art(art &&other) noexcept { Swap(other); }
+
+  art &operator=(const art &other) {
+    if (this != &other) {
+      art copy(other);
+      Swap(copy);
+    }
+    return *this;
+  }
+
+  art &operator=(art &&other) noexcept {
+    Clear();
+    Swap(other);
+    return *this;
+  }
+
+  ~art() { Clear(); }
+
+  void Clear() noexcept {
+    Destroy(root_);
+    root_ = nullptr;
+    head_.prev_ = head_.next_ = &head_;
+    size_ = 0;
+  }
+
+  size_type Size() const noexcept { return size_; }
+
+  bool Empty() const noexcept { return size_ == 0; }
+
+  size_type MaxSize() const noexcept {
+    return std::numeric_limits<size_type>::max() / sizeof(Leaf);
+  }
+
+  iterator Begin() noexcept { return iterator(head_.next_); }
+
+  const_iterator Begin() const noexcept { return const_iterator(head_.next_); }
+
+  iterator End() noexcept { return iterator(&head_); }
+
+  const_iterator End() const noexcept { return const_iterator(Head()); }
+
+  // Inserts value_type(key, args...) unless key is present; nothing is
+  // constructed then.
+  template <typename... Args>
+  std::pair<iterator, bool> TryEmplace(const key_type &key, Args &&...args) {
+    std::pair<Leaf *, bool> result =
+        InsertLeaf(key, std::forward<Args>(args)...);
+    return {iterator(result.first), result.second};
+  }
+
+  iterator Find(const key_type &key) noexcept {
+    Leaf *leaf = FindLeaf(key);
+    return leaf != nullptr ? iterator(leaf) : End();
+  }
+
+  const_iterator Find(const key_type &key) const noexcept {
+    Leaf *leaf = FindLeaf(key);
+    return leaf != nullptr ? const_iterator(leaf) : End();
+  }
+
+  size_type Count(const key_type &key) const noexcept {
+    return FindLeaf(key) != nullptr ? 1 : 0;
+  }
+
+  iterator LowerBound(const key_type &key) noexcept {
+    return iterator(LowerBoundLinks(key));
+  }
+
+  const_iterator LowerBound(const key_type &key) const noexcept {
+    return const_iterator(LowerBoundLinks(key));
+  }
+
+  iterator UpperBound(const key_type &key) noexcept {
+    return iterator(UpperBoundLinks(key));
+  }
+
+  const_iterator UpperBound(const key_type &key) const noexcept {
+    return const_iterator(UpperBoundLinks(key));
+  }
+
+  // The elements whose key encoding starts with that of prefix, found in
+  // O(prefix length) as one subtree.
+  std::pair<iterator, iterator> PrefixRange(const key_type &prefix) noexcept {
+    std::pair<Links *, Links *> range = PrefixRangeLinks(prefix);
+    return {iterator(range.first), iterator(range.second)};
+  }
+
+  std::pair<const_iterator, const_iterator> PrefixRange(
+      const key_type &prefix) const noexcept {
+    std::pair<Links *, Links *> range = PrefixRangeLinks(prefix);
+    return {const_iterator(range.first), const_iterator(range.second)};
+  }
+
+  // Erases the element at pos and returns an iterator to the element that
+  // followed it.
+  iterator Erase(const_iterator pos) noexcept {
+    Links *next = pos.node_->next_;
+    EraseKey(KeyOf(static_cast<const Leaf *>(pos.node_)->value_));
+    return iterator(next);
+  }
+
+  // Erases the element with the given key; returns how many there were.
+  size_type Erase(const key_type &key) noexcept { return EraseKey(key); }
+
+  void Swap(art &other) noexcept {
+    std::swap(root_, other.root_);
+    std::swap(size_, other.size_);
+    std::swap(head_, other.head_);
+    RelinkHead();
+    other.RelinkHead();
+  }
+
+ private:
+  enum NodeType : std::uint8_t { kLeaf, kNode4, kNode16, kNode48, kNode256 };
+
+  struct Node {
+    explicit Node(NodeType type) noexcept : type_(type) {}
+
+    NodeType type_;
+  };
+
+  struct Links {
+    Links *prev_;
+    Links *next_;
+  };
+
+  struct Leaf : Node, Links {
+    template <typename... Args>
+    explicit Leaf(Args &&...args)
+        : Node(kLeaf),
+          Links{nullptr, nullptr},
+          value_(std::forward<Args>(args)...) {}
+
+    value_type value_;
+  };
+
+  struct Inner : Node {
+    explicit Inner(NodeType type) noexcept : Node(type) {}
+
+    std::uint16_t count_ = 0;
+    std::uint32_t prefix_length_ = 0;
+    unsigned char prefix_[kMaxPrefix] = {};
+    Leaf *terminal_ = nullptr;
+  };
+
+  // Node4 and Node16: keys sorted, children at the same index.
+  template <size_type N, NodeType Type>
+  struct SortedNode : Inner {
+    SortedNode() noexcept : Inner(Type) {}
+
+    unsigned char keys_[N] = {};
+    Node *children_[N] = {};
+  };
+
+  using Node4 = SortedNode<4, kNode4>;
+  using Node16 = SortedNode<16, kNode16>;
+
+  struct Node48 : Inner {
+    Node48() noexcept : Inner(kNode48) {}
+
+    // Slot of the child for each byte plus one, 0 if there is none.
+    unsigned char index_[256] = {};
+    Node *children_[48] = {};
+  };
+
+  struct Node256 : Inner {
+    Node256() noexcept : Inner(kNode256) {}
+
+    Node *children_[256] = {};
+  };
+
+  static const key_type &KeyOf(const value_type &value) noexcept {
+    return KeyOfValue()(value);
+  }
+
+  Links *Head() const noexcept { return const_cast<Links *>(&head_); }
+
+  // Sign of the difference of two keys whose first from bytes are equal.
+  static int CompareKeys(const key_type &left, const key_type &right,
+                         size_type from) noexcept {
+    size_type left_size = Codec::Size(left);
+    size_type right_size = Codec::Size(right);
+    for (size_type i = from; i < left_size && i < right_size; ++i) {
+      unsigned char left_byte = Codec::Byte(left, i);
+      unsigned char right_byte = Codec::Byte(right, i);
+      if (left_byte != right_byte) {
+        return left_byte < right_byte ? -1 : 1;
+      }
+    }
+    if (left_size == right_size) {
+      return 0;
+    }
+    return left_size < right_size ? -1 : 1;
+  }
+
+  static bool StartsWith(const key_type &key, const key_type &prefix,
+                         size_type from) noexcept {
+    size_type size = Codec::Size(prefix);
+    if (Codec::Size(key) < size) {
+      return false;
+    }
+    for (size_type i = from; i < size; ++i) {
+      if (Codec::Byte(key, i) != Codec::Byte(prefix, i)) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  // Byte index of the prefix of inner, whose keys all have their byte
+  // depth at the start of the prefix.
+  static unsigned char PrefixByte(Inner *inner, size_type index,
+                                  size_type depth) noexcept {
+    if (index < kMaxPrefix) {
+      return inner->prefix_[index];
+    }
+    return Codec::Byte(KeyOf(MinLeaf(inner)->value_), depth + index);
+  }
+
+  // Number of leading bytes of the prefix of inner that key matches from
+  // depth on; a key that ends stops the match.
+  static size_type MatchPrefix(Inner *inner, const key_type &key,
+                               size_type depth) noexcept {
+    size_type size = Codec::Size(key);
+    Leaf *leaf = nullptr;
+    for (size_type i = 0; i < inner->prefix_length_; ++i) {
+      if (depth + i >= size) {
+        return i;
+      }
+      unsigned char byte;
+      if (i < kMaxPrefix) {
+        byte = inner->prefix_[i];
+      } else {
+        if (leaf == nullptr) {
+          leaf = MinLeaf(inner);
+        }
+        byte = Codec::Byte(KeyOf(leaf->value_), depth + i);
+      }
+      if (byte != Codec::Byte(key, depth + i)) {
+        return i;
+      }
+    }
+    return inner->prefix_length_;
+  }
+
+  // Whether key matches the stored bytes of the prefix of inner and is
+  // long enough for the rest, which is checked at the leaf instead.
+  static bool SkipPrefix(Inner *inner, const key_type &key,
+                         size_type &depth) noexcept {
+    size_type length = inner->prefix_length_;
+    if (depth + length > Codec::Size(key)) {
+      return false;
+    }
+    for (size_type i = 0; i < length && i < kMaxPrefix; ++i) {
+      if (inner->prefix_[i] != Codec::Byte(key, depth + i)) {
+        return false;
+      }
+    }
+    depth += length;
+    return true;
+  }
+
+  Leaf *FindLeaf(const key_type &key) const noexcept {
+    Node *node = root_;
+    size_type depth = 0;
+    size_type size = Codec::Size(key);
+    while (node != nullptr && node->type_ != kLeaf) {
+      Inner *inner = static_cast<Inner *>(node);
+      if (!SkipPrefix(inner, key, depth)) {
+        return nullptr;
+      }
+      if (depth == size) {
+        node = inner->terminal_;
+        break;
+      }
+      Node **child = FindChild(inner, Codec::Byte(key, depth));
+      node = child != nullptr ? *child : nullptr;
+      ++depth;
+    }
+    Leaf *leaf = static_cast<Leaf *>(node);
+    return leaf != nullptr && KeyOf(leaf->value_) == key ? leaf : nullptr;
+  }
+
+  Links *LowerBoundLinks(const key_type &key) const noexcept {
+    Node *node = root_;
+    size_type depth = 0;
+    size_type size = Codec::Size(key);
+    while (node != nullptr) {
+      if (node->type_ == kLeaf) {
+        Leaf *leaf = static_cast<Leaf *>(node);
+        return CompareKeys(KeyOf(leaf->value_), key, depth) < 0 ? leaf->next_
+                                                                 : leaf;
+      }
+      Inner *inner = static_cast<Inner *>(node);
+      size_type matched = MatchPrefix(inner, key, depth);
+      if (matched < inner->prefix_length_) {
+        if (depth + matched == size ||
+            Codec::Byte(key, depth + matched) <
+                PrefixByte(inner, matched, depth)) {
+          return MinLeaf(inner);
+        }
+        return MaxLeaf(inner)->next_;
+      }
+      depth += matched;
+      if (depth == size) {
+        return inner->terminal_ != nullptr ? inner->terminal_ : MinLeaf(inner);
+      }
+      unsigned char byte = Codec::Byte(key, depth);
+      Node **child = FindChild(inner, byte);
+      if (child == nullptr) {
+        Node *above = ChildAfter(inner, byte);
+        return above != nullptr ? MinLeaf(above) : MaxLeaf(inner)->next_;
+      }
+      node = *child;
+      ++depth;
+    }
+    return Head();
+  }
+
+  Links *UpperBoundLinks(const key_type &key) const noexcept {
+    Links *lower = LowerBoundLinks(key);
+    if (lower != Head() && KeyOf(static_cast<Leaf *>(lower)->value_) == key) {
+      return lower->next_;
+    }
+    return lower;
+  }
+
+  std::pair<Links *, Links *> PrefixRangeLinks(
+      const key_type &prefix) const noexcept {
+    Node *node = root_;
+    size_type depth = 0;
+    size_type size = Codec::Size(prefix);
+    while (node != nullptr) {
+      if (node->type_ == kLeaf) {
+        Leaf *leaf = static_cast<Leaf *>(node);
+        if (StartsWith(KeyOf(leaf->value_), prefix, depth)) {
+          return {leaf, leaf->next_};
+        }
+        break;
+      }
+      Inner *inner = static_cast<Inner *>(node);
+      size_type matched = MatchPrefix(inner, prefix, depth);
+      if (depth + matched == size) {
+        return {MinLeaf(inner), MaxLeaf(inner)->next_};
+      }
+      if (matched < inner->prefix_length_) {
+        break;
+      }
+      depth += matched;
+      Node **child = FindChild(inner, Codec::Byte(prefix, depth));
+      node = child != nullptr ? *child : nullptr;
+      ++depth;
+    }
+    return {Head(), Head()};
+  }
+
+  // Every step checks the whole prefix, as the nodes built from it must
+  // match every key below them.
+  template <typename... Args>
+  std::pair<Leaf *, bool> InsertLeaf(const key_type &key, Args &&...args) {
+    Node **ref = &root_;
+    size_type depth = 0;
+    size_type size = Codec::Size(key);
+    while (*ref != nullptr) {
+      if ((*ref)->type_ == kLeaf) {
+        Leaf *old = static_cast<Leaf *>(*ref);
+        if (KeyOf(old->value_) == key) {
+          return {old, false};
+        }
+        return {SplitLeaf(ref, depth, key, std::forward<Args>(args)...), true};
+      }
+      Inner *inner = static_cast<Inner *>(*ref);
+      size_type matched = MatchPrefix(inner, key, depth);
+      if (matched < inner->prefix_length_) {
+        return {SplitPrefix(ref, depth, matched, key,
+                            std::forward<Args>(args)...),
+                true};
+      }
+      depth += matched;
+      if (depth == size) {
+        if (inner->terminal_ != nullptr) {
+          return {inner->terminal_, false};
+        }
+        Leaf *leaf = new Leaf(std::forward<Args>(args)...);
+        Link(MinLeaf(inner)->prev_, leaf);
+        inner->terminal_ = leaf;
+        return {leaf, true};
+      }
+      unsigned char byte = Codec::Byte(key, depth);
+      Node **child = FindChild(inner, byte);
+      if (child == nullptr) {
+        return {AddLeaf(ref, byte, std::forward<Args>(args)...), true};
+      }
+      ref = child;
+      ++depth;
+    }
+    Leaf *leaf = new Leaf(std::forward<Args>(args)...);
+    Link(&head_, leaf);
+    root_ = leaf;
+    return {leaf, true};
+  }
+
+  // Replaces the leaf at *ref by a Node4 holding it and a new leaf for key,
+  // under the bytes they share from depth on.
+  template <typename... Args>
+  Leaf *SplitLeaf(Node **ref, size_type depth, const key_type &key,
+                  Args &&...args) {
+    Leaf *old = static_cast<Leaf *>(*ref);
+    const key_type &old_key = KeyOf(old->value_);
+    size_type size = Codec::Size(key);
+    size_type old_size = Codec::Size(old_key);
+    size_type split = depth;
+    while (split < size && split < old_size &&
+           Codec::Byte(key, split) == Codec::Byte(old_key, split)) {
+      ++split;
+    }
+    std::unique_ptr<Leaf> leaf(new Leaf(std::forward<Args>(args)...));
+    Node4 *inner = new Node4;
+    inner->prefix_length_ = static_cast<std::uint32_t>(split - depth);
+    for (size_type i = 0; i < kMaxPrefix && depth + i < split; ++i) {
+      inner->prefix_[i] = Codec::Byte(key, depth + i);
+    }
+    bool after_old;
+    if (split == size) {
+      inner->terminal_ = leaf.get();
+      Place(inner, Codec::Byte(old_key, split), old);
+      after_old = false;
+    } else if (split == old_size) {
+      inner->terminal_ = old;
+      Place(inner, Codec::Byte(key, split), leaf.get());
+      after_old = true;
+    } else {
+      Place(inner, Codec::Byte(old_key, split), old);
+      Place(inner, Codec::Byte(key, split), leaf.get());
+      after_old = Codec::Byte(old_key, split) < Codec::Byte(key, split);
+    }
+    *ref = inner;
+    Link(after_old ? old : old->prev_, leaf.get());
+    return leaf.release();
+  }
+
+  // Puts a Node4 over the inner node at *ref, whose prefix key leaves after
+  // matched bytes, holding it and a new leaf for key.
+  template <typename... Args>
+  Leaf *SplitPrefix(Node **ref, size_type depth, size_type matched,
+                    const key_type &key, Args &&...args) {
+    Inner *inner = static_cast<Inner *>(*ref);
+    std::unique_ptr<Leaf> leaf(new Leaf(std::forward<Args>(args)...));
+    Node4 *parent = new Node4;
+    unsigned char old_byte = PrefixByte(inner, matched, depth);
+    size_type rest = inner->prefix_length_ - matched - 1;
+    unsigned char rest_bytes[kMaxPrefix];
+    for (size_type i = 0; i < rest && i < kMaxPrefix; ++i) {
+      rest_bytes[i] = PrefixByte(inner, matched + 1 + i, depth);
+    }
+    Links *min = MinLeaf(inner);
+    Links *max = MaxLeaf(inner);
+    parent->prefix_length_ = static_cast<std::uint32_t>(matched);
+    std::memcpy(parent->prefix_, inner->prefix_,
+                std::min<size_type>(matched, kMaxPrefix));
+    inner->prefix_length_ = static_cast<std::uint32_t>(rest);
+    std::memcpy(inner->prefix_, rest_bytes, std::min(rest, kMaxPrefix));
+    Place(parent, old_byte, inner);
+    Links *prev = min->prev_;
+    if (depth + matched == Codec::Size(key)) {
+      parent->terminal_ = leaf.get();
+    } else {
+      unsigned char byte = Codec::Byte(key, depth + matched);
+      Place(parent, byte, leaf.get());
+      if (old_byte < byte) {
+        prev = max;
+      }
+    }
+    *ref = parent;
+    Link(prev, leaf.get());
+    return leaf.release();
+  }
+
+  // Adds a new leaf as the child for byte of the inner node at *ref,
+  // growing the node if it is full.
+  template <typename... Args>
+  Leaf *AddLeaf(Node **ref, unsigned char byte, Args &&...args) {
+    Inner *inner = static_cast<Inner *>(*ref);
+    Links *prev;
+    if (Node *below = ChildBefore(inner, byte); below != nullptr) {
+      prev = MaxLeaf(below);
+    } else if (inner->terminal_ != nullptr) {
+      prev = inner->terminal_;
+    } else {
+      prev = MinLeaf(ChildAfter(inner, byte))->prev_;
+    }
+    std::unique_ptr<Leaf> leaf(new Leaf(std::forward<Args>(args)...));
+    if (inner->count_ == Capacity(inner)) {
+      inner = Grow(inner);
+      *ref = inner;
+    }
+    PlaceChild(inner, byte, leaf.get());
+    Link(prev, leaf.get());
+    return leaf.release();
+  }
+
+  size_type EraseKey(const key_type &key) noexcept {
+    Node **ref = &root_;
+    Node **parent = nullptr;
+    unsigned char byte = 0;
+    size_type depth = 0;
+    size_type size = Codec::Size(key);
+    while (*ref != nullptr) {
+      if ((*ref)->type_ == kLeaf) {
+        Leaf *leaf = static_cast<Leaf *>(*ref);
+        if (!(KeyOf(leaf->value_) == key)) {
+          return 0;
+        }
+        if (parent == nullptr) {
+          root_ = nullptr;
+        } else {
+          RemoveChild(parent, byte);
+        }
+        DestroyLeaf(leaf);
+        return 1;
+      }
+      Inner *inner = static_cast<Inner *>(*ref);
+      if (!SkipPrefix(inner, key, depth)) {
+        return 0;
+      }
+      if (depth == size) {
+        Leaf *leaf = inner->terminal_;
+        if (leaf == nullptr || !(KeyOf(leaf->value_) == key)) {
+          return 0;
+        }
+        inner->terminal_ = nullptr;
+        Shrink(ref);
+        DestroyLeaf(leaf);
+        return 1;
+      }
+      byte = Codec::Byte(key, depth);
+      Node **child = FindChild(inner, byte);
+      if (child == nullptr) {
+        return 0;
+      }
+      parent = ref;
+      ref = child;
+      ++depth;
+    }
+    return 0;
+  }
+
+  void Link(Links *prev, Leaf *leaf) noexcept {
+    leaf->prev_ = prev;
+    leaf->next_ = prev->next_;
+    prev->next_->prev_ = leaf;
+    prev->next_ = leaf;
+    ++size_;
+  }
+
+  void DestroyLeaf(Leaf *leaf) noexcept {
+    leaf->prev_->next_ = leaf->next_;
+    leaf->next_->prev_ = leaf->prev_;
+    delete leaf;
+    --size_;
+  }
+
+  // Points the first and last leaves back at head_ after it moved.
+  void RelinkHead() noexcept {
+    if (size_ == 0) {
+      head_.prev_ = head_.next_ = &head_;
+    } else {
+      head_.next_->prev_ = &head_;
+      head_.prev_->next_ = &head_;
+    }
+  }
+
+  static Leaf *MinLeaf(Node *node) noexcept {
+    while (node->type_ != kLeaf) {
+      Inner *inner = static_cast<Inner *>(node);
+      if (inner->terminal_ != nullptr) {
+        return inner->terminal_;
+      }
+      node = ChildAfter(inner, -1);
+    }
+    return static_cast<Leaf *>(node);
+  }
+
+  static Leaf *MaxLeaf(Node *node) noexcept {
+    while (node->type_ != kLeaf) {
+      node = ChildBefore(static_cast<Inner *>(node), 256);
+    }
+    return static_cast<Leaf *>(node);
+  }
+
+  // Number of keys of a sorted node less than byte.
+  template <size_type N, NodeType Type>
+  static size_type LowerIndex(const SortedNode<N, Type> *node,
+                              unsigned char byte) noexcept {
+#if defined(__SSE2__)
+    if constexpr (N == 16) {
+      __m128i flip = _mm_set1_epi8(static_cast<char>(0x80));
+      __m128i keys = _mm_xor_si128(
+          _mm_loadu_si128(reinterpret_cast<const __m128i *>(node->keys_)),
+          flip);
+      __m128i probe =
+          _mm_xor_si128(_mm_set1_epi8(static_cast<char>(byte)), flip);
+      unsigned mask =
+          static_cast<unsigned>(_mm_movemask_epi8(_mm_cmplt_epi8(keys, probe)));
+      mask &= (1u << node->count_) - 1;
+      return static_cast<size_type>(__builtin_popcount(mask));
+    }
+#endif
+    size_type index = 0;
+    while (index < node->count_ && node->keys_[index] < byte) {
+      ++index;
+    }
+    return index;
+  }
+
+  template <size_type N, NodeType Type>
+  static Node **FindIn(SortedNode<N, Type> *node, unsigned char byte) noexcept {
+#if defined(__SSE2__)
+    if constexpr (N == 16) {
+      __m128i equal = _mm_cmpeq_epi8(
+          _mm_set1_epi8(static_cast<char>(byte)),
+          _mm_loadu_si128(reinterpret_cast<const __m128i *>(node->keys_)));
+      unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(equal));
+      mask &= (1u << node->count_) - 1;
+      return mask != 0 ? &node->children_[__builtin_ctz(mask)] : nullptr;
+    }
+#endif
+    for (size_type index = 0; index < node->count_; ++index) {
+      if (node->keys_[index] == byte) {
+        return &node->children_[index];
+      }
+    }
+    return nullptr;
+  }
+
+  static Node **FindChild(Inner *inner, unsigned char byte) noexcept {
+    switch (inner->type_) {
+      case kNode4:
+        return FindIn(static_cast<Node4 *>(inner), byte);
+      case kNode16:
+        return FindIn(static_cast<Node16 *>(inner), byte);
+      case kNode48: {
+        Node48 *node = static_cast<Node48 *>(inner);
+        unsigned char slot = node->index_[byte];
+        return slot != 0 ? &node->children_[slot - 1] : nullptr;
+      }
+      default: {
+        Node256 *node = static_cast<Node256 *>(inner);
+        return node->children_[byte] != nullptr ? &node->children_[byte]
+                                                : nullptr;
+      }
+    }
+  }
+
+  template <size_type N, NodeType Type>
+  static Node *SortedAfter(SortedNode<N, Type> *node, int byte) noexcept {
+    size_type index = 0;
+    if (byte >= 0) {
+      index = LowerIndex(node, static_cast<unsigned char>(byte));
+      if (index < node->count_ && node->keys_[index] == byte) {
+        ++index;
+      }
+    }
+    return index < node->count_ ? node->children_[index] : nullptr;
+  }
+
+  template <size_type N, NodeType Type>
+  static Node *SortedBefore(SortedNode<N, Type> *node, int byte) noexcept {
+    size_type index = byte > 255
+                          ? node->count_
+                          : LowerIndex(node, static_cast<unsigned char>(byte));
+    return index > 0 ? node->children_[index - 1] : nullptr;
+  }
+
+  // Child with the smallest byte greater than byte, which may be -1.
+  static Node *ChildAfter(Inner *inner, int byte) noexcept {
+    switch (inner->type_) {
+      case kNode4:
+        return SortedAfter(static_cast<Node4 *>(inner), byte);
+      case kNode16:
+        return SortedAfter(static_cast<Node16 *>(inner), byte);
+      case kNode48: {
+        Node48 *node = static_cast<Node48 *>(inner);
+        for (int next = byte + 1; next < 256; ++next) {
+          if (node->index_[next] != 0) {
+            return node->children_[node->index_[next] - 1];
+          }
+        }
+        return nullptr;
+      }
+      default: {
+        Node256 *node = static_cast<Node256 *>(inner);
+        for (int next = byte + 1; next < 256; ++next) {
+          if (node->children_[next] != nullptr) {
+            return node->children_[next];
+          }
+        }
+        return nullptr;
+      }
+    }
+  }
+
+  // Child with the greatest byte less than byte, which may be 256.
+  static Node *ChildBefore(Inner *inner, int byte) noexcept {
+    switch (inner->type_) {
+      case kNode4:
+        return SortedBefore(static_cast<Node4 *>(inner), byte);
+      case kNode16:
+        return SortedBefore(static_cast<Node16 *>(inner), byte);
+      case kNode48: {
+        Node48 *node = static_cast<Node48 *>(inner);
+        for (int next = byte - 1; next >= 0; --next) {
+          if (node->index_[next] != 0) {
+            return node->children_[node->index_[next] - 1];
+          }
+        }
+        return nullptr;
+      }
+      default: {
+        Node256 *node = static_cast<Node256 *>(inner);
+        for (int next = byte - 1; next >= 0; --next) {
+          if (node->children_[next] != nullptr) {
+            return node->children_[next];
+          }
+        }
+        return nullptr;
+      }
+    }
+  }
+
+  // Calls function(byte, child) for every child in byte order.
+  template <typename Function>
+  static void ForEachChild(Inner *inner, Function function) {
+    switch (inner->type_) {
+      case kNode4: {
+        Node4 *node = static_cast<Node4 *>(inner);
+        for (size_type index = 0; index < node->count_; ++index) {
+          function(node->keys_[index], node->children_[index]);
+        }
+        break;
+      }
+      case kNode16: {
+        Node16 *node = static_cast<Node16 *>(inner);
+        for (size_type index = 0; index < node->count_; ++index) {
+          function(node->keys_[index], node->children_[index]);
+        }
+        break;
+      }
+      case kNode48: {
+        Node48 *node = static_cast<Node48 *>(inner);
+        for (int byte = 0; byte < 256; ++byte) {
+          if (node->index_[byte] != 0) {
+            function(static_cast<unsigned char>(byte),
+                     node->children_[node->index_[byte] - 1]);
+          }
+        }
+        break;
+      }
+      default: {
+        Node256 *node = static_cast<Node256 *>(inner);
+        for (int byte = 0; byte < 256; ++byte) {
+          if (node->children_[byte] != nullptr) {
+            function(static_cast<unsigned char>(byte), node->children_[byte]);
+          }
+        }
+      }
+    }
+  }
+
+  // Adds a child to a node that has room for it.
+  template <size_type N, NodeType Type>
+  static void Place(SortedNode<N, Type> *node, unsigned char byte,
+                    Node *child) noexcept {
+    size_type index = LowerIndex(node, byte);
+    for (size_type i = node->count_; i > index; --i) {
+      node->keys_[i] = node->keys_[i - 1];
+      node->children_[i] = node->children_[i - 1];
+    }
+    node->keys_[index] = byte;
+    node->children_[index] = child;
+    ++node->count_;
+  }
+
+  static void Place(Node48 *node, unsigned char byte, Node *child) noexcept {
+    size_type slot = 0;
+    while (node->children_[slot] != nullptr) {
+      ++slot;
+    }
+    node->children_[slot] = child;
+    node->index_[byte] = static_cast<unsigned char>(slot + 1);
+    ++node->count_;
+  }
+
+  static void Place(Node256 *node, unsigned char byte, Node *child) noexcept {
+    node->children_[byte] = child;
+    ++node->count_;
+  }
+
+  static void PlaceChild(Inner *inner, unsigned char byte,
+                         Node *child) noexcept {
+    switch (inner->type_) {
+      case kNode4:
+        Place(static_cast<Node4 *>(inner), byte, child);
+        break;
+      case kNode16:
+        Place(static_cast<Node16 *>(inner), byte, child);
+        break;
+      case kNode48:
+        Place(static_cast<Node48 *>(inner), byte, child);
+        break;
+      default:
+        Place(static_cast<Node256 *>(inner), byte, child);
+    }
+  }
+
+  static size_type Capacity(const Inner *inner) noexcept {
+    switch (inner->type_) {
+      case kNode4:
+        return 4;
+      case kNode16:
+        return 16;
+      case kNode48:
+        return 48;
+      default:
+        return 256;
+    }
+  }
+
+  // Moves the prefix, terminal leaf and children of from into a new node
+  // of type To and frees from.
+  template <typename To>
+  static Inner *Convert(Inner *from) {
+    To *to = new To;
+    to->prefix_length_ = from->prefix_length_;
+    std::memcpy(to->prefix_, from->prefix_, kMaxPrefix);
+    to->terminal_ = from->terminal_;
+    ForEachChild(from,
+                 [to](unsigned char byte, Node *child) {
+                   Place(to, byte, child);
+                 });
+    DeleteInner(from);
+    return to;
+  }
+
+  static Inner *Grow(Inner *inner) {
+    switch (inner->type_) {
+      case kNode4:
+        return Convert<Node16>(inner);
+      case kNode16:
+        return Convert<Node48>(inner);
+      default:
+        return Convert<Node256>(inner);
+    }
+  }
+
+  void RemoveChild(Node **ref, unsigned char byte) noexcept {
+    Inner *inner = static_cast<Inner *>(*ref);
+    switch (inner->type_) {
+      case kNode4:
+        RemoveSorted(static_cast<Node4 *>(inner), byte);
+        break;
+      case kNode16:
+        RemoveSorted(static_cast<Node16 *>(inner), byte);
+        break;
+      case kNode48: {
+        Node48 *node = static_cast<Node48 *>(inner);
+        node->children_[node->index_[byte] - 1] = nullptr;
+        node->index_[byte] = 0;
+        --node->count_;
+        break;
+      }
+      default: {
+        Node256 *node = static_cast<Node256 *>(inner);
+        node->children_[byte] = nullptr;
+        --node->count_;
+      }
+    }
+    Shrink(ref);
+  }
+
+  template <size_type N, NodeType Type>
+  static void RemoveSorted(SortedNode<N, Type> *node,
+                           unsigned char byte) noexcept {
+    size_type index = LowerIndex(node, byte);
+    --node->count_;
+    for (size_type i = index; i < node->count_; ++i) {
+      node->keys_[i] = node->keys_[i + 1];
+      node->children_[i] = node->children_[i + 1];
+    }
+  }
+
+  // Restores the invariants of the inner node at *ref after it lost a
+  // child or its terminal leaf: every inner node keeps two entries or
+  // more, and nodes drop to the next size when a quarter or less full.
+  void Shrink(Node **ref) noexcept {
+    Inner *inner = static_cast<Inner *>(*ref);
+    if (inner->count_ == 0) {
+      *ref = inner->terminal_;
+      DeleteInner(inner);
+      return;
+    }
+    if (inner->count_ == 1 && inner->terminal_ == nullptr) {
+      *ref = Collapse(inner);
+      return;
+    }
+    try {
+      if (inner->type_ == kNode16 && inner->count_ <= 3) {
+        *ref = Convert<Node4>(inner);
+      } else if (inner->type_ == kNode48 && inner->count_ <= 12) {
+        *ref = Convert<Node16>(inner);
+      } else if (inner->type_ == kNode256 && inner->count_ <= 37) {
+        *ref = Convert<Node48>(inner);
+      }
+    } catch (const std::bad_alloc &) {
+      // A larger node than needed is still valid.
+    }
+  }
+
+  // Frees an inner node with one child and no terminal leaf and returns
+  // the child, which takes over the prefix and byte that led to it.
+  static Node *Collapse(Inner *inner) noexcept {
+    unsigned char byte = 0;
+    Node *child = nullptr;
+    ForEachChild(inner, [&](unsigned char key, Node *node) {
+      byte = key;
+      child = node;
+    });
+    if (child->type_ != kLeaf) {
+      Inner *below = static_cast<Inner *>(child);
+      unsigned char prefix[kMaxPrefix];
+      size_type length =
+          std::min<size_type>(inner->prefix_length_, kMaxPrefix);
+      std::memcpy(prefix, inner->prefix_, length);
+      if (length < kMaxPrefix) {
+        prefix[length++] = byte;
+      }
+      for (size_type i = 0; length < kMaxPrefix && i < below->prefix_length_;
+           ++i) {
+        prefix[length++] = below->prefix_[i];
+      }
+      std::memcpy(below->prefix_, prefix, length);
+      below->prefix_length_ += inner->prefix_length_ + 1;
+    }
+    DeleteInner(inner);
+    return child;
+  }
+
+  static void DeleteInner(Inner *inner) noexcept {
+    switch (inner->type_) {
+      case kNode4:
+        delete static_cast<Node4 *>(inner);
+        break;
+      case kNode16:
+        delete static_cast<Node16 *>(inner);
+        break;
+      case kNode48:
+        delete static_cast<Node48 *>(inner);
+        break;
+      default:
+        delete static_cast<Node256 *>(inner);
+    }
+  }
+
+  static void Destroy(Node *node) noexcept {
+    if (node == nullptr) {
+      return;
+    }
+    if (node->type_ == kLeaf) {
+      delete static_cast<Leaf *>(node);
+      return;
+    }
+    Inner *inner = static_cast<Inner *>(node);
+    ForEachChild(inner, [](unsigned char, Node *child) { Destroy(child); });
+    delete inner->terminal_;
+    DeleteInner(inner);
+  }
+
+  struct Iterator {
+    using iterator_category = std::bidirectional_iterator_tag;
+    using difference_type = std::ptrdiff_t;
+    using value_type = art::value_type;
+    using pointer = value_type *;
+    using reference = value_type &;
+
+    explicit Iterator(Links *node) noexcept : node_(node) {}
+
+    reference operator*() const noexcept {
+      return static_cast<Leaf *>(node_)->value_;
+    }
+
+    pointer operator->() const noexcept {
+      return &static_cast<Leaf *>(node_)->value_;
+    }
+
+    iterator &operator++() noexcept {
+      node_ = node_->next_;
+      return *this;
+    }
+
+    iterator operator++(int) noexcept {
+      iterator previous = *this;
+      node_ = node_->next_;
+      return previous;
+    }
+
+    iterator &operator--() noexcept {
+      node_ = node_->prev_;
+      return *this;
+    }
+
+    iterator operator--(int) noexcept {
+      iterator previous = *this;
+      node_ = node_->prev_;
+      return previous;
+    }
+
+    bool operator==(const iterator &other) const noexcept {
+      return node_ == other.node_;
+    }
+
+    bool operator!=(const iterator &other) const noexcept {
+      return node_ != other.node_;
+    }
+
+    Links *node_;
+  };
+
+  struct IteratorConst {
+    using iterator_category = std::bidirectional_iterator_tag;
+    using difference_type = std::ptrdiff_t;
+    using value_type = art::value_type;
+    using pointer = const value_type *;
+    using reference = const value_type &;
+
+    explicit IteratorConst(const Links *node) noexcept : node_(node) {}
+
+    IteratorConst(const iterator &it) noexcept : node_(it.node_) {}
+
+    reference operator*() const noexcept {
+      return static_cast<const Leaf *>(node_)->value_;
+    }
+
+    pointer operator->() const noexcept {
+      return &static_cast<const Leaf *>(node_)->value_;
+    }
+
+    const_iterator &operator++() noexcept {
+      node_ = node_->next_;
+      return *this;
+    }
+
+    const_iterator operator++(int) noexcept {
+      const_iterator previous = *this;
+      node_ = node_->next_;
+      return previous;
+    }
+
+    const_iterator &operator--() noexcept {
+      node_ = node_->prev_;
+      return *this;
+    }
+
+    const_iterator operator--(int) noexcept {
+      const_iterator previous = *this;
+      node_ = node_->prev_;
+      return previous;
+    }
+
+    friend bool operator==(const const_iterator &it1,
+                           const const_iterator &it2) noexcept {
+      return it1.node_ == it2.node_;
+    }
+
+    friend bool operator!=(const const_iterator &it1,
+                           const const_iterator &it2) noexcept {
+      return it1.node_ != it2.node_;
+    }
+
+    const Links *node_;
+  };
+
+  Node *root_ = nullptr;
+  Links head_{&head_, &head_};
+  size_type size_ = 0;
+};
+
+}  // namespace s21
+
+#endif  // CONTAINERS_S21_ART_H_
@@ -0,0 +1,168 @@
+#ifndef CONTAINERS_S21_ART_MAP_H_
+#define CONTAINERS_S21_ART_MAP_H_
+
+#include <stdexcept>
+#include <tuple>
+
+#include "s21_art.h"
+
+namespace s21 {
+// Map on the adaptive radix tree engine; see art_set. Elements never move,
+// so iterators stay valid until their element is erased.
+template <class Key, class Type, class Codec = art_key<Key>>
+class art_map {
+ public:
+  using key_type = Key;
+  using mapped_type = Type;
+  using value_type = std::pair<const key_type, mapped_type>;
+  using reference = value_type &;
+  using const_reference = const value_type &;
+  using tree_type = art<key_type, value_type, art_select_first, Codec>;
+  using iterator = typename tree_type::iterator;
+  using const_iterator = typename tree_type::const_iterator;
+  using size_type = std::size_t;
+
+  art_map() : tree_(new tree_type{}) {}
+
+  art_map(std::initializer_list<value_type> const &items)
+      : art_map(items.begin(), items.end()) {}
+
+  template <typename InputIt>
+  art_map(InputIt first, InputIt last) : art_map() {
+    for (; first != last; ++first) {
+      insert(*first);
+    }
+  }
+
+  art_map(const art_map &other) : tree_(new tree_type(*other.tree_)) {}
+
+  art_map(art_map &&other) noexcept
+      : tree_(new tree_type(std::move(*other.tree_))) {}
+
+  art_map &operator=(const art_map &other) {
+    *tree_ = *other.tree_;
+    return *this;
+  }
+
+  art_map &operator=(art_map &&other) noexcept {
+    *tree_ = std::move(*other.tree_);
+    return *this;
+  }
+
+  ~art_map() {
+    delete tree_;
+    tree_ = nullptr;
+  }
+
+  mapped_type &at(const key_type &key) {
+    iterator it_search = tree_->Find(key);
+    if (it_search == end()) {
+      throw std::out_of_range("there is no such key");
+    }
+    return it_search->second;
+  }
+
+  const mapped_type &at(const key_type &key) const {
+    return const_cast<art_map *>(this)->at(key);
+  }
+
+  mapped_type &operator[](const key_type &key) {
+    return tree_->TryEmplace(key, key, mapped_type{}).first->second;
+  }
+
+  iterator begin() noexcept { return tree_->Begin(); }
+
+  const_iterator begin() const noexcept { return tree_->Begin(); }
+
+  iterator end() noexcept { return tree_->End(); }
+
+  const_iterator end() const noexcept { return tree_->End(); }
+
+  bool empty() const noexcept { return tree_->Empty(); }
+
+  size_type size() const noexcept { return tree_->Size(); }
+
+  size_type max_size() const noexcept { return tree_->MaxSize(); }
+
+  void clear() noexcept { tree_->Clear(); }
+
+  std::pair<iterator, bool> insert(const value_type &value) {
+    return tree_->TryEmplace(value.first, value);
+  }
+
+  std::pair<iterator, bool> insert(const key_type &key,
+                                   const mapped_type &obj) {
+    return tree_->TryEmplace(key, key, obj);
+  }
+
+  std::pair<iterator, bool> insert_or_assign(const key_type &key,
+                                             const mapped_type &obj) {
+    std::pair<iterator, bool> result = tree_->TryEmplace(key, key, obj);
+    if (!result.second) {
+      result.first->second = obj;
+    }
+    return result;
+  }
+
+  // Constructs the mapped value from args only if key is absent.
+  template <typename... Args>
+  std::pair<iterator, bool> try_emplace(const key_type &key, Args &&...args) {
+    return tree_->TryEmplace(
+        key, std::piecewise_construct, std::forward_as_tuple(key),
+        std::forward_as_tuple(std::forward<Args>(args)...));
+  }
+
+  // Returns an iterator to the element that followed the erased one.
+  iterator erase(const_iterator pos) noexcept { return tree_->Erase(pos); }
+
+  // Removes the element with the given key; returns how many there were.
+  size_type erase(const key_type &key) noexcept { return tree_->Erase(key); }
+
+  void swap(art_map &other) noexcept { tree_->Swap(*other.tree_); }
+
+  iterator find(const key_type &key) noexcept { return tree_->Find(key); }
+
+  const_iterator find(const key_type &key) const noexcept {
+    return tree_->Find(key);
+  }
+
+  bool contains(const key_type &key) const noexcept {
+    return tree_->Find(key) != tree_->End();
+  }
+
+  size_type count(const key_type &key) const noexcept {
+    return tree_->Count(key);
+  }
+
+  iterator lower_bound(const key_type &key) noexcept {
+    return tree_->LowerBound(key);
+  }
+
+  const_iterator lower_bound(const key_type &key) const noexcept {
+    return tree_->LowerBound(key);
+  }
+
+  iterator upper_bound(const key_type &key) noexcept {
+    return tree_->UpperBound(key);
+  }
+
+  const_iterator upper_bound(const key_type &key) const noexcept {
+    return tree_->UpperBound(key);
+  }
+
+  // The elements whose keys start with prefix; see art_set::prefix_range.
+  std::pair<iterator, iterator> prefix_range(const key_type &prefix) noexcept {
+    return tree_->PrefixRange(prefix);
+  }
+
+  std::pair<const_iterator, const_iterator> prefix_range(
+      const key_type &prefix) const noexcept {
+    return tree_->PrefixRange(prefix);
+  }
+
+ private:
+  tree_type *tree_;
+};
+}  // namespace s21
+
+#endif  // CONTAINERS_S21_ART_MAP_H_
@@ -0,0 +1,112 @@
+#ifndef CONTAINERS_S21_ART_SET_H_
+#define CONTAINERS_S21_ART_SET_H_
+
+#include "s21_art.h"
+
+namespace s21 {
+// Set on the adaptive radix tree engine, for integer and std::string keys
+// or others with an art_key encoding. Lookups cost O(key length) instead
+// of O(log n) key comparisons, and prefix_range() finds the keys starting
+// with a prefix. Keys are ordered by their encoding, which for integers
+// and strings is operator<; there is no Compare parameter.
+template <class Key, class Codec = art_key<Key>>
+class art_set {
+ public:
+  using key_type = Key;
+  using value_type = key_type;
+  using reference = value_type &;
+  using const_reference = const value_type &;
+  using tree_type = art<key_type, value_type, art_identity, Codec>;
+  using iterator = typename tree_type::const_iterator;
+  using const_iterator = typename tree_type::const_iterator;
+  using size_type = std::size_t;
+
+  art_set() : tree_(new tree_type{}) {}
+
+  art_set(std::initializer_list<value_type> const &items)
+      : art_set(items.begin(), items.end()) {}
+
+  template <typename InputIt>
+  art_set(InputIt first, InputIt last) : art_set() {
+    for (; first != last; ++first) {
+      insert(*first);
+    }
+  }
+
+  art_set(const art_set &other) : tree_(new tree_type(*other.tree_)) {}
+
+  art_set(art_set &&other) noexcept
+      : tree_(new tree_type(std::move(*other.tree_))) {}
+
+  art_set &operator=(const art_set &other) {
+    *tree_ = *other.tree_;
+    return *this;
+  }
+
+  art_set &operator=(art_set &&other) noexcept {
+    *tree_ = std::move(*other.tree_);
+    return *this;
+  }
+
+  ~art_set() {
+    delete tree_;
+    tree_ = nullptr;
+  }
+
+  const_iterator begin() const noexcept { return tree_->Begin(); }
+
+  const_iterator end() const noexcept { return tree_->End(); }
+
+  bool empty() const noexcept { return tree_->Empty(); }
+
+  size_type size() const noexcept { return tree_->Size(); }
+
+  size_type max_size() const noexcept { return tree_->MaxSize(); }
+
+  void clear() noexcept { tree_->Clear(); }
+
+  std::pair<iterator, bool> insert(const value_type &value) {
+    return tree_->TryEmplace(value, value);
+  }
+
+  // Returns an iterator to the element that followed the erased one.
+  iterator erase(const_iterator pos) noexcept { return tree_->Erase(pos); }
+
+  // Removes the element equal to key; returns how many there were.
+  size_type erase(const key_type &key) noexcept { return tree_->Erase(key); }
+
+  void swap(art_set &other) noexcept { tree_->Swap(*other.tree_); }
+
+  const_iterator find(const key_type &key) const noexcept {
+    return tree_->Find(key);
+  }
+
+  bool contains(const key_type &key) const noexcept {
+    return tree_->Find(key) != tree_->End();
+  }
+
+  size_type count(const key_type &key) const noexcept {
+    return tree_->Count(key);
+  }
+
+  const_iterator lower_bound(const key_type &key) const noexcept {
+    return tree_->LowerBound(key);
+  }
+
+  const_iterator upper_bound(const key_type &key) const noexcept {
+    return tree_->UpperBound(key);
+  }
+
+  // The keys that start with prefix, e.g. every "user/..." string, found
+  // in O(prefix length).
+  std::pair<const_iterator, const_iterator> prefix_range(
+      const key_type &prefix) const noexcept {
+    return tree_->PrefixRange(prefix);
+  }
+
+ private:
+  tree_type *tree_;
+};
+}  // namespace s21
+
+#endif  // CONTAINERS_S21_ART_SET_H_
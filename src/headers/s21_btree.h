@@ -0,0 +1,887 @@
+#ifndef CONTAINERS_S21_BTREE_H_
+#define CONTAINERS_S21_BTREE_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <new>
+#include <utility>
+#include <vector>
+
+namespace s21 {
+// Key extractors of s21::btree: sets store bare keys, maps store pairs.
+struct btree_identity {
+  template <typename T>
+  const T &operator()(const T &value) const noexcept {
+    return value;
+  }
+};
+
+struct btree_select_first {
+  template <typename Pair>
+  const typename Pair::first_type &operator()(
+      const Pair &value) const noexcept {
+    return value.first;
+  }
+};
+
+// B+-tree engine of btree_set, btree_map and btree_multiset. Values are
+// stored contiguously in leaves of about kNodeBytes, inner nodes hold copies
+// of the separating keys and leaves are linked both ways for range scans.
+// Unlike s21::tree, insertion and erasure move values between nodes, so they
+// invalidate iterators and references.
+template <typename Key, typename Value = Key,
+          typename KeyOfValue = btree_identity,
+          typename Comparison = std::less<Key>>
+class btree {
+ private:
+  struct Node;
+  struct Leaf;
+  struct Inner;
+  struct Iterator;
+  struct IteratorConst;
+
+ public:
+  using key_type = Key;
+  using value_type = Value;
+  using reference = value_type &;
+  using const_reference = const value_type &;
+  using iterator = Iterator;
+  using const_iterator = IteratorConst;
+  using size_type = std::size_t;
+
+  // Target size of a node: a few cache lines.
+  static constexpr size_type kNodeBytes = 256;
+
+  btree() = default;
+
+  btree(const btree &other) : cmp_(other.cmp_) {
+    BuildSorted(other.Begin(), other.End(), false);
+  }
+
+  btree(btree &&other) noexcept { Swap(other); }
+
+  btree &operator=(const btree &other) {
+    if (this != &other) {
+      btree copy(other);
+      Swap(copy);
+    }
+    return *this;
+  }
+
+  btree &operator=(btree &&other) noexcept {
+    Clear();
+    Swap(other);
+    return *this;
+  }
+
+  ~btree() { Clear(); }
+
+  void Clear() noexcept {
+    Destroy(root_);
+    root_ = nullptr;
+    first_ = nullptr;
+    last_ = nullptr;
+    size_ = 0;
+  }
+
+  size_type Size() const noexcept { return size_; }
+
+  bool Empty() const noexcept { return size_ == 0; }
+
+  size_type MaxSize() const noexcept {
+    return (std::numeric_limits<size_type>::max() / 2 - sizeof(btree)) /
+           sizeof(value_type);
+  }
+
+  iterator Begin() noexcept { return iterator(first_, 0); }
+
+  const_iterator Begin() const noexcept { return const_iterator(first_, 0); }
+
+  iterator End() noexcept {
+    return iterator(last_, last_ != nullptr ? last_->count_ : 0);
+  }
+
+  const_iterator End() const noexcept {
+    return const_iterator(last_, last_ != nullptr ? last_->count_ : 0);
+  }
+
+  iterator Insert(const value_type &value) {
+    return InsertMulti(value_type(value));
+  }
+
+  iterator Insert(value_type &&value) { return InsertMulti(std::move(value)); }
+
+  std::pair<iterator, bool> InsertUnique(const value_type &value) {
+    return InsertUniqueValue(value);
+  }
+
+  std::pair<iterator, bool> InsertUnique(value_type &&value) {
+    return InsertUniqueValue(std::move(value));
+  }
+
+  template <typename... Args>
+  iterator Emplace(Args &&...args) {
+    return InsertMulti(value_type(std::forward<Args>(args)...));
+  }
+
+  template <typename... Args>
+  std::pair<iterator, bool> EmplaceUnique(Args &&...args) {
+    return InsertUniqueValue(value_type(std::forward<Args>(args)...));
+  }
+
+  // Replaces the content with an already sorted range in linear time. Leaves
+  // are filled completely, which keeps later scans dense.
+  template <typename ForwardIt>
+  void AssignSorted(ForwardIt first, ForwardIt last) {
+    btree sorted;
+    sorted.cmp_ = cmp_;
+    sorted.BuildSorted(first, last, false);
+    Swap(sorted);
+  }
+
+  // Like AssignSorted, but keeps only the first of equal values.
+  template <typename ForwardIt>
+  void AssignSortedUnique(ForwardIt first, ForwardIt last) {
+    btree sorted;
+    sorted.cmp_ = cmp_;
+    sorted.BuildSorted(first, last, true);
+    Swap(sorted);
+  }
+
+  // Moves every value of other into this tree.
+  void Merge(btree &other) { MergeFrom(other, false); }
+
+  // Like Merge, but values whose key is already present stay in other.
+  void MergeUnique(btree &other) { MergeFrom(other, true); }
+
+  iterator Find(const key_type &key) {
+    iterator result = LowerBound(key);
+    return IsKeyAt(result, key) ? result : End();
+  }
+
+  const_iterator Find(const key_type &key) const {
+    return const_cast<btree *>(this)->Find(key);
+  }
+
+  iterator LowerBound(const key_type &key) {
+    return Normalize(Descend(key, false));
+  }
+
+  const_iterator LowerBound(const key_type &key) const {
+    return const_cast<btree *>(this)->LowerBound(key);
+  }
+
+  iterator UpperBound(const key_type &key) {
+    return Normalize(Descend(key, true));
+  }
+
+  const_iterator UpperBound(const key_type &key) const {
+    return const_cast<btree *>(this)->UpperBound(key);
+  }
+
+  // Number of values with the given key in O(log n + count / leaf size).
+  size_type Count(const key_type &key) const {
+    const_iterator lower = LowerBound(key);
+    const_iterator upper = UpperBound(key);
+    size_type count = upper.index_ - lower.index_;
+    for (const Leaf *leaf = lower.leaf_; leaf != upper.leaf_;
+         leaf = leaf->next_) {
+      count += leaf->count_;
+    }
+    return count;
+  }
+
+  // Erases the value at pos and returns an iterator to the value that
+  // followed it.
+  iterator Erase(iterator pos) {
+    if (pos == End()) {
+      return pos;
+    }
+    Leaf *leaf = pos.leaf_;
+    size_type index = pos.index_;
+    leaf->Values()[index].~value_type();
+    MoveValues(leaf, index + 1, leaf->count_, leaf, index);
+    --leaf->count_;
+    --size_;
+    if (leaf == root_) {
+      if (leaf->count_ == 0) {
+        Clear();
+        return End();
+      }
+      return iterator(leaf, index);
+    }
+    iterator next(nullptr, 0);
+    if (index < leaf->count_) {
+      next = iterator(leaf, index);
+    } else if (leaf->next_ != nullptr) {
+      next = iterator(leaf->next_, 0);
+    }
+    if (leaf->count_ < kMinLeafSlots) {
+      RebalanceLeaf(leaf, next);
+    }
+    return next.leaf_ != nullptr ? next : End();
+  }
+
+  void Swap(btree &other) noexcept {
+    std::swap(root_, other.root_);
+    std::swap(first_, other.first_);
+    std::swap(last_, other.last_);
+    std::swap(size_, other.size_);
+    std::swap(cmp_, other.cmp_);
+  }
+
+ private:
+  static constexpr size_type kMinSlots = 4;
+
+  static constexpr size_type kLeafSlots = std::max(
+      kMinSlots, (kNodeBytes - 2 * sizeof(void *) - 2 * sizeof(Node *)) /
+                     sizeof(value_type));
+
+  static constexpr size_type kInnerSlots = std::max(
+      kMinSlots, (kNodeBytes - 3 * sizeof(void *)) /
+                     (sizeof(key_type) + sizeof(Node *)));
+
+  // Nodes other than the root are rebalanced when they drop below these.
+  static constexpr size_type kMinLeafSlots = kLeafSlots / 2;
+  static constexpr size_type kMinInnerSlots = (kInnerSlots - 1) / 2;
+
+  static const key_type &KeyOf(const value_type &value) noexcept {
+    return KeyOfValue{}(value);
+  }
+
+  // Moves an object into raw storage and ends the life of the original.
+  template <typename T>
+  static void Relocate(T *from, T *to) {
+    new (to) T(std::move(*from));
+    from->~T();
+  }
+
+  // Relocates values [first, last) of from to position to of destination,
+  // which may be the same leaf.
+  static void MoveValues(Leaf *from, size_type first, size_type last,
+                         Leaf *destination, size_type to) {
+    value_type *source = from->Values();
+    value_type *target = destination->Values();
+    if (from != destination || to < first) {
+      for (size_type i = first; i < last; ++i) {
+        Relocate(source + i, target + to + (i - first));
+      }
+    } else {
+      for (size_type i = last; i > first; --i) {
+        Relocate(source + i - 1, target + to + (i - 1 - first));
+      }
+    }
+  }
+
+  // Position of the first value not less than key, or greater than key if
+  // upper is set, in the leaf where it would be inserted. The index may be
+  // one past the last value of that leaf.
+  iterator Descend(const key_type &key, bool upper) const {
+    Node *node = root_;
+    if (node == nullptr) {
+      return iterator(nullptr, 0);
+    }
+    while (!node->leaf_) {
+      Inner *inner = static_cast<Inner *>(node);
+      const key_type *keys = inner->Keys();
+      const key_type *bound =
+          upper ? std::upper_bound(keys, keys + inner->count_, key, cmp_)
+                : std::lower_bound(keys, keys + inner->count_, key, cmp_);
+      node = inner->children_[bound - keys];
+    }
+    Leaf *leaf = static_cast<Leaf *>(node);
+    const value_type *values = leaf->Values();
+    const value_type *bound;
+    if (upper) {
+      bound = std::upper_bound(
+          values, values + leaf->count_, key,
+          [this](const key_type &lhs, const value_type &rhs) {
+            return cmp_(lhs, KeyOf(rhs));
+          });
+    } else {
+      bound = std::lower_bound(
+          values, values + leaf->count_, key,
+          [this](const value_type &lhs, const key_type &rhs) {
+            return cmp_(KeyOf(lhs), rhs);
+          });
+    }
+    return iterator(leaf, bound - values);
+  }
+
+  // Moves a position past the end of a leaf to the start of the next one.
+  static iterator Normalize(iterator pos) noexcept {
+    if (pos.leaf_ != nullptr && pos.index_ == pos.leaf_->count_ &&
+        pos.leaf_->next_ != nullptr) {
+      return iterator(pos.leaf_->next_, 0);
+    }
+    return pos;
+  }
+
+  iterator InsertMulti(value_type &&value) {
+    return InsertAt(Descend(KeyOf(value), true), std::move(value));
+  }
+
+  // Copies or moves value into the tree only once it is known to be new.
+  template <typename V>
+  std::pair<iterator, bool> InsertUniqueValue(V &&value) {
+    iterator pos = Descend(KeyOf(value), false);
+    iterator found = Normalize(pos);
+    if (IsKeyAt(found, KeyOf(value))) {
+      return {found, false};
+    }
+    return {InsertAt(pos, value_type(std::forward<V>(value))), true};
+  }
+
+  bool IsKeyAt(iterator pos, const key_type &key) noexcept {
+    return pos != End() && !cmp_(key, KeyOf(*pos));
+  }
+
+  iterator InsertAt(iterator pos, value_type &&value) {
+    if (root_ == nullptr) {
+      Leaf *leaf = new Leaf;
+      root_ = first_ = last_ = leaf;
+      pos = iterator(leaf, 0);
+    }
+    Leaf *leaf = pos.leaf_;
+    size_type index = pos.index_;
+    if (leaf->count_ < kLeafSlots) {
+      PutValue(leaf, index, std::move(value));
+      return iterator(leaf, index);
+    }
+    // Appending to the last leaf leaves it full, so that ascending inserts
+    // produce dense leaves instead of half-empty ones.
+    size_type split = leaf == last_ && index == kLeafSlots
+                          ? kLeafSlots
+                          : (kLeafSlots + 1) / 2;
+    Leaf *right = new Leaf;
+    MoveValues(leaf, split, leaf->count_, right, 0);
+    right->count_ = leaf->count_ - split;
+    leaf->count_ = split;
+    LinkAfter(leaf, right);
+    Leaf *target = leaf;
+    if (index >= split) {
+      target = right;
+      index -= split;
+    }
+    PutValue(target, index, std::move(value));
+    InsertIntoParent(leaf, KeyOf(right->Values()[0]), right);
+    return iterator(target, index);
+  }
+
+  void PutValue(Leaf *leaf, size_type index, value_type &&value) {
+    MoveValues(leaf, index, leaf->count_, leaf, index + 1);
+    new (leaf->Values() + index) value_type(std::move(value));
+    ++leaf->count_;
+    ++size_;
+  }
+
+  void LinkAfter(Leaf *leaf, Leaf *next) noexcept {
+    next->prev_ = leaf;
+    next->next_ = leaf->next_;
+    if (leaf->next_ != nullptr) {
+      leaf->next_->prev_ = next;
+    } else {
+      last_ = next;
+    }
+    leaf->next_ = next;
+  }
+
+  void Unlink(Leaf *leaf) noexcept {
+    if (leaf->prev_ != nullptr) {
+      leaf->prev_->next_ = leaf->next_;
+    } else {
+      first_ = leaf->next_;
+    }
+    if (leaf->next_ != nullptr) {
+      leaf->next_->prev_ = leaf->prev_;
+    } else {
+      last_ = leaf->prev_;
+    }
+  }
+
+  // Adds right as the sibling following left, separated by key, splitting
+  // full inner nodes on the way up.
+  void InsertIntoParent(Node *left, const key_type &key, Node *right) {
+    Inner *parent = left->parent_;
+    if (parent == nullptr) {
+      Inner *root = new Inner;
+      new (root->Keys()) key_type(key);
+      root->count_ = 1;
+      root->children_[0] = left;
+      root->children_[1] = right;
+      left->parent_ = root;
+      right->parent_ = root;
+      root_ = root;
+      return;
+    }
+    size_type index = ChildIndex(parent, left);
+    if (parent->count_ < kInnerSlots) {
+      InsertChild(parent, index, key, right);
+      return;
+    }
+    size_type middle = kInnerSlots / 2;
+    Inner *sibling = new Inner;
+    key_type *keys = parent->Keys();
+    for (size_type i = middle + 1; i < parent->count_; ++i) {
+      Relocate(keys + i, sibling->Keys() + (i - middle - 1));
+    }
+    for (size_type i = middle + 1; i <= parent->count_; ++i) {
+      sibling->children_[i - middle - 1] = parent->children_[i];
+      parent->children_[i]->parent_ = sibling;
+    }
+    sibling->count_ = parent->count_ - middle - 1;
+    key_type separator(std::move(keys[middle]));
+    keys[middle].~key_type();
+    parent->count_ = middle;
+    if (index <= middle) {
+      InsertChild(parent, index, key, right);
+    } else {
+      InsertChild(sibling, index - middle - 1, key, right);
+    }
+    InsertIntoParent(parent, separator, sibling);
+  }
+
+  static void InsertChild(Inner *node, size_type index, const key_type &key,
+                          Node *child) {
+    key_type *keys = node->Keys();
+    for (size_type i = node->count_; i > index; --i) {
+      Relocate(keys + i - 1, keys + i);
+      node->children_[i + 1] = node->children_[i];
+    }
+    new (keys + index) key_type(key);
+    node->children_[index + 1] = child;
+    child->parent_ = node;
+    ++node->count_;
+  }
+
+  // Drops the key at index and the child following it.
+  static void RemoveChild(Inner *node, size_type index) noexcept {
+    key_type *keys = node->Keys();
+    keys[index].~key_type();
+    for (size_type i = index + 1; i < node->count_; ++i) {
+      Relocate(keys + i, keys + i - 1);
+      node->children_[i] = node->children_[i + 1];
+    }
+    --node->count_;
+  }
+
+  static size_type ChildIndex(const Inner *parent,
+                              const Node *child) noexcept {
+    size_type index = 0;
+    while (parent->children_[index] != child) {
+      ++index;
+    }
+    return index;
+  }
+
+  // Restores the occupancy of a leaf by borrowing a value from a sibling or
+  // merging with it. next tracks the value that followed the erased one.
+  void RebalanceLeaf(Leaf *leaf, iterator &next) {
+    Inner *parent = leaf->parent_;
+    size_type index = ChildIndex(parent, leaf);
+    Leaf *left = index > 0 ? static_cast<Leaf *>(parent->children_[index - 1])
+                           : nullptr;
+    Leaf *right = index < parent->count_
+                      ? static_cast<Leaf *>(parent->children_[index + 1])
+                      : nullptr;
+    if (left != nullptr && left->count_ > kMinLeafSlots) {
+      MoveValues(leaf, 0, leaf->count_, leaf, 1);
+      Relocate(left->Values() + left->count_ - 1, leaf->Values());
+      --left->count_;
+      ++leaf->count_;
+      parent->Keys()[index - 1] = KeyOf(leaf->Values()[0]);
+      if (next.leaf_ == leaf) {
+        ++next.index_;
+      }
+    } else if (right != nullptr && right->count_ > kMinLeafSlots) {
+      Relocate(right->Values(), leaf->Values() + leaf->count_);
+      MoveValues(right, 1, right->count_, right, 0);
+      ++leaf->count_;
+      --right->count_;
+      parent->Keys()[index] = KeyOf(right->Values()[0]);
+      if (next.leaf_ == right) {
+        next = next.index_ == 0 ? iterator(leaf, leaf->count_ - 1)
+                                : iterator(right, next.index_ - 1);
+      }
+    } else if (left != nullptr) {
+      MergeLeaves(left, leaf, next);
+      RemoveChild(parent, index - 1);
+      RebalanceInner(parent);
+    } else {
+      MergeLeaves(leaf, right, next);
+      RemoveChild(parent, index);
+      RebalanceInner(parent);
+    }
+  }
+
+  void MergeLeaves(Leaf *left, Leaf *right, iterator &next) {
+    size_type offset = left->count_;
+    MoveValues(right, 0, right->count_, left, offset);
+    left->count_ += right->count_;
+    if (next.leaf_ == right) {
+      next = iterator(left, offset + next.index_);
+    }
+    Unlink(right);
+    delete right;
+  }
+
+  void RebalanceInner(Inner *node) {
+    if (node == root_) {
+      if (node->count_ == 0) {
+        root_ = node->children_[0];
+        root_->parent_ = nullptr;
+        delete node;
+      }
+      return;
+    }
+    if (node->count_ >= kMinInnerSlots) {
+      return;
+    }
+    Inner *parent = node->parent_;
+    size_type index = ChildIndex(parent, node);
+    Inner *left = index > 0
+                      ? static_cast<Inner *>(parent->children_[index - 1])
+                      : nullptr;
+    Inner *right = index < parent->count_
+                       ? static_cast<Inner *>(parent->children_[index + 1])
+                       : nullptr;
+    key_type *keys = node->Keys();
+    if (left != nullptr && left->count_ > kMinInnerSlots) {
+      for (size_type i = node->count_; i > 0; --i) {
+        Relocate(keys + i - 1, keys + i);
+        node->children_[i + 1] = node->children_[i];
+      }
+      node->children_[1] = node->children_[0];
+      Relocate(parent->Keys() + index - 1, keys);
+      Relocate(left->Keys() + left->count_ - 1, parent->Keys() + index - 1);
+      node->children_[0] = left->children_[left->count_];
+      node->children_[0]->parent_ = node;
+      --left->count_;
+      ++node->count_;
+    } else if (right != nullptr && right->count_ > kMinInnerSlots) {
+      key_type *right_keys = right->Keys();
+      Relocate(parent->Keys() + index, keys + node->count_);
+      node->children_[node->count_ + 1] = right->children_[0];
+      node->children_[node->count_ + 1]->parent_ = node;
+      Relocate(right_keys, parent->Keys() + index);
+      for (size_type i = 1; i < right->count_; ++i) {
+        Relocate(right_keys + i, right_keys + i - 1);
+        right->children_[i - 1] = right->children_[i];
+      }
+      right->children_[right->count_ - 1] = right->children_[right->count_];
+      --right->count_;
+      ++node->count_;
+    } else if (left != nullptr) {
+      MergeInner(left, index - 1, node);
+    } else {
+      MergeInner(node, index, right);
+    }
+  }
+
+  // Pulls the separator at index of the common parent down into left and
+  // appends right to it.
+  void MergeInner(Inner *left, size_type index, Inner *right) {
+    Inner *parent = left->parent_;
+    key_type *keys = left->Keys();
+    new (keys + left->count_) key_type(std::move(parent->Keys()[index]));
+    for (size_type i = 0; i < right->count_; ++i) {
+      Relocate(right->Keys() + i, keys + left->count_ + 1 + i);
+    }
+    for (size_type i = 0; i <= right->count_; ++i) {
+      left->children_[left->count_ + 1 + i] = right->children_[i];
+      right->children_[i]->parent_ = left;
+    }
+    left->count_ += right->count_ + 1;
+    delete right;
+    RemoveChild(parent, index);
+    RebalanceInner(parent);
+  }
+
+  void MergeFrom(btree &other, bool unique_only) {
+    if (this == &other || other.size_ == 0) {
+      return;
+    }
+    btree rejected;
+    rejected.cmp_ = other.cmp_;
+    for (iterator it = other.Begin(); it != other.End(); ++it) {
+      iterator pos = Descend(KeyOf(*it), !unique_only);
+      if (unique_only && IsKeyAt(Normalize(pos), KeyOf(*it))) {
+        rejected.InsertAt(rejected.End(), std::move(*it));
+      } else {
+        InsertAt(pos, std::move(*it));
+      }
+    }
+    other.Swap(rejected);
+  }
+
+  // Builds the tree bottom-up from a sorted range into this empty tree.
+  template <typename ForwardIt>
+  void BuildSorted(ForwardIt first, ForwardIt last, bool unique_only) {
+    std::vector<Node *> level;
+    try {
+      Leaf *leaf = nullptr;
+      for (; first != last; ++first) {
+        if (unique_only && leaf != nullptr &&
+            !cmp_(KeyOf(leaf->Values()[leaf->count_ - 1]), KeyOf(*first))) {
+          continue;
+        }
+        if (leaf == nullptr || leaf->count_ == kLeafSlots) {
+          Leaf *next = new Leaf;
+          if (leaf == nullptr) {
+            first_ = last_ = next;
+          } else {
+            LinkAfter(leaf, next);
+          }
+          level.push_back(next);
+          leaf = next;
+        }
+        new (leaf->Values() + leaf->count_) value_type(*first);
+        ++leaf->count_;
+        ++size_;
+      }
+      if (leaf != nullptr && leaf->count_ < kMinLeafSlots &&
+          leaf->prev_ != nullptr) {
+        size_type moved = kMinLeafSlots - leaf->count_;
+        Leaf *previous = leaf->prev_;
+        MoveValues(leaf, 0, leaf->count_, leaf, moved);
+        MoveValues(previous, previous->count_ - moved, previous->count_, leaf,
+                   0);
+        previous->count_ -= moved;
+        leaf->count_ += moved;
+      }
+      while (level.size() > 1) {
+        level = BuildLevel(level);
+      }
+    } catch (...) {
+      DestroyLevels(level);
+      throw;
+    }
+    root_ = level.empty() ? nullptr : level.front();
+  }
+
+  // Groups the nodes of one level under new parents, spreading them evenly
+  // so that every parent has at least kMinInnerSlots keys.
+  std::vector<Node *> BuildLevel(std::vector<Node *> &children) {
+    size_type fanout = kInnerSlots + 1;
+    size_type groups = (children.size() + fanout - 1) / fanout;
+    std::vector<Node *> parents;
+    parents.reserve(groups);
+    size_type next = 0;
+    try {
+      for (size_type group = 0; group < groups; ++group) {
+        size_type count = (children.size() - next) / (groups - group);
+        Inner *parent = new Inner;
+        parents.push_back(parent);
+        parent->children_[0] = children[next];
+        children[next]->parent_ = parent;
+        for (size_type i = 1; i < count; ++i) {
+          Node *child = children[next + i];
+          new (parent->Keys() + i - 1) key_type(KeyOf(MinValue(child)));
+          parent->count_ = i;
+          parent->children_[i] = child;
+          child->parent_ = parent;
+        }
+        next += count;
+      }
+    } catch (...) {
+      for (Node *parent : parents) {
+        DestroyKeys(static_cast<Inner *>(parent));
+        delete static_cast<Inner *>(parent);
+      }
+      throw;
+    }
+    return parents;
+  }
+
+  // Frees a partially built tree: its leaves through the list and the inner
+  // nodes of the topmost finished level.
+  void DestroyLevels(const std::vector<Node *> &level) noexcept {
+    if (!level.empty() && !level.front()->leaf_) {
+      for (Node *node : level) {
+        Destroy(node);
+      }
+    } else {
+      for (Leaf *leaf = first_; leaf != nullptr;) {
+        Leaf *next = leaf->next_;
+        Destroy(leaf);
+        leaf = next;
+      }
+    }
+    root_ = nullptr;
+    first_ = last_ = nullptr;
+    size_ = 0;
+  }
+
+  static const value_type &MinValue(const Node *node) noexcept {
+    while (!node->leaf_) {
+      node = static_cast<const Inner *>(node)->children_[0];
+    }
+    return static_cast<const Leaf *>(node)->Values()[0];
+  }
+
+  static void Destroy(Node *node) noexcept {
+    if (node == nullptr) {
+      return;
+    }
+    if (node->leaf_) {
+      Leaf *leaf = static_cast<Leaf *>(node);
+      for (size_type i = 0; i < leaf->count_; ++i) {
+        leaf->Values()[i].~value_type();
+      }
+      delete leaf;
+    } else {
+      Inner *inner = static_cast<Inner *>(node);
+      DestroyKeys(inner);
+      for (size_type i = 0; i <= inner->count_; ++i) {
+        Destroy(inner->children_[i]);
+      }
+      delete inner;
+    }
+  }
+
+  static void DestroyKeys(Inner *inner) noexcept {
+    for (size_type i = 0; i < inner->count_; ++i) {
+      inner->Keys()[i].~key_type();
+    }
+  }
+
+  struct Node {
+    explicit Node(bool leaf) : leaf_(leaf) {}
+
+    Inner *parent_ = nullptr;
+    std::uint16_t count_ = 0;
+    bool leaf_;
+  };
+
+  struct Leaf : Node {
+    Leaf() : Node(true) {}
+
+    value_type *Values() noexcept {
+      return reinterpret_cast<value_type *>(values_);
+    }
+
+    const value_type *Values() const noexcept {
+      return reinterpret_cast<const value_type *>(values_);
+    }
+
+    Leaf *prev_ = nullptr;
+    Leaf *next_ = nullptr;
+    alignas(value_type) unsigned char values_[kLeafSlots * sizeof(value_type)];
+  };
+
+  struct Inner : Node {
+    Inner() : Node(false) {}
+
+    key_type *Keys() noexcept { return reinterpret_cast<key_type *>(keys_); }
+
+    const key_type *Keys() const noexcept {
+      return reinterpret_cast<const key_type *>(keys_);
+    }
+
+    alignas(key_type) unsigned char keys_[kInnerSlots * sizeof(key_type)];
+    Node *children_[kInnerSlots + 1];
+  };
+
+  struct Iterator {
+    using iterator_category = std::bidirectional_iterator_tag;
+    using difference_type = std::ptrdiff_t;
+    using value_type = btree::value_type;
+    using pointer = value_type *;
+    using reference = value_type &;
+
+    Iterator(Leaf *leaf, size_type index) : leaf_(leaf), index_(index) {}
+
+    reference operator*() const noexcept { return leaf_->Values()[index_]; }
+
+    pointer operator->() const noexcept { return leaf_->Values() + index_; }
+
+    iterator &operator++() noexcept {
+      if (++index_ == leaf_->count_ && leaf_->next_ != nullptr) {
+        leaf_ = leaf_->next_;
+        index_ = 0;
+      }
+      return *this;
+    }
+
+    iterator &operator--() noexcept {
+      if (index_ == 0) {
+        leaf_ = leaf_->prev_;
+        index_ = leaf_->count_;
+      }
+      --index_;
+      return *this;
+    }
+
+    bool operator==(const iterator &other) const noexcept {
+      return leaf_ == other.leaf_ && index_ == other.index_;
+    }
+
+    bool operator!=(const iterator &other) const noexcept {
+      return !(*this == other);
+    }
+
+    Leaf *leaf_;
+    size_type index_;
+  };
+
+  struct IteratorConst {
+    using iterator_category = std::bidirectional_iterator_tag;
+    using difference_type = std::ptrdiff_t;
+    using value_type = btree::value_type;
+    using pointer = const value_type *;
+    using reference = const value_type &;
+
+    IteratorConst(const Leaf *leaf, size_type index)
+        : leaf_(leaf), index_(index) {}
+
+    IteratorConst(const iterator &it) : leaf_(it.leaf_), index_(it.index_) {}
+
+    reference operator*() const noexcept { return leaf_->Values()[index_]; }
+
+    pointer operator->() const noexcept { return leaf_->Values() + index_; }
+
+    const_iterator &operator++() noexcept {
+      if (++index_ == leaf_->count_ && leaf_->next_ != nullptr) {
+        leaf_ = leaf_->next_;
+        index_ = 0;
+      }
+      return *this;
+    }
+
+    const_iterator &operator--() noexcept {
+      if (index_ == 0) {
+        leaf_ = leaf_->prev_;
+        index_ = leaf_->count_;
+      }
+      --index_;
+      return *this;
+    }
+
+    friend bool operator==(const const_iterator &it1,
+                           const const_iterator &it2) noexcept {
+      return it1.leaf_ == it2.leaf_ && it1.index_ == it2.index_;
+    }
+
+    friend bool operator!=(const const_iterator &it1,
+                           const const_iterator &it2) noexcept {
+      return !(it1 == it2);
+    }
+
+    const Leaf *leaf_;
+    size_type index_;
+  };
+
+  Node *root_ = nullptr;
+  Leaf *first_ = nullptr;
+  Leaf *last_ = nullptr;
+  size_type size_ = 0;
+  Comparison cmp_;
+};
+
+}  // namespace s21
+
+#endif  // CONTAINERS_S21_BTREE_H_
@@ -0,0 +1,174 @@
+#ifndef CONTAINERS_S21_BTREE_MAP_H_
+#define CONTAINERS_S21_BTREE_MAP_H_
+
+#include <stdexcept>
+
+#include <iterator>
+
+#include "s21_btree.h"
+
+namespace s21 {
+// Map on the B+-tree engine: same interface as s21::map, but insert and
+// erase invalidate iterators, and emplace constructs a single element.
+// Inner nodes store bare keys, so lookups never build a value_type.
+template <class Key, class Type, class Compare = std::less<Key>>
+class btree_map {
+ public:
+  using key_type = Key;
+  using mapped_type = Type;
+  using value_type = std::pair<const key_type, mapped_type>;
+  using key_compare = Compare;
+  using reference = value_type &;
+  using const_reference = const value_type &;
+  using tree_type =
+      btree<key_type, value_type, btree_select_first, key_compare>;
+  using iterator = typename tree_type::iterator;
+  using const_iterator = typename tree_type::const_iterator;
+  using reverse_iterator = std::reverse_iterator<iterator>;
+  using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+  using size_type = std::size_t;
+
+  btree_map() : tree_(new tree_type{}) {}
+
+  btree_map(std::initializer_list<value_type> const &items)
+      : btree_map(items.begin(), items.end()) {}
+
+  template <typename InputIt>
+  btree_map(InputIt first, InputIt last) : btree_map() {
+    for (; first != last; ++first) {
+      tree_->InsertUnique(*first);
+    }
+  }
+
+  btree_map(const btree_map &other) : tree_(new tree_type(*other.tree_)) {}
+
+  btree_map(btree_map &&other) noexcept
+      : tree_(new tree_type(std::move(*other.tree_))) {}
+
+  btree_map &operator=(const btree_map &other) {
+    *tree_ = *other.tree_;
+    return *this;
+  }
+
+  btree_map &operator=(btree_map &&other) noexcept {
+    *tree_ = std::move(*other.tree_);
+    return *this;
+  }
+
+  ~btree_map() {
+    delete tree_;
+    tree_ = nullptr;
+  }
+
+  mapped_type &at(const key_type &key) {
+    iterator it_search = tree_->Find(key);
+    if (it_search == end()) {
+      throw std::out_of_range("there is no such key");
+    }
+    return it_search->second;
+  }
+
+  const mapped_type &at(const key_type &key) const {
+    return const_cast<btree_map *>(this)->at(key);
+  }
+
+  mapped_type &operator[](const key_type &key) {
+    iterator it_search = tree_->Find(key);
+    if (it_search == end()) {
+      it_search = tree_->EmplaceUnique(key, mapped_type{}).first;
+    }
+    return it_search->second;
+  }
+
+  iterator begin() noexcept { return tree_->Begin(); }
+
+  const_iterator begin() const noexcept { return tree_->Begin(); }
+
+  iterator end() noexcept { return tree_->End(); }
+
+  const_iterator end() const noexcept { return tree_->End(); }
+
+  reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+
+  const_reverse_iterator rbegin() const noexcept {
+    return const_reverse_iterator(end());
+  }
+
+  reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+
+  const_reverse_iterator rend() const noexcept {
+    return const_reverse_iterator(begin());
+  }
+
+  bool empty() const noexcept { return tree_->Empty(); }
+
+  size_type size() const noexcept { return tree_->Size(); }
+
+  size_type max_size() const noexcept { return tree_->MaxSize(); }
+
+  void clear() noexcept { tree_->Clear(); }
+
+  // Replaces the content with an already sorted range in linear time.
+  template <typename ForwardIt>
+  void assign_sorted(ForwardIt first, ForwardIt last) {
+    tree_->AssignSortedUnique(first, last);
+  }
+
+  std::pair<iterator, bool> insert(const value_type &value) {
+    return tree_->InsertUnique(value);
+  }
+
+  std::pair<iterator, bool> insert(const key_type &key,
+                                   const mapped_type &obj) {
+    return tree_->EmplaceUnique(key, obj);
+  }
+
+  std::pair<iterator, bool> insert_or_assign(const key_type &key,
+                                             const mapped_type &obj) {
+    std::pair<iterator, bool> result = tree_->EmplaceUnique(key, obj);
+    if (!result.second) {
+      result.first->second = obj;
+    }
+    return result;
+  }
+
+  // Returns an iterator to the element that followed the erased one.
+  iterator erase(iterator pos) { return tree_->Erase(pos); }
+
+  void swap(btree_map &other) noexcept { tree_->Swap(*other.tree_); }
+
+  void merge(btree_map &other) { tree_->MergeUnique(*other.tree_); }
+
+  iterator find(const key_type &key) { return tree_->Find(key); }
+
+  const_iterator find(const key_type &key) const { return tree_->Find(key); }
+
+  bool contains(const key_type &key) const {
+    return tree_->Find(key) != tree_->End();
+  }
+
+  size_type count(const key_type &key) const { return tree_->Count(key); }
+
+  iterator lower_bound(const key_type &key) { return tree_->LowerBound(key); }
+
+  const_iterator lower_bound(const key_type &key) const {
+    return tree_->LowerBound(key);
+  }
+
+  iterator upper_bound(const key_type &key) { return tree_->UpperBound(key); }
+
+  const_iterator upper_bound(const key_type &key) const {
+    return tree_->UpperBound(key);
+  }
+
+  template <typename... Args>
+  std::pair<iterator, bool> emplace(Args &&...args) {
+    return tree_->EmplaceUnique(std::forward<Args>(args)...);
+  }
+
+ private:
+  tree_type *tree_;
+};
+}  // namespace s21
+
+#endif  // CONTAINERS_S21_BTREE_MAP_H_
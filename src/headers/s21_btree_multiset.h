@@ -0,0 +1,144 @@
+#ifndef CONTAINERS_S21_BTREE_MULTISET_H_
+#define CONTAINERS_S21_BTREE_MULTISET_H_
+
+#include <iterator>
+
+#include "s21_btree.h"
+
+namespace s21 {
+// Multiset on the B+-tree engine: same interface as s21::multiset, but
+// insert and erase invalidate iterators, and emplace constructs a single
+// element.
+template <class Key, class Compare = std::less<Key>>
+class btree_multiset {
+ public:
+  using key_type = Key;
+  using value_type = key_type;
+  using key_compare = Compare;
+  using reference = value_type &;
+  using const_reference = const value_type &;
+  using tree_type = btree<key_type, key_type, btree_identity, key_compare>;
+  using iterator = typename tree_type::iterator;
+  using const_iterator = typename tree_type::const_iterator;
+  using reverse_iterator = std::reverse_iterator<iterator>;
+  using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+  using size_type = std::size_t;
+
+  btree_multiset() : tree_(new tree_type{}) {}
+
+  btree_multiset(std::initializer_list<value_type> const &items)
+      : btree_multiset(items.begin(), items.end()) {}
+
+  template <typename InputIt>
+  btree_multiset(InputIt first, InputIt last) : btree_multiset() {
+    for (; first != last; ++first) {
+      tree_->Insert(*first);
+    }
+  }
+
+  btree_multiset(const btree_multiset &other)
+      : tree_(new tree_type(*other.tree_)) {}
+
+  btree_multiset(btree_multiset &&other) noexcept
+      : tree_(new tree_type(std::move(*other.tree_))) {}
+
+  btree_multiset &operator=(const btree_multiset &other) {
+    *tree_ = *other.tree_;
+    return *this;
+  }
+
+  btree_multiset &operator=(btree_multiset &&other) noexcept {
+    *tree_ = std::move(*other.tree_);
+    return *this;
+  }
+
+  ~btree_multiset() {
+    delete tree_;
+    tree_ = nullptr;
+  }
+
+  iterator begin() noexcept { return tree_->Begin(); }
+
+  const_iterator begin() const noexcept { return tree_->Begin(); }
+
+  iterator end() noexcept { return tree_->End(); }
+
+  const_iterator end() const noexcept { return tree_->End(); }
+
+  reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+
+  const_reverse_iterator rbegin() const noexcept {
+    return const_reverse_iterator(end());
+  }
+
+  reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+
+  const_reverse_iterator rend() const noexcept {
+    return const_reverse_iterator(begin());
+  }
+
+  bool empty() const noexcept { return tree_->Empty(); }
+
+  size_type size() const noexcept { return tree_->Size(); }
+
+  size_type max_size() const noexcept { return tree_->MaxSize(); }
+
+  void clear() noexcept { tree_->Clear(); }
+
+  // Replaces the content with an already sorted range in linear time.
+  template <typename ForwardIt>
+  void assign_sorted(ForwardIt first, ForwardIt last) {
+    tree_->AssignSorted(first, last);
+  }
+
+  iterator insert(const value_type &value) { return tree_->Insert(value); }
+
+  // Returns an iterator to the element that followed the erased one.
+  iterator erase(iterator pos) { return tree_->Erase(pos); }
+
+  void swap(btree_multiset &other) noexcept { tree_->Swap(*other.tree_); }
+
+  void merge(btree_multiset &other) { tree_->Merge(*other.tree_); }
+
+  size_type count(const key_type &key) const { return tree_->Count(key); }
+
+  iterator find(const key_type &key) { return tree_->Find(key); }
+
+  const_iterator find(const key_type &key) const { return tree_->Find(key); }
+
+  bool contains(const key_type &key) const {
+    return tree_->Find(key) != tree_->End();
+  }
+
+  std::pair<iterator, iterator> equal_range(const key_type &key) {
+    return {lower_bound(key), upper_bound(key)};
+  }
+
+  std::pair<const_iterator, const_iterator> equal_range(
+      const key_type &key) const {
+    return {lower_bound(key), upper_bound(key)};
+  }
+
+  iterator lower_bound(const key_type &key) { return tree_->LowerBound(key); }
+
+  const_iterator lower_bound(const key_type &key) const {
+    return tree_->LowerBound(key);
+  }
+
+  iterator upper_bound(const key_type &key) { return tree_->UpperBound(key); }
+
+  const_iterator upper_bound(const key_type &key) const {
+    return tree_->UpperBound(key);
+  }
+
+  template <typename... Args>
+  iterator emplace(Args &&...args) {
+    return tree_->Emplace(std::forward<Args>(args)...);
+  }
+
+ private:
+  tree_type *tree_;
+};
+}  // namespace s21
+
+#endif  // CONTAINERS_S21_BTREE_MULTISET_H_
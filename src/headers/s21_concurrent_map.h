@@ -0,0 +1,297 @@
+#ifndef CONTAINERS_S21_CONCURRENT_MAP_H_
+#define CONTAINERS_S21_CONCURRENT_MAP_H_
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <vector>
+
+#include "s21_map.h"
+
+namespace s21 {
+// Map for write-heavy workloads. Keys are hashed to Shards independent
+// s21::map shards, each behind its own mutex on its own cache line, so
+// threads working on different shards never contend. Batch calls take each
+// shard lock once. Sorted scans go through ordered(), which locks every
+// shard and merges them.
+template <class Key, class Type, std::size_t Shards = 16,
+          class Hash = std::hash<Key>, class Compare = std::less<Key>>
+class concurrent_map {
+  static_assert(Shards > 0, "concurrent_map needs at least one shard");
+
+ private:
+  struct Shard;
+
+ public:
+  using key_type = Key;
+  using mapped_type = Type;
+  using value_type = std::pair<const key_type, mapped_type>;
+  using key_compare = Compare;
+  using hasher = Hash;
+  using shard_type = map<key_type, mapped_type, key_compare>;
+  using size_type = std::size_t;
+
+  class ordered_view;
+
+  concurrent_map() = default;
+
+  concurrent_map(std::initializer_list<value_type> const &items) {
+    insert_many(items.begin(), items.end());
+  }
+
+  concurrent_map(const concurrent_map &) = delete;
+
+  concurrent_map &operator=(const concurrent_map &) = delete;
+
+  static constexpr size_type shard_count() noexcept { return Shards; }
+
+  bool insert(const key_type &key, const mapped_type &obj) {
+    Shard &shard = ShardOf(key);
+    std::lock_guard<std::mutex> lock(shard.mutex_);
+    return shard.map_.insert(key, obj).second;
+  }
+
+  void insert_or_assign(const key_type &key, const mapped_type &obj) {
+    Shard &shard = ShardOf(key);
+    std::lock_guard<std::mutex> lock(shard.mutex_);
+    shard.map_.insert_or_assign(key, obj);
+  }
+
+  size_type erase(const key_type &key) {
+    Shard &shard = ShardOf(key);
+    std::lock_guard<std::mutex> lock(shard.mutex_);
+    auto it = shard.map_.find(key);
+    if (it == shard.map_.end()) {
+      return 0;
+    }
+    shard.map_.erase(it);
+    return 1;
+  }
+
+  bool contains(const key_type &key) const {
+    const Shard &shard = ShardOf(key);
+    std::lock_guard<std::mutex> lock(shard.mutex_);
+    return shard.map_.contains(key);
+  }
+
+  // Returns a copy: the element may change as soon as the lock is released.
+  mapped_type at(const key_type &key) const {
+    const Shard &shard = ShardOf(key);
+    std::lock_guard<std::mutex> lock(shard.mutex_);
+    return shard.map_.at(key);
+  }
+
+  std::optional<mapped_type> find(const key_type &key) const {
+    const Shard &shard = ShardOf(key);
+    std::lock_guard<std::mutex> lock(shard.mutex_);
+    auto it = shard.map_.find(key);
+    if (it == shard.map_.end()) {
+      return std::nullopt;
+    }
+    return (*it).second;
+  }
+
+  // Sums the shards one at a time, so concurrent writers may make the
+  // result stale.
+  size_type size() const {
+    size_type size = 0;
+    for (const Shard &shard : shards_) {
+      std::lock_guard<std::mutex> lock(shard.mutex_);
+      size += shard.map_.size();
+    }
+    return size;
+  }
+
+  bool empty() const { return size() == 0; }
+
+  void clear() {
+    for (Shard &shard : shards_) {
+      std::lock_guard<std::mutex> lock(shard.mutex_);
+      shard.map_.clear();
+    }
+  }
+
+  // Inserts a range of value_type, locking every shard once. Returns how
+  // many elements were inserted.
+  template <typename InputIt>
+  size_type insert_many(InputIt first, InputIt last) {
+    std::array<std::vector<value_type>, Shards> batches;
+    for (; first != last; ++first) {
+      batches[ShardIndex((*first).first)].push_back(*first);
+    }
+    size_type inserted = 0;
+    for (size_type index = 0; index < Shards; ++index) {
+      if (batches[index].empty()) {
+        continue;
+      }
+      Shard &shard = shards_[index];
+      std::lock_guard<std::mutex> lock(shard.mutex_);
+      for (const value_type &item : batches[index]) {
+        inserted += shard.map_.insert(item).second ? 1 : 0;
+      }
+    }
+    return inserted;
+  }
+
+  // Erases a range of keys, locking every shard once. Returns how many
+  // elements were erased.
+  template <typename InputIt>
+  size_type erase_many(InputIt first, InputIt last) {
+    std::array<std::vector<key_type>, Shards> batches;
+    for (; first != last; ++first) {
+      batches[ShardIndex(*first)].push_back(*first);
+    }
+    size_type erased = 0;
+    for (size_type index = 0; index < Shards; ++index) {
+      if (batches[index].empty()) {
+        continue;
+      }
+      Shard &shard = shards_[index];
+      std::lock_guard<std::mutex> lock(shard.mutex_);
+      for (const key_type &key : batches[index]) {
+        auto it = shard.map_.find(key);
+        if (it != shard.map_.end()) {
+          shard.map_.erase(it);
+          ++erased;
+        }
+      }
+    }
+    return erased;
+  }
+
+  // Locks all shards for a consistent sorted scan; writers block until the
+  // view is destroyed.
+  ordered_view ordered() const { return ordered_view(*this); }
+
+  // Elements of all shards in key order, merged on the fly.
+  class ordered_view {
+   public:
+    class iterator {
+     public:
+      using iterator_category = std::forward_iterator_tag;
+      using difference_type = std::ptrdiff_t;
+      using value_type = concurrent_map::value_type;
+      using pointer = const value_type *;
+      using reference = const value_type &;
+
+      reference operator*() const noexcept { return *heap_.front().first; }
+
+      pointer operator->() const noexcept { return &**this; }
+
+      iterator &operator++() {
+        std::pop_heap(heap_.begin(), heap_.end(), Later{compare_});
+        Cursor &cursor = heap_.back();
+        if (++cursor.first == cursor.second) {
+          heap_.pop_back();
+        } else {
+          std::push_heap(heap_.begin(), heap_.end(), Later{compare_});
+        }
+        return *this;
+      }
+
+      iterator operator++(int) {
+        iterator previous = *this;
+        ++*this;
+        return previous;
+      }
+
+      bool operator==(const iterator &other) const noexcept {
+        return heap_.empty() ? other.heap_.empty()
+                             : !other.heap_.empty() &&
+                                   &**this == &*other;
+      }
+
+      bool operator!=(const iterator &other) const noexcept {
+        return !(*this == other);
+      }
+
+     private:
+      friend class ordered_view;
+
+      using shard_iterator = typename shard_type::const_iterator;
+      using Cursor = std::pair<shard_iterator, shard_iterator>;
+
+      // Orders the heap so that the cursor on the smallest key is on top.
+      struct Later {
+        bool operator()(const Cursor &left, const Cursor &right) const {
+          return compare_((*right.first).first, (*left.first).first);
+        }
+
+        key_compare compare_;
+      };
+
+      iterator() = default;
+
+      explicit iterator(const std::array<Shard, Shards> &shards) {
+        heap_.reserve(Shards);
+        for (const Shard &shard : shards) {
+          if (!shard.map_.empty()) {
+            heap_.emplace_back(shard.map_.begin(), shard.map_.end());
+          }
+        }
+        std::make_heap(heap_.begin(), heap_.end(), Later{compare_});
+      }
+
+      std::vector<Cursor> heap_;
+      key_compare compare_;
+    };
+
+    using const_iterator = iterator;
+
+    ordered_view(const ordered_view &) = delete;
+
+    ordered_view &operator=(const ordered_view &) = delete;
+
+    ~ordered_view() {
+      for (const Shard &shard : map_.shards_) {
+        shard.mutex_.unlock();
+      }
+    }
+
+    iterator begin() const { return iterator(map_.shards_); }
+
+    iterator end() const noexcept { return iterator(); }
+
+   private:
+    friend class concurrent_map;
+
+    // Locks in shard order, the only order in which two shard locks are
+    // ever held together.
+    explicit ordered_view(const concurrent_map &map) : map_(map) {
+      for (const Shard &shard : map_.shards_) {
+        shard.mutex_.lock();
+      }
+    }
+
+    const concurrent_map &map_;
+  };
+
+ private:
+  static constexpr size_type kCacheLine = 64;
+
+  struct alignas(kCacheLine) Shard {
+    mutable std::mutex mutex_;
+    shard_type map_;
+  };
+
+  static size_type ShardIndex(const key_type &key) {
+    return hasher()(key) % Shards;
+  }
+
+  Shard &ShardOf(const key_type &key) { return shards_[ShardIndex(key)]; }
+
+  const Shard &ShardOf(const key_type &key) const {
+    return shards_[ShardIndex(key)];
+  }
+
+  std::array<Shard, Shards> shards_;
+};
+
+}  // namespace s21
+
+#endif  // CONTAINERS_S21_CONCURRENT_MAP_H_
@@ -0,0 +1,200 @@
+#ifndef CONTAINERS_S21_EPOCH_H_
+#define CONTAINERS_S21_EPOCH_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <mutex>
+#include <vector>
+
+namespace s21 {
+// Epoch-based reclamation for structures whose readers take no lock. A
+// reader pins the current epoch for as long as it follows pointers into the
+// structure. A writer unlinks an object and retires it. The object is freed
+// only after every reader that was pinned when it was retired has unpinned.
+//
+// Each thread announces its epoch in a slot of its own, padded to a cache
+// line, so pinning touches no shared line except for reading the global
+// epoch. The process shares one domain, as thread-local slot lookup needs
+// the domain to outlive every thread that uses it.
+class epoch_domain {
+ private:
+  struct Slot;
+
+ public:
+  using epoch_type = std::uint64_t;
+
+  // Keeps the calling thread pinned while alive. Guards nest.
+  class guard {
+   public:
+    explicit guard(epoch_domain &domain) : slot_(domain.Enter()) {}
+
+    guard(const guard &) = delete;
+
+    guard &operator=(const guard &) = delete;
+
+    ~guard() { epoch_domain::Leave(slot_); }
+
+   private:
+    Slot *slot_;
+  };
+
+  epoch_domain(const epoch_domain &) = delete;
+
+  epoch_domain &operator=(const epoch_domain &) = delete;
+
+  // Frees everything still retired: no reader survives the domain.
+  ~epoch_domain() {
+    for (const Retired &retired : retired_) {
+      retired.deleter_(retired.object_);
+    }
+    for (Slot *slot = slots_.load(); slot != nullptr;) {
+      Slot *next = slot->next_;
+      delete slot;
+      slot = next;
+    }
+  }
+
+  static epoch_domain &Shared() {
+    static epoch_domain domain;
+    return domain;
+  }
+
+  guard Pin() { return guard(*this); }
+
+  // Hands over an object that readers can no longer reach but may still be
+  // reading. Deleter frees it once that is no longer possible.
+  void Retire(void *object, void (*deleter)(void *)) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    retired_.push_back(Retired{object, deleter, epoch_.fetch_add(1)});
+    if (retired_.size() >= kReclaimBatch) {
+      ReclaimLocked();
+    }
+  }
+
+  template <typename T>
+  void Retire(T *object) {
+    Retire(object, [](void *pointer) { delete static_cast<T *>(pointer); });
+  }
+
+  // Frees the retired objects no pinned reader can still see.
+  void Reclaim() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    ReclaimLocked();
+  }
+
+  std::size_t RetiredCount() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return retired_.size();
+  }
+
+ private:
+  static constexpr std::size_t kReclaimBatch = 64;
+  static constexpr std::size_t kCacheLine = 64;
+
+  // epoch_ is 0 while the owner is not pinned. depth_ is only touched by the
+  // owning thread.
+  struct alignas(kCacheLine) Slot {
+    std::atomic<epoch_type> epoch_{0};
+    std::atomic<bool> claimed_{true};
+    std::size_t depth_ = 0;
+    Slot *next_ = nullptr;
+  };
+
+  struct Retired {
+    void *object_;
+    void (*deleter_)(void *);
+    epoch_type epoch_;
+  };
+
+  // Gives the slot of a finished thread back to the domain.
+  struct SlotOwner {
+    ~SlotOwner() {
+      if (slot_ != nullptr) {
+        slot_->claimed_.store(false, std::memory_order_release);
+      }
+    }
+
+    Slot *slot_ = nullptr;
+  };
+
+  epoch_domain() = default;
+
+  Slot *Enter() {
+    Slot *slot = ThisSlot();
+    if (slot->depth_++ == 0) {
+      // Announce an epoch and check it is still current: a writer that
+      // retires after this point must see the announcement.
+      epoch_type epoch = epoch_.load();
+      while (true) {
+        slot->epoch_.store(epoch);
+        epoch_type current = epoch_.load();
+        if (current == epoch) {
+          break;
+        }
+        epoch = current;
+      }
+    }
+    return slot;
+  }
+
+  static void Leave(Slot *slot) noexcept {
+    if (--slot->depth_ == 0) {
+      slot->epoch_.store(0, std::memory_order_release);
+    }
+  }
+
+  Slot *ThisSlot() {
+    static thread_local SlotOwner owner;
+    if (owner.slot_ == nullptr) {
+      owner.slot_ = ClaimSlot();
+    }
+    return owner.slot_;
+  }
+
+  Slot *ClaimSlot() {
+    for (Slot *slot = slots_.load(std::memory_order_acquire); slot != nullptr;
+         slot = slot->next_) {
+      bool claimed = false;
+      if (slot->claimed_.compare_exchange_strong(claimed, true)) {
+        return slot;
+      }
+    }
+    Slot *slot = new Slot;
+    slot->next_ = slots_.load(std::memory_order_relaxed);
+    while (!slots_.compare_exchange_weak(slot->next_, slot)) {
+    }
+    return slot;
+  }
+
+  // An object retired at epoch e may be in use by readers pinned at e or
+  // earlier; the epoch advances on every retirement.
+  void ReclaimLocked() {
+    epoch_type oldest = std::numeric_limits<epoch_type>::max();
+    for (Slot *slot = slots_.load(); slot != nullptr; slot = slot->next_) {
+      epoch_type epoch = slot->epoch_.load();
+      if (epoch != 0 && epoch < oldest) {
+        oldest = epoch;
+      }
+    }
+    std::size_t kept = 0;
+    for (const Retired &retired : retired_) {
+      if (retired.epoch_ < oldest) {
+        retired.deleter_(retired.object_);
+      } else {
+        retired_[kept++] = retired;
+      }
+    }
+    retired_.resize(kept);
+  }
+
+  std::atomic<epoch_type> epoch_{1};
+  std::atomic<Slot *> slots_{nullptr};
+  std::mutex mutex_;
+  std::vector<Retired> retired_;
+};
+
+}  // namespace s21
+
+#endif  // CONTAINERS_S21_EPOCH_H_
@@ -0,0 +1,89 @@
+#ifndef CONTAINERS_S21_FROZEN_IMAGE_H_
+#define CONTAINERS_S21_FROZEN_IMAGE_H_
+
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "s21_frozen_tree.h"
+#include "s21_mapped_file.h"
+
+namespace s21 {
+// Memory-mapped images of frozen_tree, behind save() and open_mapped() of
+// set, map, frozen_set and frozen_map. Kept apart from the containers as it
+// needs POSIX; include it where images are written or opened.
+
+template <typename Key, typename Value, typename KeyOfValue,
+          typename Comparison>
+template <typename InputIt>
+void frozen_tree<Key, Value, KeyOfValue, Comparison>::Save(
+    const std::string &path, InputIt first, size_type count) {
+  std::vector<const value_type *> slots(count + 1, nullptr);
+  if (count > 0) {
+    for (size_type index = Leftmost(1, count); index != 0;
+         index = Next(index, count), ++first) {
+      slots[index] = &*first;
+    }
+  }
+  WriteImage(path, count, [&slots](size_type index) { return slots[index]; });
+}
+
+template <typename Key, typename Value, typename KeyOfValue,
+          typename Comparison>
+void frozen_tree<Key, Value, KeyOfValue, Comparison>::Save(
+    const std::string &path) const {
+  WriteImage(path, size_, [this](size_type index) { return &slots_[index]; });
+}
+
+template <typename Key, typename Value, typename KeyOfValue,
+          typename Comparison>
+frozen_tree<Key, Value, KeyOfValue, Comparison>
+frozen_tree<Key, Value, KeyOfValue, Comparison>::Open(
+    const std::string &path) {
+  mapped_file file(path);
+  ImageHeader header;
+  if (file.Size() < sizeof(header)) {
+    throw std::runtime_error("not a frozen image: " + path);
+  }
+  std::memcpy(&header, file.Data(), sizeof(header));
+  ImageHeader expected = MakeHeader(header.count);
+  size_type bytes = file.Size() - sizeof(header);
+  if (std::memcmp(&header, &expected, sizeof(header)) != 0 ||
+      bytes % sizeof(value_type) != 0 || bytes / sizeof(value_type) == 0 ||
+      bytes / sizeof(value_type) - 1 != header.count) {
+    throw std::runtime_error("not a frozen image of this type: " + path);
+  }
+  frozen_tree tree;
+  tree.slots_ = reinterpret_cast<value_type *>(const_cast<unsigned char *>(
+      static_cast<const unsigned char *>(file.Data()) + sizeof(header)));
+  tree.size_ = static_cast<size_type>(header.count);
+  tree.image_ = std::make_shared<mapped_file>(std::move(file));
+  return tree;
+}
+
+template <typename Key, typename Value, typename KeyOfValue,
+          typename Comparison>
+template <typename Slot>
+void frozen_tree<Key, Value, KeyOfValue, Comparison>::WriteImage(
+    const std::string &path, size_type count, Slot slot) {
+  static_assert(std::is_trivially_copy_constructible_v<value_type> &&
+                    std::is_trivially_destructible_v<value_type>,
+                "only trivially copyable elements can be saved");
+  mapped_file::Write(path, [count, &slot](auto write) {
+    ImageHeader header = MakeHeader(count);
+    write(&header, sizeof(header));
+    unsigned char empty[sizeof(value_type)] = {};
+    write(empty, sizeof(empty));
+    for (size_type index = 1; index <= count; ++index) {
+      write(slot(index), sizeof(value_type));
+    }
+  });
+}
+
+}  // namespace s21
+
+#endif  // CONTAINERS_S21_FROZEN_IMAGE_H_
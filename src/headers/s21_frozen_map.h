@@ -0,0 +1,115 @@
+#ifndef CONTAINERS_S21_FROZEN_MAP_H_
+#define CONTAINERS_S21_FROZEN_MAP_H_
+
+#include <stdexcept>
+#include <string>
+
+#include "s21_frozen_tree.h"
+
+namespace s21 {
+// Read-only map for lookup-heavy phases, usually made by map::freeze(); see
+// frozen_set. Keys and values are stored together, so small mapped types
+// keep the most keys per cache line.
+template <class Key, class Type, class Compare = std::less<Key>>
+class frozen_map {
+ public:
+  using key_type = Key;
+  using mapped_type = Type;
+  using value_type = std::pair<const key_type, mapped_type>;
+  using key_compare = Compare;
+  using reference = value_type &;
+  using const_reference = const value_type &;
+
+ private:
+  struct KeyOfValue {
+    const Key &operator()(const value_type &value) const noexcept {
+      return value.first;
+    }
+  };
+
+ public:
+  using tree_type = frozen_tree<key_type, value_type, KeyOfValue, Compare>;
+  using iterator = typename tree_type::const_iterator;
+  using const_iterator = typename tree_type::const_iterator;
+  using size_type = std::size_t;
+
+  frozen_map() : tree_(new tree_type{}) {}
+
+  // Takes count elements from a range sorted by key with no duplicates.
+  template <typename InputIt>
+  frozen_map(InputIt first, size_type count)
+      : tree_(new tree_type(first, count)) {}
+
+  frozen_map(const frozen_map &other) : tree_(new tree_type(*other.tree_)) {}
+
+  frozen_map(frozen_map &&other) noexcept
+      : tree_(new tree_type(std::move(*other.tree_))) {}
+
+  frozen_map &operator=(const frozen_map &other) {
+    *tree_ = *other.tree_;
+    return *this;
+  }
+
+  frozen_map &operator=(frozen_map &&other) noexcept {
+    *tree_ = std::move(*other.tree_);
+    return *this;
+  }
+
+  ~frozen_map() {
+    delete tree_;
+    tree_ = nullptr;
+  }
+
+  const mapped_type &at(const key_type &key) const {
+    const_iterator it = tree_->Find(key);
+    if (it == tree_->End()) {
+      throw std::out_of_range("there is no such key");
+    }
+    return (*it).second;
+  }
+
+  const_iterator begin() const noexcept { return tree_->Begin(); }
+
+  const_iterator end() const noexcept { return tree_->End(); }
+
+  bool empty() const noexcept { return tree_->Empty(); }
+
+  size_type size() const noexcept { return tree_->Size(); }
+
+  void swap(frozen_map &other) noexcept { tree_->Swap(*other.tree_); }
+
+  const_iterator find(const key_type &key) const { return tree_->Find(key); }
+
+  bool contains(const key_type &key) const {
+    return tree_->Find(key) != tree_->End();
+  }
+
+  size_type count(const key_type &key) const { return contains(key) ? 1 : 0; }
+
+  const_iterator lower_bound(const key_type &key) const {
+    return tree_->LowerBound(key);
+  }
+
+  const_iterator upper_bound(const key_type &key) const {
+    return tree_->UpperBound(key);
+  }
+
+  // Writes an image of the map that open_mapped() maps back; see
+  // frozen_tree::Save. Both need s21_frozen_image.h.
+  void save(const std::string &path) const { tree_->Save(path); }
+
+  // Serves lookups straight from an image written by save(), with no
+  // loading step; see frozen_tree::Open.
+  static frozen_map open_mapped(const std::string &path) {
+    return frozen_map(tree_type::Open(path));
+  }
+
+ private:
+  explicit frozen_map(tree_type &&tree)
+      : tree_(new tree_type(std::move(tree))) {}
+
+  tree_type *tree_;
+};
+}  // namespace s21
+
+#endif  // CONTAINERS_S21_FROZEN_MAP_H_
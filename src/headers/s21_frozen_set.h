@@ -0,0 +1,101 @@
+#ifndef CONTAINERS_S21_FROZEN_SET_H_
+#define CONTAINERS_S21_FROZEN_SET_H_
+
+#include <string>
+
+#include "s21_frozen_tree.h"
+
+namespace s21 {
+// Read-only set for lookup-heavy phases, usually made by set::freeze(). The
+// keys sit in one contiguous buffer in Eytzinger order, so a lookup loads a
+// cache line per several tree levels instead of a node per level.
+template <class Key, class Compare = std::less<Key>>
+class frozen_set {
+ private:
+  struct KeyOfValue {
+    const Key &operator()(const Key &value) const noexcept { return value; }
+  };
+
+ public:
+  using key_type = Key;
+  using value_type = key_type;
+  using key_compare = Compare;
+  using reference = value_type &;
+  using const_reference = const value_type &;
+  using tree_type = frozen_tree<key_type, value_type, KeyOfValue, Compare>;
+  using iterator = typename tree_type::const_iterator;
+  using const_iterator = typename tree_type::const_iterator;
+  using size_type = std::size_t;
+
+  frozen_set() : tree_(new tree_type{}) {}
+
+  // Takes count keys from a range that is sorted and has no duplicates.
+  template <typename InputIt>
+  frozen_set(InputIt first, size_type count)
+      : tree_(new tree_type(first, count)) {}
+
+  frozen_set(const frozen_set &other) : tree_(new tree_type(*other.tree_)) {}
+
+  frozen_set(frozen_set &&other) noexcept
+      : tree_(new tree_type(std::move(*other.tree_))) {}
+
+  frozen_set &operator=(const frozen_set &other) {
+    *tree_ = *other.tree_;
+    return *this;
+  }
+
+  frozen_set &operator=(frozen_set &&other) noexcept {
+    *tree_ = std::move(*other.tree_);
+    return *this;
+  }
+
+  ~frozen_set() {
+    delete tree_;
+    tree_ = nullptr;
+  }
+
+  const_iterator begin() const noexcept { return tree_->Begin(); }
+
+  const_iterator end() const noexcept { return tree_->End(); }
+
+  bool empty() const noexcept { return tree_->Empty(); }
+
+  size_type size() const noexcept { return tree_->Size(); }
+
+  void swap(frozen_set &other) noexcept { tree_->Swap(*other.tree_); }
+
+  const_iterator find(const key_type &key) const { return tree_->Find(key); }
+
+  bool contains(const key_type &key) const {
+    return tree_->Find(key) != tree_->End();
+  }
+
+  size_type count(const key_type &key) const { return contains(key) ? 1 : 0; }
+
+  const_iterator lower_bound(const key_type &key) const {
+    return tree_->LowerBound(key);
+  }
+
+  const_iterator upper_bound(const key_type &key) const {
+    return tree_->UpperBound(key);
+  }
+
+  // Writes an image of the set that open_mapped() maps back; see
+  // frozen_tree::Save. Both need s21_frozen_image.h.
+  void save(const std::string &path) const { tree_->Save(path); }
+
+  // Serves lookups straight from an image written by save(), with no
+  // loading step; see frozen_tree::Open.
+  static frozen_set open_mapped(const std::string &path) {
+    return frozen_set(tree_type::Open(path));
+  }
+
+ private:
+  explicit frozen_set(tree_type &&tree)
+      : tree_(new tree_type(std::move(tree))) {}
+
+  tree_type *tree_;
+};
+}  // namespace s21
+
+#endif  // CONTAINERS_S21_FROZEN_SET_H_
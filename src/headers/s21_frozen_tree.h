@@ -0,0 +1,339 @@
+#ifndef CONTAINERS_S21_FROZEN_TREE_H_
+#define CONTAINERS_S21_FROZEN_TREE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace s21 {
+// Immutable engine of frozen_set and frozen_map: the elements of a sorted
+// range laid out in Eytzinger order, the breadth-first order of a complete
+// binary search tree, in one cache-line aligned buffer. Slot 1 is the root
+// and the children of slot k are 2k and 2k + 1, so a search is a chain of
+// index computations with no pointers to chase. The descent is branchless,
+// and the 2^kPrefetchLevels descendants kPrefetchLevels levels below the
+// current slot share one cache line, which is prefetched ahead of use.
+//
+// The buffer is also the on-disk image: Save writes a header and the slots
+// as they lie in memory, and Open maps the file and uses them in place.
+// Both are defined in s21_frozen_image.h, which needs POSIX.
+template <typename Key, typename Value, typename KeyOfValue,
+          typename Comparison = std::less<Key>>
+class frozen_tree {
+ public:
+  class Iterator;
+
+  using key_type = Key;
+  using value_type = Value;
+  using const_reference = const value_type &;
+  using const_iterator = Iterator;
+  using size_type = std::size_t;
+
+  frozen_tree() = default;
+
+  // Takes count elements from a range sorted by key with no duplicates.
+  template <typename InputIt>
+  frozen_tree(InputIt first, size_type count) {
+    std::vector<const value_type *> sorted;
+    sorted.reserve(count);
+    for (size_type index = 0; index < count; ++index, ++first) {
+      sorted.push_back(&*first);
+    }
+    Build(sorted);
+  }
+
+  frozen_tree(const frozen_tree &other) : cmp_(other.cmp_) {
+    std::vector<const value_type *> sorted;
+    sorted.reserve(other.size_);
+    for (const_iterator it = other.Begin(); it != other.End(); ++it) {
+      sorted.push_back(&*it);
+    }
+    Build(sorted);
+  }
+
+  frozen_tree(frozen_tree &&other) noexcept { Swap(other); }
+
+  frozen_tree &operator=(const frozen_tree &other) {
+    if (this != &other) {
+      frozen_tree copy(other);
+      Swap(copy);
+    }
+    return *this;
+  }
+
+  frozen_tree &operator=(frozen_tree &&other) noexcept {
+    if (this != &other) {
+      frozen_tree moved(std::move(other));
+      Swap(moved);
+    }
+    return *this;
+  }
+
+  ~frozen_tree() {
+    if (image_ != nullptr) {
+      return;
+    }
+    for (size_type index = 1; index <= size_; ++index) {
+      slots_[index].~value_type();
+    }
+    if (slots_ != nullptr) {
+      ::operator delete(slots_, std::align_val_t(kCacheLine));
+    }
+  }
+
+  // Writes an image of count elements of a range sorted by key with no
+  // duplicates to path, replacing the file atomically. The elements must be
+  // trivially copyable, and the image can only be opened on machines with
+  // the same byte order and type layout. Defined in s21_frozen_image.h.
+  template <typename InputIt>
+  static void Save(const std::string &path, InputIt first, size_type count);
+
+  void Save(const std::string &path) const;
+
+  // Maps an image written by Save in O(1); lookups load its pages on first
+  // touch. The image must have been saved with the same Comparison. Throws
+  // std::system_error if the file cannot be mapped and std::runtime_error
+  // if it is not an image of this element type. Defined in
+  // s21_frozen_image.h.
+  static frozen_tree Open(const std::string &path);
+
+  size_type Size() const noexcept { return size_; }
+
+  bool Empty() const noexcept { return size_ == 0; }
+
+  const_iterator Begin() const noexcept {
+    return Iterator(this, size_ > 0 ? Leftmost(1, size_) : 0);
+  }
+
+  const_iterator End() const noexcept { return Iterator(this, 0); }
+
+  // First element whose key is not less than key.
+  const_iterator LowerBound(const key_type &key) const noexcept {
+    size_type index = 1;
+    while (index <= size_) {
+      Prefetch(index);
+      index = 2 * index + (cmp_(KeyOf(index), key) ? 1 : 0);
+    }
+    return Iterator(this, Resolve(index));
+  }
+
+  // First element whose key is greater than key.
+  const_iterator UpperBound(const key_type &key) const noexcept {
+    size_type index = 1;
+    while (index <= size_) {
+      Prefetch(index);
+      index = 2 * index + (cmp_(key, KeyOf(index)) ? 0 : 1);
+    }
+    return Iterator(this, Resolve(index));
+  }
+
+  const_iterator Find(const key_type &key) const noexcept {
+    const_iterator it = LowerBound(key);
+    if (it.index_ != 0 && cmp_(key, KeyOf(it.index_))) {
+      return End();
+    }
+    return it;
+  }
+
+  void Swap(frozen_tree &other) noexcept {
+    std::swap(slots_, other.slots_);
+    std::swap(size_, other.size_);
+    std::swap(cmp_, other.cmp_);
+    image_.swap(other.image_);
+  }
+
+  // In-order iterator; an index of 0 is the end.
+  class Iterator {
+   public:
+    using iterator_category = std::forward_iterator_tag;
+    using difference_type = std::ptrdiff_t;
+    using value_type = frozen_tree::value_type;
+    using pointer = const value_type *;
+    using reference = const value_type &;
+
+    Iterator() = default;
+
+    reference operator*() const noexcept { return tree_->slots_[index_]; }
+
+    pointer operator->() const noexcept { return &tree_->slots_[index_]; }
+
+    Iterator &operator++() noexcept {
+      index_ = Next(index_, tree_->size_);
+      return *this;
+    }
+
+    Iterator operator++(int) noexcept {
+      Iterator previous = *this;
+      ++*this;
+      return previous;
+    }
+
+    bool operator==(const Iterator &other) const noexcept {
+      return index_ == other.index_;
+    }
+
+    bool operator!=(const Iterator &other) const noexcept {
+      return index_ != other.index_;
+    }
+
+   private:
+    friend class frozen_tree;
+
+    Iterator(const frozen_tree *tree, size_type index) noexcept
+        : tree_(tree), index_(index) {}
+
+    const frozen_tree *tree_ = nullptr;
+    size_type index_ = 0;
+  };
+
+ private:
+  static constexpr size_type kCacheLine = 64;
+
+  // Levels to look ahead: the deepest level whose descendants of one slot
+  // still fit in a cache line.
+  static constexpr size_type PrefetchLevels() noexcept {
+    size_type levels = 1;
+    while ((sizeof(value_type) << (levels + 1)) <= kCacheLine) {
+      ++levels;
+    }
+    return levels;
+  }
+
+  static constexpr size_type kPrefetchLevels = PrefetchLevels();
+
+  static constexpr std::uint32_t kImageVersion = 1;
+
+  // Starts an image and fills one cache line, so the slots that follow are
+  // as aligned as in memory. Slot 0 is stored too, zeroed.
+  struct ImageHeader {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t byte_order;
+    std::uint64_t key_size;
+    std::uint64_t value_size;
+    std::uint64_t value_align;
+    std::uint64_t count;
+    unsigned char reserved[16];
+  };
+
+  static_assert(sizeof(ImageHeader) == kCacheLine);
+
+  static ImageHeader MakeHeader(std::uint64_t count) noexcept {
+    ImageHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, "S21FROZ", 8);
+    header.version = kImageVersion;
+    header.byte_order = 0x01020304;
+    header.key_size = sizeof(key_type);
+    header.value_size = sizeof(value_type);
+    header.value_align = alignof(value_type);
+    header.count = count;
+    return header;
+  }
+
+  // Writes the header and slots 0 to count; slot(index) gives the element
+  // of each slot from 1 on.
+  template <typename Slot>
+  static void WriteImage(const std::string &path, size_type count,
+                         Slot slot);
+
+  const key_type &KeyOf(size_type index) const noexcept {
+    return KeyOfValue()(slots_[index]);
+  }
+
+  // The address may lie past the buffer; prefetching it is harmless.
+  void Prefetch(size_type index) const noexcept {
+#if defined(__GNUC__)
+    std::uintptr_t address = reinterpret_cast<std::uintptr_t>(slots_) +
+                             (index << kPrefetchLevels) * sizeof(value_type);
+    __builtin_prefetch(reinterpret_cast<const void *>(address));
+#else
+    (void)index;
+#endif
+  }
+
+  // A descent that fell off the tree at index turned right once per
+  // trailing one bit since its last left turn. Dropping those turns and the
+  // left one gives the slot where it last turned left, which holds the
+  // answer; 0 means it never did and there is no answer.
+  static size_type Resolve(size_type index) noexcept {
+    return index >> (TrailingOnes(index) + 1);
+  }
+
+  static size_type TrailingOnes(size_type index) noexcept {
+#if defined(__GNUC__)
+    return static_cast<size_type>(__builtin_ctzll(~index));
+#else
+    size_type ones = 0;
+    for (; (index & 1) != 0; index >>= 1) {
+      ++ones;
+    }
+    return ones;
+#endif
+  }
+
+  // Fills slots in Eytzinger order: an in-order walk of the implicit tree
+  // visits the slots in key order.
+  void Build(const std::vector<const value_type *> &sorted) {
+    size_type count = sorted.size();
+    if (count == 0) {
+      return;
+    }
+    slots_ = static_cast<value_type *>(::operator new(
+        (count + 1) * sizeof(value_type), std::align_val_t(kCacheLine)));
+    size_type next = 0;
+    try {
+      for (size_type index = Leftmost(1, count); index != 0;
+           index = Next(index, count)) {
+        new (&slots_[index]) value_type(*sorted[next]);
+        ++next;
+      }
+    } catch (...) {
+      for (size_type index = Leftmost(1, count); next-- > 0;
+           index = Next(index, count)) {
+        slots_[index].~value_type();
+      }
+      ::operator delete(slots_, std::align_val_t(kCacheLine));
+      slots_ = nullptr;
+      throw;
+    }
+    size_ = count;
+  }
+
+  // Slot of the smallest key in the subtree of index.
+  static size_type Leftmost(size_type index, size_type count) noexcept {
+    while (2 * index <= count) {
+      index *= 2;
+    }
+    return index;
+  }
+
+  // Slot of the next key in order: the leftmost of the right subtree, or
+  // else the nearest ancestor whose left subtree holds index.
+  static size_type Next(size_type index, size_type count) noexcept {
+    if (2 * index + 1 <= count) {
+      return Leftmost(2 * index + 1, count);
+    }
+    return Resolve(index);
+  }
+
+  value_type *slots_ = nullptr;
+  size_type size_ = 0;
+  Comparison cmp_;
+  // Keeps the image the slots lie in mapped, if they were opened rather
+  // than built.
+  std::shared_ptr<const void> image_;
+};
+
+}  // namespace s21
+
+#endif  // CONTAINERS_S21_FROZEN_TREE_H_
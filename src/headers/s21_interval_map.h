@@ -0,0 +1,270 @@
+#ifndef CONTAINERS_S21_INTERVAL_MAP_H_
+#define CONTAINERS_S21_INTERVAL_MAP_H_
+
+#include <algorithm>
+#include <optional>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "s21_tree.h"
+
+namespace s21 {
+// Map from closed intervals [low, high] of points to values, for matching
+// points and ranges against a set of ranges. Intervals are ordered by low,
+// then high, and may repeat. Every node also keeps the greatest high of its
+// subtree, so a search skips each subtree that ends before the query
+// starts and stops at the first interval that starts after it ends: finding
+// whether anything overlaps costs O(log n), and reporting k overlaps costs
+// O(log n) plus at most one root path per match, much less when the
+// matches lie close together.
+template <class Point, class Type, class Compare = std::less<Point>>
+class interval_map {
+ public:
+  using point_type = Point;
+  using interval_type = std::pair<point_type, point_type>;
+  using key_type = interval_type;
+  using mapped_type = Type;
+  using value_type = std::pair<const interval_type, mapped_type>;
+  using point_compare = Compare;
+  using reference = value_type &;
+  using const_reference = const value_type &;
+
+  // Orders elements by low, then high. It also compares elements with bare
+  // intervals, like map::MapValueComparator.
+  struct IntervalComparator {
+    using is_transparent = void;
+
+    bool operator()(const interval_type &left,
+                    const interval_type &right) const {
+      if (compare_(left.first, right.first)) {
+        return true;
+      }
+      if (compare_(right.first, left.first)) {
+        return false;
+      }
+      return compare_(left.second, right.second);
+    }
+
+    bool operator()(const_reference value1, const_reference value2) const {
+      return (*this)(value1.first, value2.first);
+    }
+
+    bool operator()(const interval_type &interval,
+                    const_reference value) const {
+      return (*this)(interval, value.first);
+    }
+
+    bool operator()(const_reference value,
+                    const interval_type &interval) const {
+      return (*this)(value.first, interval);
+    }
+
+    point_compare compare_;
+  };
+
+  // Greatest high of a subtree; empty for an empty one. Copying a
+  // point_type must not throw.
+  struct MaxHigh {
+    using value_type = std::optional<point_type>;
+
+    static value_type Identity() noexcept { return std::nullopt; }
+
+    static value_type Of(const_reference element) noexcept {
+      return element.first.second;
+    }
+
+    static value_type Combine(const value_type &left,
+                              const value_type &right) noexcept {
+      if (!left.has_value()) {
+        return right;
+      }
+      if (!right.has_value()) {
+        return left;
+      }
+      return point_compare()(*left, *right) ? right : left;
+    }
+  };
+
+  using tree_type =
+      tree<value_type, IntervalComparator, summary_traits<MaxHigh>>;
+  using iterator = typename tree_type::iterator;
+  using const_iterator = typename tree_type::const_iterator;
+  using size_type = std::size_t;
+
+  interval_map() : tree_(new tree_type{}) {}
+
+  interval_map(std::initializer_list<value_type> const &items)
+      : interval_map() {
+    for (const_reference item : items) {
+      insert(item);
+    }
+  }
+
+  interval_map(const interval_map &other)
+      : tree_(new tree_type(*other.tree_)) {}
+
+  interval_map(interval_map &&other) noexcept
+      : tree_(new tree_type(std::move(*other.tree_))) {}
+
+  interval_map &operator=(const interval_map &other) {
+    *tree_ = *other.tree_;
+    return *this;
+  }
+
+  interval_map &operator=(interval_map &&other) noexcept {
+    *tree_ = std::move(*other.tree_);
+    return *this;
+  }
+
+  ~interval_map() {
+    delete tree_;
+    tree_ = nullptr;
+  }
+
+  iterator begin() noexcept { return tree_->Begin(); }
+
+  const_iterator begin() const noexcept { return tree_->Begin(); }
+
+  iterator end() noexcept { return tree_->End(); }
+
+  const_iterator end() const noexcept { return tree_->End(); }
+
+  bool empty() const noexcept { return tree_->Empty(); }
+
+  size_type size() const noexcept { return tree_->Size(); }
+
+  size_type max_size() const noexcept { return tree_->MaxSize(); }
+
+  void clear() noexcept { tree_->Clear(); }
+
+  // Throws std::invalid_argument if the interval ends before it starts.
+  iterator insert(const value_type &value) {
+    CheckInterval(value.first);
+    return tree_->Insert(value);
+  }
+
+  iterator insert(const interval_type &interval, const mapped_type &obj) {
+    return insert(value_type{interval, obj});
+  }
+
+  void erase(iterator pos) noexcept { tree_->Erase(pos); }
+
+  // Removes the elements with the given interval; returns how many there
+  // were.
+  size_type erase(const interval_type &interval) noexcept {
+    return tree_->Erase(interval);
+  }
+
+  void swap(interval_map &other) noexcept { tree_->Swap(*other.tree_); }
+
+  iterator find(const interval_type &interval) {
+    return tree_->Find(interval);
+  }
+
+  const_iterator find(const interval_type &interval) const {
+    return tree_->Find(interval);
+  }
+
+  size_type count(const interval_type &interval) const {
+    return tree_->Count(interval);
+  }
+
+  // Whether some interval shares a point with [low, high].
+  bool overlaps(const point_type &low, const point_type &high) const {
+    bool found = false;
+    VisitOverlaps(
+        low, high, [&found](iterator) { found = true; },
+        [&found] { return found; });
+    return found;
+  }
+
+  // Writes an iterator to every interval sharing a point with [low, high]
+  // to out, in order.
+  template <typename OutputIt>
+  OutputIt overlap(const point_type &low, const point_type &high,
+                   OutputIt out) {
+    VisitOverlaps(low, high, [&out](iterator it) { *out++ = it; });
+    return out;
+  }
+
+  template <typename OutputIt>
+  OutputIt overlap(const point_type &low, const point_type &high,
+                   OutputIt out) const {
+    VisitOverlaps(low, high,
+                  [&out](iterator it) { *out++ = const_iterator(it); });
+    return out;
+  }
+
+  // Writes an iterator to every interval that contains point to out, in
+  // order.
+  template <typename OutputIt>
+  OutputIt stab(const point_type &point, OutputIt out) {
+    return overlap(point, point, out);
+  }
+
+  template <typename OutputIt>
+  OutputIt stab(const point_type &point, OutputIt out) const {
+    return overlap(point, point, out);
+  }
+
+  // Calls visit(query, it) for every interval query of [first, last) and
+  // every element it overlaps. The queries run in ascending order of low,
+  // so consecutive searches walk nearby paths that are still in cache.
+  template <typename ForwardIt, typename Visit>
+  void overlap_batch(ForwardIt first, ForwardIt last, Visit visit) const {
+    std::vector<const interval_type *> queries;
+    for (; first != last; ++first) {
+      queries.push_back(&*first);
+    }
+    point_compare compare;
+    std::sort(queries.begin(), queries.end(),
+              [&compare](const interval_type *left,
+                         const interval_type *right) {
+                return compare(left->first, right->first);
+              });
+    for (const interval_type *query : queries) {
+      VisitOverlaps(query->first, query->second,
+                    [&](iterator it) { visit(*query, const_iterator(it)); });
+    }
+  }
+
+ private:
+  static void CheckInterval(const interval_type &interval) {
+    if (point_compare()(interval.second, interval.first)) {
+      throw std::invalid_argument("interval ends before it starts");
+    }
+  }
+
+  static bool NotDone() noexcept { return false; }
+
+  // Calls visit(it) for every element overlapping [low, high] in order,
+  // until done() returns true. A query that ends before it starts overlaps
+  // nothing.
+  template <typename Visit, typename Done = bool (*)()>
+  void VisitOverlaps(const point_type &low, const point_type &high,
+                     Visit visit, Done done = NotDone) const {
+    point_compare compare;
+    if (compare(high, low)) {
+      return;
+    }
+    tree_->VisitPruned(
+        [&](const typename MaxHigh::value_type &max_high) {
+          return !max_high.has_value() || compare(*max_high, low);
+        },
+        [&](const_reference element) {
+          return done() || compare(high, element.first.first);
+        },
+        [&](iterator it) {
+          if (!compare((*it).first.second, low)) {
+            visit(it);
+          }
+        });
+  }
+
+  tree_type *tree_;
+};
+
+}  // namespace s21
+
+#endif  // CONTAINERS_S21_INTERVAL_MAP_H_
@@ -1,38 +1,97 @@
 #ifndef CONTAINERS_S21_MAP_H_
 #define CONTAINERS_S21_MAP_H_
 
+#include <iterator>
 #include <stdexcept>
+#include <string>
+#include <tuple>
+#include <utility>
 
+#include "s21_frozen_map.h"
 #include "s21_tree.h"
 
 namespace s21 {
-template <class Key, class Type>
+template <class Key, class Type, class Compare = std::less<Key>,
+          class Traits = tree_traits>
+class map;
+
+template <class Key, class Type, class Compare, class Traits>
+map<Key, Type, Compare, Traits> set_union(
+    const map<Key, Type, Compare, Traits> &first,
+    const map<Key, Type, Compare, Traits> &second,
+    thread_pool &threads = thread_pool::Shared());
+
+template <class Key, class Type, class Compare, class Traits>
+map<Key, Type, Compare, Traits> set_intersection(
+    const map<Key, Type, Compare, Traits> &first,
+    const map<Key, Type, Compare, Traits> &second,
+    thread_pool &threads = thread_pool::Shared());
+
+template <class Key, class Type, class Compare, class Traits>
+map<Key, Type, Compare, Traits> set_difference(
+    const map<Key, Type, Compare, Traits> &first,
+    const map<Key, Type, Compare, Traits> &second,
+    thread_pool &threads = thread_pool::Shared());
+
+// A transparent Compare such as std::less<> enables lookups by key-like
+// types. Traits selects optional tree bookkeeping; order_statistics_traits
+// enables nth() and rank(), statistics_traits enables stats(),
+// threaded_traits makes iterator steps O(1), and summary_traits enables
+// aggregate():
+//
+//   s21::map<long, double, std::less<long>,
+//            s21::summary_traits<s21::mapped_sum<double>>> volume;
+//   double total = volume.aggregate(from, to);
+template <class Key, class Type, class Compare, class Traits>
 class map {
  public:
   using key_type = Key;
   using mapped_type = Type;
   using value_type = std::pair<const key_type, mapped_type>;
+  using key_compare = Compare;
   using reference = value_type &;
   using const_reference = const value_type &;
 
+  // Orders elements by key. It also compares elements with bare keys, so
+  // the tree finds a key without building a value_type around it.
   struct MapValueComparator {
-    bool operator()(const_reference value1,
-                    const_reference value2) const noexcept {
-      return value1.first < value2.first;
+    using is_transparent = void;
+
+    bool operator()(const_reference value1, const_reference value2) const {
+      return compare_(value1.first, value2.first);
+    }
+
+    template <typename K>
+    bool operator()(const K &key, const_reference value) const {
+      return compare_(key, value.first);
     }
+
+    template <typename K>
+    bool operator()(const_reference value, const K &key) const {
+      return compare_(value.first, key);
+    }
+
+    key_compare compare_;
   };
 
-  using tree_type = tree<value_type, MapValueComparator>;
+  using tree_type = tree<value_type, MapValueComparator, Traits>;
   using iterator = typename tree_type::iterator;
   using const_iterator = typename tree_type::const_iterator;
+  using reverse_iterator = std::reverse_iterator<iterator>;
+  using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+  using node_type = typename tree_type::node_type;
+  using insert_return_type = typename tree_type::insert_return_type;
+  using summary_type = typename tree_type::summary_type;
   using size_type = std::size_t;
 
   map() : tree_(new tree_type{}) {}
 
-  map(std::initializer_list<value_type> const &items) : map() {
-    for (auto item : items) {
-      insert(item);
-    }
+  map(std::initializer_list<value_type> const &items)
+      : map(items.begin(), items.end()) {}
+
+  template <typename InputIt>
+  map(InputIt first, InputIt last) : map() {
+    tree_->InsertRangeUnique(first, last);
   }
 
   map(const map &other) : tree_(new tree_type(*other.tree_)) {}
@@ -54,30 +113,17 @@ class map {
     tree_ = nullptr;
   }
 
-  mapped_type &at(const key_type &key) {
-    value_type search_pair(key, mapped_type{});
-    iterator it_search = tree_->Find(search_pair);
-    if (it_search == end()) {
-      throw std::out_of_range("there is no such key");
-    } else {
-      return (*it_search).second;
-    }
-  }
+  // With a summary_type, a value written through the references at() and
+  // operator[] return is not seen by aggregate() until refresh() is called
+  // on its position; modify() does both at once.
+  mapped_type &at(const key_type &key) { return AtKey(key); }
 
   const mapped_type &at(const key_type &key) const {
-    return const_cast<map<Key, Type> *>(this)->at(key);
+    return const_cast<map *>(this)->AtKey(key);
   }
 
   mapped_type &operator[](const key_type &key) {
-    value_type search_pair(key, mapped_type{});
-    iterator it_search = tree_->Find(search_pair);
-
-    if (it_search == end()) {
-      std::pair<iterator, bool> result = tree_->InsertUnique(search_pair);
-      return (*result.first).second;
-    } else {
-      return (*it_search).second;
-    }
+    return (*try_emplace(key).first).second;
   }
 
   iterator begin() noexcept { return tree_->Begin(); }
@@ -88,6 +134,18 @@ class map {
 
   const_iterator end() const noexcept { return tree_->End(); }
 
+  reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+
+  const_reverse_iterator rbegin() const noexcept {
+    return const_reverse_iterator(end());
+  }
+
+  reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+
+  const_reverse_iterator rend() const noexcept {
+    return const_reverse_iterator(begin());
+  }
+
   bool empty() const noexcept { return tree_->Empty(); }
 
   size_type size() const noexcept { return tree_->Size(); }
@@ -96,6 +154,12 @@ class map {
 
   void clear() noexcept { tree_->Clear(); }
 
+  // Replaces the content with an already sorted range in linear time.
+  template <typename ForwardIt>
+  void assign_sorted(ForwardIt first, ForwardIt last) {
+    tree_->AssignSortedUnique(first, last);
+  }
+
   std::pair<iterator, bool> insert(const value_type &value) {
     return tree_->InsertUnique(value);
   }
@@ -105,40 +169,281 @@ class map {
     return tree_->InsertUnique(value_type{key, obj});
   }
 
+  // Amortized O(1) when value belongs right before hint, e.g. end() for
+  // ascending keys.
+  iterator insert(const_iterator hint, const value_type &value) {
+    return tree_->InsertUniqueHint(hint, value).first;
+  }
+
+  template <typename... Args>
+  iterator emplace_hint(const_iterator hint, Args &&...args) {
+    return tree_->EmplaceUniqueHint(hint, std::forward<Args>(args)...).first;
+  }
+
   std::pair<iterator, bool> insert_or_assign(const key_type &key,
                                              const mapped_type &obj) {
-    iterator result = tree_->Find(value_type{key, obj});
-
-    if (result == end()) {
-      return tree_->InsertUnique(value_type{key, obj});
+    std::pair<iterator, bool> result = try_emplace(key, obj);
+    if (!result.second) {
+      (*result.first).second = obj;
+      refresh(result.first);
     }
+    return result;
+  }
+
+  // Inserts an element with key and a mapped value constructed in place
+  // from args, with a single search. If key is present, nothing is
+  // constructed and args are left untouched.
+  template <typename... Args>
+  std::pair<iterator, bool> try_emplace(const key_type &key, Args &&...args) {
+    return tree_->TryEmplace(
+        key, std::piecewise_construct, std::forward_as_tuple(key),
+        std::forward_as_tuple(std::forward<Args>(args)...));
+  }
+
+  template <typename... Args>
+  std::pair<iterator, bool> try_emplace(key_type &&key, Args &&...args) {
+    return tree_->TryEmplace(
+        key, std::piecewise_construct, std::forward_as_tuple(std::move(key)),
+        std::forward_as_tuple(std::forward<Args>(args)...));
+  }
 
-    (*result).second = obj;
+  // Unlinks an element without freeing it; see insert(node_type &&).
+  node_type extract(iterator pos) noexcept { return tree_->Extract(pos); }
 
-    return {result, false};
+  node_type extract(const key_type &key) noexcept {
+    return tree_->Extract(key);
+  }
+
+  // Links an extracted node in without allocating. If its key is present
+  // already, the node is handed back in the result.
+  insert_return_type insert(node_type &&node) {
+    return tree_->InsertNode(std::move(node), true);
   }
 
   void erase(iterator pos) noexcept { tree_->Erase(pos); }
 
+  // Removes [first, last) in O(log n) plus the cost of destroying the
+  // elements; returns last.
+  iterator erase(iterator first, iterator last) noexcept {
+    tree_->Erase(first, last);
+    return last;
+  }
+
+  // Removes the elements equal to key; returns how many there were.
+  size_type erase(const key_type &key) noexcept { return tree_->Erase(key); }
+
+  // Removes the elements for which predicate returns true in one pass;
+  // returns how many there were.
+  template <typename Predicate>
+  size_type erase_if(Predicate predicate) {
+    return tree_->EraseIf(predicate);
+  }
+
   void swap(map &other) noexcept { tree_->Swap(*other.tree_); }
 
-  void merge(map &other) noexcept { tree_->MergeUnique(*other.tree_); }
+  void merge(map &other) { tree_->MergeUnique(*other.tree_); }
+
+  iterator find(const key_type &key) { return tree_->Find(key); }
+
+  const_iterator find(const key_type &key) const { return tree_->Find(key); }
+
+  bool contains(const key_type &key) const {
+    return tree_->Find(key) != tree_->End();
+  }
+
+  // The results of find() or contains() for every key of [first, last),
+  // written to out in order. Faster than one call per key on trees larger
+  // than the cache, as the lookups overlap their cache misses.
+  template <typename ForwardIt, typename OutputIt>
+  OutputIt find_batch(ForwardIt first, ForwardIt last, OutputIt out) {
+    return tree_->FindBatch(first, last, out);
+  }
+
+  template <typename ForwardIt, typename OutputIt>
+  OutputIt find_batch(ForwardIt first, ForwardIt last, OutputIt out) const {
+    return tree_->FindBatch(first, last, out);
+  }
+
+  template <typename ForwardIt, typename OutputIt>
+  OutputIt contains_batch(ForwardIt first, ForwardIt last,
+                          OutputIt out) const {
+    return tree_->ContainsBatch(first, last, out);
+  }
+
+  size_type count(const key_type &key) const { return tree_->Count(key); }
+
+  // Element at the given position in key order, end() if there is none.
+  iterator nth(size_type index) noexcept { return tree_->Select(index); }
+
+  const_iterator nth(size_type index) const noexcept {
+    return tree_->Select(index);
+  }
+
+  // Number of elements whose key is less than key.
+  size_type rank(const key_type &key) const { return tree_->Rank(key); }
+
+  // Operation counts and depth histogram of the tree, see tree::Stats.
+  // Needs statistics_traits.
+  tree_stats stats() const { return tree_->Stats(); }
+
+  // Summary of the mapped values whose key is in [low, high), in O(log n).
+  // Needs summary_traits. A value changed through an iterator or reference
+  // is not seen until refresh() is called on its position.
+  auto aggregate(const key_type &low, const key_type &high) const noexcept {
+    return tree_->Aggregate(low, high);
+  }
+
+  auto aggregate() const noexcept { return tree_->Aggregate(); }
+
+  void refresh(const_iterator pos) noexcept { tree_->Refresh(pos); }
+
+  // Calls function with the mapped value at pos and then refreshes the
+  // summaries, even if function throws.
+  template <typename Function>
+  void modify(iterator pos, Function function) {
+    try {
+      function((*pos).second);
+    } catch (...) {
+      refresh(pos);
+      throw;
+    }
+    refresh(pos);
+  }
+
+  // Read-only copy laid out for fast lookups; see frozen_map.
+  frozen_map<key_type, mapped_type, key_compare> freeze() const {
+    return frozen_map<key_type, mapped_type, key_compare>(begin(), size());
+  }
+
+  // Writes a versioned binary image of the map to path in O(n), without a
+  // frozen copy. Keys and mapped values must be trivially copyable. Images
+  // need s21_frozen_image.h, for this and open_mapped().
+  void save(const std::string &path) const {
+    frozen_map<key_type, mapped_type, key_compare>::tree_type::Save(
+        path, begin(), size());
+  }
+
+  // Maps an image written by save() and serves lookups and iteration from
+  // it directly, so reloading costs O(1) instead of n inserts. Throws
+  // std::system_error or std::runtime_error if path is not such an image.
+  static frozen_map<key_type, mapped_type, key_compare> open_mapped(
+      const std::string &path) {
+    return frozen_map<key_type, mapped_type, key_compare>::open_mapped(path);
+  }
 
-  bool contains(const key_type &key) const noexcept {
-    value_type search_pair(key, mapped_type{});
-    iterator it_search = tree_->Find(search_pair);
-    return !(it_search == end());
+  // Lookups by key-like types, available with a transparent Compare.
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  iterator find(const K &key) {
+    return tree_->Find(key);
   }
 
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  const_iterator find(const K &key) const {
+    return tree_->Find(key);
+  }
+
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  mapped_type &at(const K &key) {
+    return AtKey(key);
+  }
+
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  const mapped_type &at(const K &key) const {
+    return const_cast<map *>(this)->AtKey(key);
+  }
+
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  bool contains(const K &key) const {
+    return tree_->Find(key) != tree_->End();
+  }
+
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  size_type count(const K &key) const {
+    return tree_->Count(key);
+  }
+
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  size_type rank(const K &key) const {
+    return tree_->Rank(key);
+  }
+
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  auto aggregate(const K &low, const K &high) const noexcept {
+    return tree_->Aggregate(low, high);
+  }
+
+  // Inserts one element per argument, each constructed in its node from
+  // the argument; an argument that is a value_type whose key is present
+  // already costs no allocation. try_emplace constructs a single element
+  // from several arguments.
   template <typename... Args>
   std::vector<std::pair<iterator, bool>> emplace(Args &&...args) {
     return tree_->EmplaceUnique(std::forward<Args>(args)...);
   }
 
+  friend map set_union<>(const map &first, const map &second,
+                         thread_pool &threads);
+
+  friend map set_intersection<>(const map &first, const map &second,
+                                thread_pool &threads);
+
+  friend map set_difference<>(const map &first, const map &second,
+                              thread_pool &threads);
+
  private:
+  explicit map(tree_type &&tree) : tree_(new tree_type(std::move(tree))) {}
+
+  template <typename K>
+  mapped_type &AtKey(const K &key) {
+    iterator it_search = tree_->Find(key);
+    if (it_search == end()) {
+      throw std::out_of_range("there is no such key");
+    }
+    return (*it_search).second;
+  }
+
   tree_type *tree_;
 };
 
+// Elements whose key is present in first or second. For keys present in
+// both the element of first is kept.
+template <class Key, class Type, class Compare, class Traits>
+map<Key, Type, Compare, Traits> set_union(
+    const map<Key, Type, Compare, Traits> &first,
+    const map<Key, Type, Compare, Traits> &second, thread_pool &threads) {
+  using result_type = map<Key, Type, Compare, Traits>;
+  return result_type(result_type::tree_type::Union(*first.tree_,
+                                                   *second.tree_, threads));
+}
+
+// Elements of first whose key is also present in second.
+template <class Key, class Type, class Compare, class Traits>
+map<Key, Type, Compare, Traits> set_intersection(
+    const map<Key, Type, Compare, Traits> &first,
+    const map<Key, Type, Compare, Traits> &second, thread_pool &threads) {
+  using result_type = map<Key, Type, Compare, Traits>;
+  return result_type(result_type::tree_type::Intersection(
+      *first.tree_, *second.tree_, threads));
+}
+
+// Elements of first whose key is not present in second.
+template <class Key, class Type, class Compare, class Traits>
+map<Key, Type, Compare, Traits> set_difference(
+    const map<Key, Type, Compare, Traits> &first,
+    const map<Key, Type, Compare, Traits> &second, thread_pool &threads) {
+  using result_type = map<Key, Type, Compare, Traits>;
+  return result_type(result_type::tree_type::Difference(
+      *first.tree_, *second.tree_, threads));
+}
+
 }  // namespace s21
 
 #endif  // CONTAINERS_S21_MAP_H_
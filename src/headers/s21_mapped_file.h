@@ -0,0 +1,127 @@
+#ifndef CONTAINERS_S21_MAPPED_FILE_H_
+#define CONTAINERS_S21_MAPPED_FILE_H_
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstddef>
+#include <cstdio>
+#include <string>
+#include <system_error>
+#include <utility>
+
+namespace s21 {
+// Read-only private mapping of a whole file, unmapped on destruction. The
+// pages are loaded on first touch. POSIX only.
+class mapped_file {
+ public:
+  mapped_file() = default;
+
+  // Throws std::system_error if the file cannot be opened or mapped. An
+  // empty file maps to no data.
+  explicit mapped_file(const std::string &path) {
+    int descriptor = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (descriptor < 0) {
+      throw std::system_error(errno, std::generic_category(),
+                              "cannot open " + path);
+    }
+    struct stat status;
+    if (::fstat(descriptor, &status) != 0) {
+      int error = errno;
+      ::close(descriptor);
+      throw std::system_error(error, std::generic_category(),
+                              "cannot stat " + path);
+    }
+    std::size_t size = static_cast<std::size_t>(status.st_size);
+    if (size > 0) {
+      void *data =
+          ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, descriptor, 0);
+      if (data == MAP_FAILED) {
+        int error = errno;
+        ::close(descriptor);
+        throw std::system_error(error, std::generic_category(),
+                                "cannot map " + path);
+      }
+      data_ = data;
+      size_ = size;
+    }
+    ::close(descriptor);
+  }
+
+  mapped_file(const mapped_file &) = delete;
+
+  mapped_file(mapped_file &&other) noexcept { Swap(other); }
+
+  mapped_file &operator=(const mapped_file &) = delete;
+
+  mapped_file &operator=(mapped_file &&other) noexcept {
+    if (this != &other) {
+      mapped_file moved(std::move(other));
+      Swap(moved);
+    }
+    return *this;
+  }
+
+  ~mapped_file() {
+    if (data_ != nullptr) {
+      ::munmap(data_, size_);
+    }
+  }
+
+  const void *Data() const noexcept { return data_; }
+
+  std::size_t Size() const noexcept { return size_; }
+
+  void Swap(mapped_file &other) noexcept {
+    std::swap(data_, other.data_);
+    std::swap(size_, other.size_);
+  }
+
+  // Calls fill(write), where write(data, size) appends bytes, on a
+  // temporary file next to path and renames it over path, so a reader
+  // never maps a partial file. Throws std::system_error if writing fails;
+  // the temporary file is removed then.
+  template <typename Fill>
+  static void Write(const std::string &path, Fill fill) {
+    std::string temporary = path + ".tmp";
+    std::FILE *file = std::fopen(temporary.c_str(), "wb");
+    if (file == nullptr) {
+      throw std::system_error(errno, std::generic_category(),
+                              "cannot create " + temporary);
+    }
+    try {
+      fill([file, &temporary](const void *data, std::size_t size) {
+        if (size > 0 && std::fwrite(data, size, 1, file) != 1) {
+          throw std::system_error(errno, std::generic_category(),
+                                  "cannot write " + temporary);
+        }
+      });
+      if (std::fflush(file) != 0 || ::fsync(::fileno(file)) != 0) {
+        throw std::system_error(errno, std::generic_category(),
+                                "cannot write " + temporary);
+      }
+    } catch (...) {
+      std::fclose(file);
+      std::remove(temporary.c_str());
+      throw;
+    }
+    if (std::fclose(file) != 0 ||
+        std::rename(temporary.c_str(), path.c_str()) != 0) {
+      int error = errno;
+      std::remove(temporary.c_str());
+      throw std::system_error(error, std::generic_category(),
+                              "cannot write " + path);
+    }
+  }
+
+ private:
+  void *data_ = nullptr;
+  std::size_t size_ = 0;
+};
+
+}  // namespace s21
+
+#endif  // CONTAINERS_S21_MAPPED_FILE_H_
@@ -1,27 +1,50 @@
 #ifndef CONTAINERS_S21_MULTISET_H_
 #define CONTAINERS_S21_MULTISET_H_
 
+#include <iterator>
+#include <type_traits>
+#include <vector>
+
 #include "s21_tree.h"
 
 namespace s21 {
-template <class Key>
+// Selects the counted mode of multiset, see its specialization for
+// Traits::kCounted. Derive from it to combine the mode with other options.
+struct counted_traits : tree_traits {
+  static constexpr bool kCounted = true;
+};
+
+// A transparent Compare such as std::less<> enables lookups by key-like
+// types. Traits selects optional tree bookkeeping; order_statistics_traits
+// makes count() O(log n) and enables nth() and rank(), statistics_traits
+// enables stats(), threaded_traits makes iterator steps O(1) and
+// counted_traits stores equal keys once. Counted follows from Traits and
+// is not meant to be given.
+template <class Key, class Compare = std::less<Key>,
+          class Traits = tree_traits, bool Counted = Traits::kCounted>
 class multiset {
  public:
   using key_type = Key;
   using value_type = key_type;
+  using key_compare = Compare;
   using reference = value_type &;
   using const_reference = const value_type &;
-  using tree_type = tree<value_type>;
+  using tree_type = tree<value_type, key_compare, Traits>;
   using iterator = typename tree_type::iterator;
   using const_iterator = typename tree_type::const_iterator;
+  using reverse_iterator = std::reverse_iterator<iterator>;
+  using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+  using node_type = typename tree_type::node_type;
   using size_type = std::size_t;
 
   multiset() : tree_(new tree_type{}) {}
 
-  multiset(std::initializer_list<value_type> const &items) : multiset() {
-    for (auto item : items) {
-      insert(item);
-    }
+  multiset(std::initializer_list<value_type> const &items)
+      : multiset(items.begin(), items.end()) {}
+
+  template <typename InputIt>
+  multiset(InputIt first, InputIt last) : multiset() {
+    tree_->InsertRange(first, last);
   }
 
   multiset(const multiset &other) : tree_(new tree_type(*other.tree_)) {}
@@ -52,6 +75,18 @@ class multiset {
 
   const_iterator end() const noexcept { return tree_->End(); }
 
+  reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+
+  const_reverse_iterator rbegin() const noexcept {
+    return const_reverse_iterator(end());
+  }
+
+  reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+
+  const_reverse_iterator rend() const noexcept {
+    return const_reverse_iterator(begin());
+  }
+
   bool empty() const noexcept { return tree_->Empty(); }
 
   size_type size() const noexcept { return tree_->Size(); }
@@ -60,30 +95,63 @@ class multiset {
 
   void clear() noexcept { tree_->Clear(); }
 
+  // Replaces the content with an already sorted range in linear time.
+  template <typename ForwardIt>
+  void assign_sorted(ForwardIt first, ForwardIt last) {
+    tree_->AssignSorted(first, last);
+  }
+
   iterator insert(const value_type &value) { return tree_->Insert(value); }
 
-  void erase(iterator pos) noexcept { tree_->Erase(pos); }
+  // Amortized O(1) when value belongs right before hint, e.g. end() for
+  // ascending input.
+  iterator insert(const_iterator hint, const value_type &value) {
+    return tree_->InsertHint(hint, value);
+  }
 
-  void swap(multiset &other) noexcept { tree_->Swap(*other.tree_); }
+  template <typename... Args>
+  iterator emplace_hint(const_iterator hint, Args &&...args) {
+    return tree_->EmplaceHint(hint, std::forward<Args>(args)...);
+  }
 
-  void merge(multiset &other) noexcept { tree_->Merge(*other.tree_); }
+  // Unlinks an element without freeing it; see insert(node_type &&).
+  node_type extract(iterator pos) noexcept { return tree_->Extract(pos); }
 
-  size_type count(const key_type &key) const {
-    auto lower_iterator = lower_bound(key);
-    if (*lower_iterator != key) {
-      return 0;
-    }
+  // Unlinks the first element equal to key, if any.
+  node_type extract(const key_type &key) noexcept {
+    return tree_->Extract(key);
+  }
 
-    auto end_iterator = end();
-    size_type result_count = 0;
-    while (lower_iterator != end_iterator && *lower_iterator == key) {
-      ++result_count;
-      ++lower_iterator;
-    }
+  // Links an extracted node in without allocating.
+  iterator insert(node_type &&node) {
+    return tree_->InsertNode(std::move(node), false).position;
+  }
+
+  void erase(iterator pos) noexcept { tree_->Erase(pos); }
+
+  // Removes [first, last) in O(log n) plus the cost of destroying the
+  // elements; returns last.
+  iterator erase(iterator first, iterator last) noexcept {
+    tree_->Erase(first, last);
+    return last;
+  }
 
-    return result_count;
+  // Removes the elements equal to key; returns how many there were.
+  size_type erase(const key_type &key) noexcept { return tree_->Erase(key); }
+
+  // Removes the elements for which predicate returns true in one pass;
+  // returns how many there were.
+  template <typename Predicate>
+  size_type erase_if(Predicate predicate) {
+    return tree_->EraseIf(predicate);
   }
 
+  void swap(multiset &other) noexcept { tree_->Swap(*other.tree_); }
+
+  void merge(multiset &other) { tree_->Merge(*other.tree_); }
+
+  size_type count(const key_type &key) const { return tree_->Count(key); }
+
   iterator find(const key_type &key) noexcept { return tree_->Find(key); }
 
   const_iterator find(const key_type &key) const noexcept {
@@ -94,6 +162,25 @@ class multiset {
     return tree_->Find(key) != tree_->End();
   }
 
+  // The results of find() or contains() for every key of [first, last),
+  // written to out in order. Faster than one call per key on trees larger
+  // than the cache, as the lookups overlap their cache misses.
+  template <typename ForwardIt, typename OutputIt>
+  OutputIt find_batch(ForwardIt first, ForwardIt last, OutputIt out) {
+    return tree_->FindBatch(first, last, out);
+  }
+
+  template <typename ForwardIt, typename OutputIt>
+  OutputIt find_batch(ForwardIt first, ForwardIt last, OutputIt out) const {
+    return tree_->FindBatch(first, last, out);
+  }
+
+  template <typename ForwardIt, typename OutputIt>
+  OutputIt contains_batch(ForwardIt first, ForwardIt last,
+                          OutputIt out) const {
+    return tree_->ContainsBatch(first, last, out);
+  }
+
   std::pair<iterator, iterator> equal_range(const key_type &key) noexcept {
     iterator first = lower_bound(key);
     iterator second = upper_bound(key);
@@ -124,6 +211,74 @@ class multiset {
     return tree_->UpperBound(key);
   }
 
+  // Element at the given position in key order, end() if there is none.
+  iterator nth(size_type index) noexcept { return tree_->Select(index); }
+
+  const_iterator nth(size_type index) const noexcept {
+    return tree_->Select(index);
+  }
+
+  // Number of elements less than key: the position of lower_bound(key).
+  size_type rank(const key_type &key) const noexcept {
+    return tree_->Rank(key);
+  }
+
+  // Operation counts and depth histogram of the tree, see tree::Stats.
+  // Needs statistics_traits.
+  tree_stats stats() const { return tree_->Stats(); }
+
+  // Lookups by key-like types, available with a transparent Compare.
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  size_type count(const K &key) const {
+    return tree_->Count(key);
+  }
+
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  iterator find(const K &key) {
+    return tree_->Find(key);
+  }
+
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  const_iterator find(const K &key) const {
+    return tree_->Find(key);
+  }
+
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  bool contains(const K &key) const {
+    return tree_->Find(key) != tree_->End();
+  }
+
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  std::pair<iterator, iterator> equal_range(const K &key) {
+    return {tree_->LowerBound(key), tree_->UpperBound(key)};
+  }
+
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  iterator lower_bound(const K &key) {
+    return tree_->LowerBound(key);
+  }
+
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  iterator upper_bound(const K &key) {
+    return tree_->UpperBound(key);
+  }
+
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  size_type rank(const K &key) const {
+    return tree_->Rank(key);
+  }
+
+  // Inserts one element per argument, each constructed in its node from
+  // the argument. emplace_hint constructs a single element from several
+  // arguments.
   template <typename... Args>
   std::vector<std::pair<iterator, bool>> emplace(Args &&...args) {
     return tree_->Emplace(std::forward<Args>(args)...);
@@ -132,6 +287,433 @@ class multiset {
  private:
   tree_type *tree_;
 };
+
+// Counted mode for heavily duplicated keys: each distinct key is stored
+// once in a node together with the number of its copies. Memory and the
+// cost of insert are O(distinct keys); count, erase by key and equal_range
+// are O(log n) no matter how many copies there are. Iteration still visits
+// every copy. Elements are immutable, as equal copies share one key.
+//
+// The other options of Traits apply to the tree of distinct keys, so
+// stats() counts its nodes. kOrderStatistics makes every node sum the
+// copies of its subtree instead of counting the nodes, so that nth() and
+// rank() count copies. Copies share their node, hence there is no
+// extract() or insert of a node, and Traits may not have a summary_type.
+template <class Key, class Compare, class Traits>
+class multiset<Key, Compare, Traits, true> {
+ public:
+  class Iterator;
+
+  using key_type = Key;
+  using value_type = key_type;
+  using key_compare = Compare;
+  using reference = const value_type &;
+  using const_reference = const value_type &;
+  using size_type = std::size_t;
+  using run_type = std::pair<const key_type, size_type>;
+
+  // Orders runs by key and compares them with bare keys, like the
+  // comparator of map.
+  struct RunComparator {
+    using is_transparent = void;
+
+    bool operator()(const run_type &run1, const run_type &run2) const {
+      return compare_(run1.first, run2.first);
+    }
+
+    template <typename K>
+    bool operator()(const K &key, const run_type &run) const {
+      return compare_(key, run.first);
+    }
+
+    template <typename K>
+    bool operator()(const run_type &run, const K &key) const {
+      return compare_(run.first, key);
+    }
+
+    key_compare compare_;
+  };
+
+  // Number of copies in a subtree, kept with kOrderStatistics.
+  struct RunCopies {
+    using value_type = size_type;
+
+    static value_type Identity() noexcept { return 0; }
+
+    static value_type Of(const run_type &run) noexcept { return run.second; }
+
+    static value_type Combine(const value_type &left,
+                              const value_type &right) noexcept {
+      return left + right;
+    }
+  };
+
+  struct RunTraits : Traits {
+    static constexpr bool kOrderStatistics = false;
+    using summary_type =
+        std::conditional_t<Traits::kOrderStatistics, RunCopies, void>;
+  };
+
+  static_assert(std::is_void_v<typename Traits::summary_type>,
+                "a counted multiset keeps no summary_type");
+
+  using tree_type = tree<run_type, RunComparator, RunTraits>;
+  using iterator = Iterator;
+  using const_iterator = Iterator;
+  using reverse_iterator = std::reverse_iterator<iterator>;
+  using const_reverse_iterator = reverse_iterator;
+
+  multiset() : tree_(new tree_type{}), size_(0) {}
+
+  multiset(std::initializer_list<value_type> const &items)
+      : multiset(items.begin(), items.end()) {}
+
+  template <typename InputIt>
+  multiset(InputIt first, InputIt last) : multiset() {
+    for (; first != last; ++first) {
+      insert(*first);
+    }
+  }
+
+  multiset(const multiset &other)
+      : tree_(new tree_type(*other.tree_)), size_(other.size_) {}
+
+  multiset(multiset &&other) noexcept
+      : tree_(new tree_type(std::move(*other.tree_))), size_(other.size_) {
+    other.size_ = 0;
+  }
+
+  multiset &operator=(const multiset &other) {
+    *tree_ = *other.tree_;
+    size_ = other.size_;
+    return *this;
+  }
+
+  multiset &operator=(multiset &&other) noexcept {
+    *tree_ = std::move(*other.tree_);
+    size_ = other.size_;
+    other.size_ = 0;
+    return *this;
+  }
+
+  ~multiset() {
+    delete tree_;
+    tree_ = nullptr;
+  }
+
+  const_iterator begin() const noexcept { return Iterator(tree_->Begin()); }
+
+  const_iterator end() const noexcept { return Iterator(tree_->End()); }
+
+  const_reverse_iterator rbegin() const noexcept {
+    return const_reverse_iterator(end());
+  }
+
+  const_reverse_iterator rend() const noexcept {
+    return const_reverse_iterator(begin());
+  }
+
+  bool empty() const noexcept { return size_ == 0; }
+
+  size_type size() const noexcept { return size_; }
+
+  // Number of distinct keys, which is the number of nodes.
+  size_type distinct_size() const noexcept { return tree_->Size(); }
+
+  size_type max_size() const noexcept { return tree_->MaxSize(); }
+
+  void clear() noexcept {
+    tree_->Clear();
+    size_ = 0;
+  }
+
+  // O(log distinct keys); allocates only for a key not present yet.
+  iterator insert(const value_type &value) { return insert(value, 1); }
+
+  // Skips the search when hint points at a copy of value.
+  iterator insert(const_iterator hint, const value_type &value) {
+    key_compare compare{};
+    if (hint.run_ == tree_->End() || compare(value, *hint) ||
+        compare(*hint, value)) {
+      return insert(value);
+    }
+    size_type before = (*hint.run_).second;
+    SetCopies(hint.run_, before + 1);
+    ++size_;
+    return Iterator(hint.run_, before);
+  }
+
+  // Inserts copies of value at once. Returns the first of them, or end()
+  // if copies is 0.
+  iterator insert(const value_type &value, size_type copies) {
+    if (copies == 0) {
+      return end();
+    }
+    std::pair<run_iterator, bool> result =
+        tree_->TryEmplace(value, value, copies);
+    size_type before = 0;
+    if (!result.second) {
+      before = (*result.first).second;
+      SetCopies(result.first, before + copies);
+    }
+    size_ += copies;
+    return Iterator(result.first, before);
+  }
+
+  // Inserts one element per argument, each constructed from the argument.
+  // emplace_hint constructs a single element from several arguments.
+  template <typename... Args>
+  std::vector<std::pair<iterator, bool>> emplace(Args &&...args) {
+    std::vector<std::pair<iterator, bool>> result;
+    result.reserve(sizeof...(Args));
+    (result.emplace_back(insert(value_type(std::forward<Args>(args))), true),
+     ...);
+    return result;
+  }
+
+  template <typename... Args>
+  iterator emplace_hint(const_iterator hint, Args &&...args) {
+    return insert(hint, value_type(std::forward<Args>(args)...));
+  }
+
+  // Removes one copy and returns the iterator to the element after it.
+  // Copies are interchangeable, so iterators to later copies of the same
+  // key stay valid; the one to the last copy still reads the key and steps
+  // to the next key.
+  iterator erase(iterator pos) noexcept {
+    --size_;
+    if ((*pos.run_).second == 1) {
+      run_iterator next = pos.run_;
+      ++next;
+      tree_->Erase(pos.run_);
+      return Iterator(next);
+    }
+    SetCopies(pos.run_, (*pos.run_).second - 1);
+    if (pos.copy_ == (*pos.run_).second) {
+      ++pos.run_;
+      pos.copy_ = 0;
+    }
+    return pos;
+  }
+
+  // Removes [first, last) in O(log n) plus the number of distinct keys in
+  // it; returns the iterator to the element last pointed at.
+  iterator erase(const_iterator first, const_iterator last) noexcept {
+    if (first.run_ != last.run_) {
+      run_iterator run = first.run_;
+      if (first.copy_ > 0) {
+        size_ -= (*run).second - first.copy_;
+        SetCopies(run, first.copy_);
+        ++run;
+      }
+      for (run_iterator it = run; it != last.run_; ++it) {
+        size_ -= (*it).second;
+      }
+      tree_->Erase(run, last.run_);
+      first = Iterator(last.run_);
+    }
+    if (first.copy_ != last.copy_) {
+      size_type removed = last.copy_ - first.copy_;
+      SetCopies(first.run_, (*first.run_).second - removed);
+      size_ -= removed;
+    }
+    return first;
+  }
+
+  // Removes every copy of key in O(log n); returns how many there were.
+  size_type erase(const key_type &key) noexcept {
+    run_iterator run = tree_->Find(key);
+    if (run == tree_->End()) {
+      return 0;
+    }
+    size_type copies = (*run).second;
+    tree_->Erase(run);
+    size_ -= copies;
+    return copies;
+  }
+
+  // Removes every copy of the keys for which predicate returns true in one
+  // pass; returns how many copies there were.
+  template <typename Predicate>
+  size_type erase_if(Predicate predicate) {
+    size_type removed = 0;
+    tree_->EraseIf([this, &predicate, &removed](const run_type &run) {
+      if (!predicate(run.first)) {
+        return false;
+      }
+      removed += run.second;
+      size_ -= run.second;
+      return true;
+    });
+    return removed;
+  }
+
+  void swap(multiset &other) noexcept {
+    tree_->Swap(*other.tree_);
+    std::swap(size_, other.size_);
+  }
+
+  // Moves all copies of other into this multiset.
+  void merge(multiset &other) {
+    if (this != &other) {
+      for (run_iterator run = other.tree_->Begin(); run != other.tree_->End();
+           ++run) {
+        insert((*run).first, (*run).second);
+      }
+      other.clear();
+    }
+  }
+
+  size_type count(const key_type &key) const noexcept {
+    run_iterator run = tree_->Find(key);
+    return run == tree_->End() ? 0 : (*run).second;
+  }
+
+  const_iterator find(const key_type &key) const noexcept {
+    return Iterator(tree_->Find(key));
+  }
+
+  bool contains(const key_type &key) const noexcept {
+    return tree_->Find(key) != tree_->End();
+  }
+
+  // The results of find() or contains() for every key of [first, last),
+  // written to out in order; see multiset::find_batch.
+  template <typename ForwardIt, typename OutputIt>
+  OutputIt find_batch(ForwardIt first, ForwardIt last, OutputIt out) const {
+    return tree_->FindBatch(first, last, IteratorOutput<OutputIt>{out}).out_;
+  }
+
+  template <typename ForwardIt, typename OutputIt>
+  OutputIt contains_batch(ForwardIt first, ForwardIt last,
+                          OutputIt out) const {
+    return tree_->ContainsBatch(first, last, out);
+  }
+
+  std::pair<const_iterator, const_iterator> equal_range(
+      const key_type &key) const noexcept {
+    return {lower_bound(key), upper_bound(key)};
+  }
+
+  const_iterator lower_bound(const key_type &key) const noexcept {
+    return Iterator(tree_->LowerBound(key));
+  }
+
+  const_iterator upper_bound(const key_type &key) const noexcept {
+    return Iterator(tree_->UpperBound(key));
+  }
+
+  // Copy at the given position in key order, end() if there is none.
+  // Needs kOrderStatistics.
+  const_iterator nth(size_type index) const noexcept {
+    static_assert(Traits::kOrderStatistics, "nth needs kOrderStatistics");
+    auto found = tree_->SearchPrefix(
+        [index](size_type copies) { return copies > index; });
+    return Iterator(found.first,
+                    found.first == tree_->End() ? 0 : index - found.second);
+  }
+
+  // Number of copies less than key: the position of lower_bound(key).
+  // Needs kOrderStatistics.
+  size_type rank(const key_type &key) const noexcept {
+    static_assert(Traits::kOrderStatistics, "rank needs kOrderStatistics");
+    return tree_->AggregateBefore(key);
+  }
+
+  // Operation counts and depth histogram of the tree of distinct keys, see
+  // tree::Stats. Needs statistics_traits.
+  tree_stats stats() const { return tree_->Stats(); }
+
+  // Visits every copy of every key in order.
+  class Iterator {
+   public:
+    using iterator_category = std::bidirectional_iterator_tag;
+    using difference_type = std::ptrdiff_t;
+    using value_type = multiset::value_type;
+    using pointer = const value_type *;
+    using reference = const value_type &;
+
+    reference operator*() const noexcept { return (*run_).first; }
+
+    pointer operator->() const noexcept { return &(*run_).first; }
+
+    Iterator &operator++() noexcept {
+      if (++copy_ >= (*run_).second) {
+        ++run_;
+        copy_ = 0;
+      }
+      return *this;
+    }
+
+    Iterator operator++(int) noexcept {
+      Iterator previous = *this;
+      ++*this;
+      return previous;
+    }
+
+    Iterator &operator--() noexcept {
+      if (copy_ == 0) {
+        --run_;
+        copy_ = (*run_).second;
+      }
+      --copy_;
+      return *this;
+    }
+
+    Iterator operator--(int) noexcept {
+      Iterator next = *this;
+      --*this;
+      return next;
+    }
+
+    bool operator==(const Iterator &other) const noexcept {
+      return run_ == other.run_ && copy_ == other.copy_;
+    }
+
+    bool operator!=(const Iterator &other) const noexcept {
+      return !(*this == other);
+    }
+
+   private:
+    friend class multiset;
+
+    explicit Iterator(typename tree_type::iterator run, size_type copy = 0)
+        : run_(run), copy_(copy) {}
+
+    typename tree_type::iterator run_;
+    size_type copy_;
+  };
+
+ private:
+  using run_iterator = typename tree_type::iterator;
+
+  // Output iterator for tree::FindBatch that turns runs into iterators.
+  template <typename OutputIt>
+  struct IteratorOutput {
+    IteratorOutput &operator*() noexcept { return *this; }
+
+    IteratorOutput &operator++(int) noexcept { return *this; }
+
+    IteratorOutput &operator=(run_iterator run) {
+      *out_++ = Iterator(run);
+      return *this;
+    }
+
+    OutputIt out_;
+  };
+
+  // Sets the number of copies of run and, with kOrderStatistics, the
+  // counts of the subtrees above it.
+  void SetCopies(run_iterator run, size_type copies) noexcept {
+    (*run).second = copies;
+    if constexpr (Traits::kOrderStatistics) {
+      tree_->Refresh(run);
+    }
+  }
+
+  tree_type *tree_;
+  size_type size_;
+};
 }  // namespace s21
 
 #endif  // CONTAINERS_S21_MULTISET_H_
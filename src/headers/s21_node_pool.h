@@ -0,0 +1,249 @@
+#ifndef CONTAINERS_S21_NODE_POOL_H_
+#define CONTAINERS_S21_NODE_POOL_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <vector>
+
+namespace s21 {
+// Slab allocator for fixed-size tree nodes. Slots are handed out from
+// contiguous chunks, erased slots go to an intrusive free list and Release()
+// drops every chunk at once.
+//
+// Trees that exchange nodes (merge, node handles) share the chunks the nodes
+// live in, but each pool keeps its own free list: a slot belongs to the pool
+// of the tree that holds the node, and a chunk lives as long as any pool
+// holding a share of it. Trees that exchanged nodes thus stay independent
+// and may be modified on different threads.
+//
+// With Statistics the pool counts the slots it hands out and takes back; a
+// node that moves to another pool counts as freed here and allocated there.
+template <bool Statistics>
+struct node_pool_counts {};
+
+template <>
+struct node_pool_counts<true> {
+  std::size_t allocations_ = 0;
+  std::size_t frees_ = 0;
+};
+
+template <typename T, bool Statistics = false>
+class node_pool : node_pool_counts<Statistics> {
+ public:
+  using size_type = std::size_t;
+
+  node_pool() = default;
+
+  node_pool(const node_pool &) = delete;
+
+  node_pool &operator=(const node_pool &) = delete;
+
+  ~node_pool() = default;
+
+  T *Allocate() {
+    if constexpr (Statistics) {
+      ++this->allocations_;
+    }
+    Slot *slot = free_;
+    if (slot != nullptr) {
+      free_ = slot->next_;
+      if (free_ == nullptr) {
+        free_tail_ = nullptr;
+      }
+    } else {
+      if (cursor_ == chunk_end_) {
+        AddChunk();
+      }
+      slot = cursor_++;
+    }
+    return reinterpret_cast<T *>(slot);
+  }
+
+  void Deallocate(T *pointer) noexcept {
+    if constexpr (Statistics) {
+      ++this->frees_;
+    }
+    PushFree(reinterpret_cast<Slot *>(pointer));
+  }
+
+  // Frees every slot at once, the ones in use included.
+  void Release() noexcept {
+    if constexpr (Statistics) {
+      this->frees_ = this->allocations_;
+    }
+    chunks_.clear();
+    free_ = nullptr;
+    free_tail_ = nullptr;
+    cursor_ = nullptr;
+    chunk_end_ = nullptr;
+    capacity_ = 0;
+    next_chunk_size_ = kFirstChunkSize;
+  }
+
+  size_type ChunkCount() const noexcept { return chunks_.size(); }
+
+  size_type Capacity() const noexcept { return capacity_; }
+
+  size_type Allocations() const noexcept {
+    static_assert(Statistics, "Allocations needs Statistics");
+    return this->allocations_;
+  }
+
+  size_type Frees() const noexcept {
+    static_assert(Statistics, "Frees needs Statistics");
+    return this->frees_;
+  }
+
+  // Share in the chunk of a node that left its pool, see HandOver.
+  class chunk_share {
+   public:
+    chunk_share() = default;
+
+   private:
+    friend class node_pool;
+
+    std::shared_ptr<void> chunk_;
+  };
+
+  // Gives up the slot of pointer, whose node is leaving for another pool,
+  // and returns a share in its chunk to be handed to TakeOver. The slot can
+  // still be returned to this pool with Reclaim.
+  chunk_share HandOver(const T *pointer) noexcept {
+    if constexpr (Statistics) {
+      ++this->frees_;
+    }
+    const Slot *slot = reinterpret_cast<const Slot *>(pointer);
+    auto chunk = std::upper_bound(
+        chunks_.begin(), chunks_.end(), slot,
+        [](const Slot *slot, const Chunk &chunk) {
+          return std::less<const Slot *>()(slot, chunk.get());
+        });
+    chunk_share share;
+    share.chunk_ = *std::prev(chunk);
+    return share;
+  }
+
+  // Makes the node of a HandOver slot one of this pool.
+  void TakeOver(const chunk_share &share) {
+    if constexpr (Statistics) {
+      ++this->allocations_;
+    }
+    AddShare(std::static_pointer_cast<Slot>(share.chunk_));
+  }
+
+  // Returns a slot given up by HandOver whose node never reached another
+  // pool.
+  void Reclaim(T *pointer) noexcept {
+    PushFree(reinterpret_cast<Slot *>(pointer));
+  }
+
+  // Takes a share in every chunk of other, before nodes of other move to
+  // the tree of this pool; see Moved.
+  void Share(const node_pool &other) {
+    if (&other == this) {
+      return;
+    }
+    std::vector<Chunk> chunks;
+    chunks.reserve(chunks_.size() + other.chunks_.size());
+    std::set_union(chunks_.begin(), chunks_.end(), other.chunks_.begin(),
+                   other.chunks_.end(), std::back_inserter(chunks),
+                   ChunkLess());
+    chunks_.swap(chunks);
+  }
+
+  // Counts nodes that moved from other to this pool after Share.
+  void Moved(node_pool &other, size_type nodes) noexcept {
+    if constexpr (Statistics) {
+      this->allocations_ += nodes;
+      other.frees_ += nodes;
+    } else {
+      static_cast<void>(other);
+      static_cast<void>(nodes);
+    }
+  }
+
+  // Takes over other entirely, its free slots included, and leaves it
+  // empty. No other pool may have slots in the chunks of other.
+  void Absorb(node_pool &other) {
+    Share(other);
+    while (other.cursor_ != other.chunk_end_) {
+      other.PushFree(other.cursor_++);
+    }
+    if (other.free_ != nullptr) {
+      other.free_tail_->next_ = free_;
+      if (free_ == nullptr) {
+        free_tail_ = other.free_tail_;
+      }
+      free_ = other.free_;
+    }
+    capacity_ += other.capacity_;
+    if constexpr (Statistics) {
+      this->allocations_ += other.allocations_;
+      this->frees_ += other.frees_;
+      other.allocations_ = 0;
+      other.frees_ = 0;
+    }
+    other.Release();
+  }
+
+ private:
+  static constexpr size_type kFirstChunkSize = 16;
+  static constexpr size_type kMaxChunkSize = 4096;
+
+  union Slot {
+    Slot *next_;
+    alignas(T) unsigned char storage_[sizeof(T)];
+  };
+
+  // Chunks are kept sorted by address, so that HandOver finds the chunk of
+  // a slot by binary search.
+  using Chunk = std::shared_ptr<Slot>;
+
+  struct ChunkLess {
+    bool operator()(const Chunk &chunk1, const Chunk &chunk2) const noexcept {
+      return std::less<const Slot *>()(chunk1.get(), chunk2.get());
+    }
+  };
+
+  void AddShare(Chunk chunk) {
+    auto position =
+        std::lower_bound(chunks_.begin(), chunks_.end(), chunk, ChunkLess());
+    if (position == chunks_.end() || position->get() != chunk.get()) {
+      chunks_.insert(position, std::move(chunk));
+    }
+  }
+
+  void PushFree(Slot *slot) noexcept {
+    slot->next_ = free_;
+    if (free_ == nullptr) {
+      free_tail_ = slot;
+    }
+    free_ = slot;
+  }
+
+  void AddChunk() {
+    Chunk chunk(new Slot[next_chunk_size_], std::default_delete<Slot[]>());
+    cursor_ = chunk.get();
+    AddShare(std::move(chunk));
+    chunk_end_ = cursor_ + next_chunk_size_;
+    capacity_ += next_chunk_size_;
+    if (next_chunk_size_ < kMaxChunkSize) {
+      next_chunk_size_ *= 2;
+    }
+  }
+
+  std::vector<Chunk> chunks_;
+  Slot *free_ = nullptr;
+  Slot *free_tail_ = nullptr;
+  Slot *cursor_ = nullptr;
+  Slot *chunk_end_ = nullptr;
+  size_type capacity_ = 0;
+  size_type next_chunk_size_ = kFirstChunkSize;
+};
+
+}  // namespace s21
+
+#endif  // CONTAINERS_S21_NODE_POOL_H_
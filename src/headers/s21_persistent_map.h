@@ -0,0 +1,156 @@
+#ifndef CONTAINERS_S21_PERSISTENT_MAP_H_
+#define CONTAINERS_S21_PERSISTENT_MAP_H_
+
+#include <initializer_list>
+#include <stdexcept>
+
+#include "s21_persistent_tree.h"
+
+namespace s21 {
+template <class Key, class Type, class Compare>
+class rcu_map;
+
+// Map with O(1) snapshots on the copy-on-write engine. Copies share all
+// nodes until one side changes; then only the changed path is copied, so a
+// reader can keep a consistent snapshot() while a writer goes on modifying
+// the map, each in its own thread. Elements are immutable through
+// iterators: write mapped values with operator[], at() or insert_or_assign.
+template <class Key, class Type, class Compare = std::less<Key>>
+class persistent_map {
+ private:
+  struct KeyOfValue {
+    template <typename Pair>
+    const typename Pair::first_type &operator()(
+        const Pair &value) const noexcept {
+      return value.first;
+    }
+  };
+
+ public:
+  using key_type = Key;
+  using mapped_type = Type;
+  using value_type = std::pair<const key_type, mapped_type>;
+  using key_compare = Compare;
+  using reference = value_type &;
+  using const_reference = const value_type &;
+  using tree_type = persistent_tree<key_type, value_type, KeyOfValue, Compare>;
+  using iterator = typename tree_type::const_iterator;
+  using const_iterator = typename tree_type::const_iterator;
+  using size_type = std::size_t;
+
+  persistent_map() : tree_(new tree_type{}) {}
+
+  persistent_map(std::initializer_list<value_type> const &items)
+      : persistent_map(items.begin(), items.end()) {}
+
+  template <typename InputIt>
+  persistent_map(InputIt first, InputIt last) : persistent_map() {
+    for (; first != last; ++first) {
+      tree_->EmplaceUnique(first->first, *first);
+    }
+  }
+
+  persistent_map(const persistent_map &other)
+      : tree_(new tree_type(*other.tree_)) {}
+
+  persistent_map(persistent_map &&other) noexcept
+      : tree_(new tree_type(std::move(*other.tree_))) {}
+
+  persistent_map &operator=(const persistent_map &other) {
+    *tree_ = *other.tree_;
+    return *this;
+  }
+
+  persistent_map &operator=(persistent_map &&other) noexcept {
+    *tree_ = std::move(*other.tree_);
+    return *this;
+  }
+
+  ~persistent_map() {
+    delete tree_;
+    tree_ = nullptr;
+  }
+
+  // Returns the current version in O(1). Later changes to either map do not
+  // show in the other.
+  persistent_map snapshot() const { return *this; }
+
+  mapped_type &at(const key_type &key) {
+    value_type *value = tree_->MutableValue(key);
+    if (value == nullptr) {
+      throw std::out_of_range("there is no such key");
+    }
+    return value->second;
+  }
+
+  const mapped_type &at(const key_type &key) const {
+    const value_type *value = tree_->FindValue(key);
+    if (value == nullptr) {
+      throw std::out_of_range("there is no such key");
+    }
+    return value->second;
+  }
+
+  mapped_type &operator[](const key_type &key) {
+    value_type *value = tree_->MutableValue(key);
+    if (value == nullptr) {
+      tree_->EmplaceUnique(key, key, mapped_type{});
+      value = tree_->MutableValue(key);
+    }
+    return value->second;
+  }
+
+  const_iterator begin() const { return tree_->Begin(); }
+
+  const_iterator end() const noexcept { return tree_->End(); }
+
+  bool empty() const noexcept { return tree_->Empty(); }
+
+  size_type size() const noexcept { return tree_->Size(); }
+
+  size_type max_size() const noexcept { return tree_->MaxSize(); }
+
+  void clear() noexcept { tree_->Clear(); }
+
+  std::pair<iterator, bool> insert(const value_type &value) {
+    bool inserted = tree_->EmplaceUnique(value.first, value).second;
+    return {tree_->Find(value.first), inserted};
+  }
+
+  std::pair<iterator, bool> insert(const key_type &key,
+                                   const mapped_type &obj) {
+    bool inserted = tree_->EmplaceUnique(key, key, obj).second;
+    return {tree_->Find(key), inserted};
+  }
+
+  std::pair<iterator, bool> insert_or_assign(const key_type &key,
+                                             const mapped_type &obj) {
+    bool inserted = tree_->EmplaceUnique(key, key, obj).second;
+    if (!inserted) {
+      tree_->MutableValue(key)->second = obj;
+    }
+    return {tree_->Find(key), inserted};
+  }
+
+  // Removes the element with key, if any; returns how many were removed.
+  size_type erase(const key_type &key) { return tree_->Erase(key) ? 1 : 0; }
+
+  void swap(persistent_map &other) noexcept { tree_->Swap(*other.tree_); }
+
+  const_iterator find(const key_type &key) const { return tree_->Find(key); }
+
+  bool contains(const key_type &key) const { return tree_->Contains(key); }
+
+  size_type count(const key_type &key) const {
+    return tree_->Contains(key) ? 1 : 0;
+  }
+
+ private:
+  // Reads the versions it publishes without building iterators.
+  friend class rcu_map<Key, Type, Compare>;
+
+  tree_type *tree_;
+};
+}  // namespace s21
+
+#endif  // CONTAINERS_S21_PERSISTENT_MAP_H_
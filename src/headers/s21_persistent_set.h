@@ -0,0 +1,100 @@
+#ifndef CONTAINERS_S21_PERSISTENT_SET_H_
+#define CONTAINERS_S21_PERSISTENT_SET_H_
+
+#include <initializer_list>
+
+#include "s21_persistent_tree.h"
+
+namespace s21 {
+// Set with O(1) snapshots on the copy-on-write engine; see persistent_map.
+template <class Key, class Compare = std::less<Key>>
+class persistent_set {
+ private:
+  struct KeyOfValue {
+    const Key &operator()(const Key &value) const noexcept { return value; }
+  };
+
+ public:
+  using key_type = Key;
+  using value_type = key_type;
+  using key_compare = Compare;
+  using reference = value_type &;
+  using const_reference = const value_type &;
+  using tree_type = persistent_tree<key_type, value_type, KeyOfValue, Compare>;
+  using iterator = typename tree_type::const_iterator;
+  using const_iterator = typename tree_type::const_iterator;
+  using size_type = std::size_t;
+
+  persistent_set() : tree_(new tree_type{}) {}
+
+  persistent_set(std::initializer_list<value_type> const &items)
+      : persistent_set(items.begin(), items.end()) {}
+
+  template <typename InputIt>
+  persistent_set(InputIt first, InputIt last) : persistent_set() {
+    for (; first != last; ++first) {
+      tree_->EmplaceUnique(*first, *first);
+    }
+  }
+
+  persistent_set(const persistent_set &other)
+      : tree_(new tree_type(*other.tree_)) {}
+
+  persistent_set(persistent_set &&other) noexcept
+      : tree_(new tree_type(std::move(*other.tree_))) {}
+
+  persistent_set &operator=(const persistent_set &other) {
+    *tree_ = *other.tree_;
+    return *this;
+  }
+
+  persistent_set &operator=(persistent_set &&other) noexcept {
+    *tree_ = std::move(*other.tree_);
+    return *this;
+  }
+
+  ~persistent_set() {
+    delete tree_;
+    tree_ = nullptr;
+  }
+
+  // Returns the current version in O(1). Later changes to either set do not
+  // show in the other.
+  persistent_set snapshot() const { return *this; }
+
+  const_iterator begin() const { return tree_->Begin(); }
+
+  const_iterator end() const noexcept { return tree_->End(); }
+
+  bool empty() const noexcept { return tree_->Empty(); }
+
+  size_type size() const noexcept { return tree_->Size(); }
+
+  size_type max_size() const noexcept { return tree_->MaxSize(); }
+
+  void clear() noexcept { tree_->Clear(); }
+
+  std::pair<iterator, bool> insert(const value_type &value) {
+    bool inserted = tree_->EmplaceUnique(value, value).second;
+    return {tree_->Find(value), inserted};
+  }
+
+  // Removes key, if present; returns how many elements were removed.
+  size_type erase(const key_type &key) { return tree_->Erase(key) ? 1 : 0; }
+
+  void swap(persistent_set &other) noexcept { tree_->Swap(*other.tree_); }
+
+  const_iterator find(const key_type &key) const { return tree_->Find(key); }
+
+  bool contains(const key_type &key) const { return tree_->Contains(key); }
+
+  size_type count(const key_type &key) const {
+    return tree_->Contains(key) ? 1 : 0;
+  }
+
+ private:
+  tree_type *tree_;
+};
+}  // namespace s21
+
+#endif  // CONTAINERS_S21_PERSISTENT_SET_H_
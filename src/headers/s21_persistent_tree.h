@@ -0,0 +1,412 @@
+#ifndef CONTAINERS_S21_PERSISTENT_TREE_H_
+#define CONTAINERS_S21_PERSISTENT_TREE_H_
+
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace s21 {
+// Copy-on-write engine of persistent_map and persistent_set: a
+// weight-balanced tree whose nodes are reference counted and shared between
+// versions. Copying a tree is O(1). A modification copies the nodes on its
+// path that another version still references (O(log n) new nodes) and
+// changes uniquely owned nodes in place, so a tree without live copies
+// costs no more than an ordinary one.
+//
+// Nodes have no parent pointers, as a shared node has one parent per
+// version. One tree object is not synchronized, but distinct trees sharing
+// nodes may be read, modified and destroyed from different threads: the
+// reference counts are atomic and a shared node is never written to.
+template <typename Key, typename Value, typename KeyOfValue,
+          typename Comparison = std::less<Key>>
+class persistent_tree {
+ private:
+  struct Node;
+
+ public:
+  class Iterator;
+
+  using key_type = Key;
+  using value_type = Value;
+  using reference = value_type &;
+  using const_reference = const value_type &;
+  using const_iterator = Iterator;
+  using size_type = std::size_t;
+
+  persistent_tree() : root_(nullptr) {}
+
+  persistent_tree(const persistent_tree &other) : root_(Retain(other.root_)) {}
+
+  persistent_tree(persistent_tree &&other) noexcept : root_(other.root_) {
+    other.root_ = nullptr;
+  }
+
+  persistent_tree &operator=(const persistent_tree &other) {
+    if (this != &other) {
+      Node *root = Retain(other.root_);
+      Release(root_);
+      root_ = root;
+    }
+    return *this;
+  }
+
+  persistent_tree &operator=(persistent_tree &&other) noexcept {
+    if (this != &other) {
+      Release(root_);
+      root_ = other.root_;
+      other.root_ = nullptr;
+    }
+    return *this;
+  }
+
+  ~persistent_tree() { Release(root_); }
+
+  void Clear() noexcept {
+    Release(root_);
+    root_ = nullptr;
+  }
+
+  size_type Size() const noexcept { return SubtreeSize(root_); }
+
+  bool Empty() const noexcept { return root_ == nullptr; }
+
+  size_type MaxSize() const noexcept {
+    return std::numeric_limits<size_type>::max() / sizeof(Node);
+  }
+
+  const_iterator Begin() const { return Iterator(root_); }
+
+  const_iterator End() const noexcept { return Iterator(); }
+
+  const_iterator Find(const key_type &key) const {
+    Iterator it;
+    for (Node *node = root_; node != nullptr;) {
+      it.path_.push_back(node);
+      if (cmp_(key, KeyOf(node))) {
+        node = node->left_;
+      } else if (cmp_(KeyOf(node), key)) {
+        it.path_.pop_back();
+        node = node->right_;
+      } else {
+        return it;
+      }
+    }
+    return Iterator();
+  }
+
+  const value_type *FindValue(const key_type &key) const noexcept {
+    const Node *node = FindNode(key);
+    return node != nullptr ? &node->value_ : nullptr;
+  }
+
+  bool Contains(const key_type &key) const noexcept {
+    return FindNode(key) != nullptr;
+  }
+
+  // Constructs a value from args unless its key is present already. Returns
+  // the value with the key and whether it was inserted; the pointer stays
+  // valid until this tree is modified again.
+  template <typename... Args>
+  std::pair<const value_type *, bool> EmplaceUnique(const key_type &key,
+                                                    Args &&...args) {
+    if (const value_type *value = FindValue(key)) {
+      return {value, false};
+    }
+    return {Insert(root_, key, std::forward<Args>(args)...), true};
+  }
+
+  // Returns the value with key, copying the shared nodes on its path so
+  // that it can be written to, or nullptr when there is no such key.
+  value_type *MutableValue(const key_type &key) {
+    if (!Contains(key)) {
+      return nullptr;
+    }
+    Node **link = &root_;
+    while (true) {
+      Node *node = *link = Unique(*link);
+      if (cmp_(key, KeyOf(node))) {
+        link = &node->left_;
+      } else if (cmp_(KeyOf(node), key)) {
+        link = &node->right_;
+      } else {
+        return &node->value_;
+      }
+    }
+  }
+
+  bool Erase(const key_type &key) {
+    if (!Contains(key)) {
+      return false;
+    }
+    Erase(root_, key);
+    return true;
+  }
+
+  void Swap(persistent_tree &other) noexcept {
+    std::swap(root_, other.root_);
+    std::swap(cmp_, other.cmp_);
+  }
+
+  // Whether both trees are the same version: true for a copy that neither
+  // side has modified since.
+  bool Shares(const persistent_tree &other) const noexcept {
+    return root_ == other.root_;
+  }
+
+  // In-order iterator. It keeps the path from the root, so it stays valid as
+  // long as the tree it came from is not modified; iterators of a copy that
+  // nobody modifies never go stale.
+  class Iterator {
+   public:
+    using iterator_category = std::forward_iterator_tag;
+    using difference_type = std::ptrdiff_t;
+    using value_type = persistent_tree::value_type;
+    using pointer = const value_type *;
+    using reference = const value_type &;
+
+    Iterator() = default;
+
+    reference operator*() const noexcept { return path_.back()->value_; }
+
+    pointer operator->() const noexcept { return &path_.back()->value_; }
+
+    Iterator &operator++() {
+      const Node *node = path_.back()->right_;
+      path_.pop_back();
+      PushLeftSpine(node);
+      return *this;
+    }
+
+    Iterator operator++(int) {
+      Iterator previous = *this;
+      ++*this;
+      return previous;
+    }
+
+    bool operator==(const Iterator &other) const noexcept {
+      return path_.empty() ? other.path_.empty()
+                           : !other.path_.empty() &&
+                                 path_.back() == other.path_.back();
+    }
+
+    bool operator!=(const Iterator &other) const noexcept {
+      return !(*this == other);
+    }
+
+   private:
+    friend class persistent_tree;
+
+    explicit Iterator(const Node *root) { PushLeftSpine(root); }
+
+    void PushLeftSpine(const Node *node) {
+      for (; node != nullptr; node = node->left_) {
+        path_.push_back(node);
+      }
+    }
+
+    // Ancestors still to be visited, the current node last.
+    std::vector<const Node *> path_;
+  };
+
+ private:
+  // Balance parameters of Adams' weight-balanced trees as tuned by Straka:
+  // a subtree may outweigh its sibling kDelta times, and a single rotation
+  // is used while the inner grandchild weighs less than kRatio times the
+  // outer one.
+  static constexpr size_type kDelta = 3;
+  static constexpr size_type kRatio = 2;
+
+  struct Node {
+    template <typename... Args>
+    explicit Node(std::in_place_t, Args &&...args)
+        : refs_(1),
+          size_(1),
+          left_(nullptr),
+          right_(nullptr),
+          value_(std::forward<Args>(args)...) {}
+
+    // Shares the children of other; they are retained only once value_ is
+    // copied, as that may throw.
+    Node(const Node &other)
+        : refs_(1),
+          size_(other.size_),
+          left_(other.left_),
+          right_(other.right_),
+          value_(other.value_) {
+      Retain(left_);
+      Retain(right_);
+    }
+
+    std::atomic<size_type> refs_;
+    size_type size_;
+    Node *left_;
+    Node *right_;
+    value_type value_;
+  };
+
+  const key_type &KeyOf(const Node *node) const noexcept {
+    return KeyOfValue()(node->value_);
+  }
+
+  const Node *FindNode(const key_type &key) const noexcept {
+    const Node *node = root_;
+    while (node != nullptr) {
+      if (cmp_(key, KeyOf(node))) {
+        node = node->left_;
+      } else if (cmp_(KeyOf(node), key)) {
+        node = node->right_;
+      } else {
+        break;
+      }
+    }
+    return node;
+  }
+
+  static size_type SubtreeSize(const Node *node) noexcept {
+    return node != nullptr ? node->size_ : 0;
+  }
+
+  static Node *Retain(Node *node) noexcept {
+    if (node != nullptr) {
+      node->refs_.fetch_add(1, std::memory_order_relaxed);
+    }
+    return node;
+  }
+
+  // Drops one reference and frees the nodes nobody references any more.
+  // Recursion is bounded by the tree height.
+  static void Release(Node *node) noexcept {
+    if (node != nullptr &&
+        node->refs_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+      Release(node->left_);
+      Release(node->right_);
+      delete node;
+    }
+  }
+
+  // Takes over one reference to node and returns a node that only the
+  // caller references: node itself when it is not shared, a copy otherwise.
+  static Node *Unique(Node *node) {
+    if (node->refs_.load(std::memory_order_acquire) == 1) {
+      return node;
+    }
+    Node *copy = new Node(*node);
+    Release(node);
+    return copy;
+  }
+
+  // The recursive operations below work on the link to a subtree. Each node
+  // on the way down is made unique before anything changes below it, so
+  // when an allocation fails the tree is left as it was.
+  template <typename... Args>
+  value_type *Insert(Node *&link, const key_type &key, Args &&...args) {
+    if (link == nullptr) {
+      link = new Node(std::in_place, std::forward<Args>(args)...);
+      return &link->value_;
+    }
+    Node *node = link = Unique(link);
+    value_type *inserted =
+        cmp_(key, KeyOf(node))
+            ? Insert(node->left_, key, std::forward<Args>(args)...)
+            : Insert(node->right_, key, std::forward<Args>(args)...);
+    link = Balance(node);
+    return inserted;
+  }
+
+  void Erase(Node *&link, const key_type &key) {
+    Node *node = link = Unique(link);
+    if (cmp_(key, KeyOf(node))) {
+      Erase(node->left_, key);
+    } else if (cmp_(KeyOf(node), key)) {
+      Erase(node->right_, key);
+    } else if (node->left_ == nullptr || node->right_ == nullptr) {
+      link = node->left_ != nullptr ? node->left_ : node->right_;
+      delete node;
+      return;
+    } else {
+      Node *successor = ExtractMin(node->right_);
+      successor->left_ = node->left_;
+      successor->right_ = node->right_;
+      delete node;
+      node = successor;
+    }
+    link = Balance(node);
+  }
+
+  // Unlinks the leftmost node of a subtree and returns it unshared.
+  static Node *ExtractMin(Node *&link) {
+    Node *node = link = Unique(link);
+    if (node->left_ == nullptr) {
+      link = node->right_;
+      node->right_ = nullptr;
+      return node;
+    }
+    Node *min = ExtractMin(node->left_);
+    link = Balance(node);
+    return min;
+  }
+
+  // Restores the weight balance of an unshared node after one of its
+  // subtrees gained or lost a single element. The rotations may have to
+  // copy a shared child; should that fail, the node stays a little out of
+  // balance, which costs time but no correctness.
+  static Node *Balance(Node *node) noexcept {
+    Update(node);
+    size_type left = SubtreeSize(node->left_);
+    size_type right = SubtreeSize(node->right_);
+    if (left + right < 2) {
+      return node;
+    }
+    try {
+      if (right > kDelta * left) {
+        Node *child = node->right_ = Unique(node->right_);
+        if (SubtreeSize(child->left_) >= kRatio * SubtreeSize(child->right_)) {
+          node->right_ = RotateRight(child);
+        }
+        return RotateLeft(node);
+      }
+      if (left > kDelta * right) {
+        Node *child = node->left_ = Unique(node->left_);
+        if (SubtreeSize(child->right_) >= kRatio * SubtreeSize(child->left_)) {
+          node->left_ = RotateLeft(child);
+        }
+        return RotateRight(node);
+      }
+    } catch (...) {
+    }
+    return node;
+  }
+
+  static Node *RotateLeft(Node *node) {
+    Node *pivot = node->right_ = Unique(node->right_);
+    node->right_ = pivot->left_;
+    pivot->left_ = node;
+    Update(node);
+    Update(pivot);
+    return pivot;
+  }
+
+  static Node *RotateRight(Node *node) {
+    Node *pivot = node->left_ = Unique(node->left_);
+    node->left_ = pivot->right_;
+    pivot->right_ = node;
+    Update(node);
+    Update(pivot);
+    return pivot;
+  }
+
+  static void Update(Node *node) noexcept {
+    node->size_ = SubtreeSize(node->left_) + SubtreeSize(node->right_) + 1;
+  }
+
+  Node *root_;
+  Comparison cmp_;
+};
+
+}  // namespace s21
+
+#endif  // CONTAINERS_S21_PERSISTENT_TREE_H_
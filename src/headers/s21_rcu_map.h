@@ -0,0 +1,138 @@
+#ifndef CONTAINERS_S21_RCU_MAP_H_
+#define CONTAINERS_S21_RCU_MAP_H_
+
+#include <atomic>
+#include <initializer_list>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+
+#include "s21_epoch.h"
+#include "s21_persistent_map.h"
+
+namespace s21 {
+// Map for many readers and few writers. Readers take no lock and write no
+// shared memory besides their epoch slot: they load the published version
+// and search it. A writer builds the next version by path copying on a
+// persistent_map that shares all other nodes with the current one, swaps it
+// in with one atomic store and retires the old version to the shared
+// epoch_domain, which frees it when no reader can still be in it.
+//
+// Writers are serialized by a mutex. update() applies several changes as
+// one version, which is cheaper than publishing each of them.
+template <class Key, class Type, class Compare = std::less<Key>>
+class rcu_map {
+ public:
+  using key_type = Key;
+  using mapped_type = Type;
+  using value_type = std::pair<const key_type, mapped_type>;
+  using key_compare = Compare;
+  using version_type = persistent_map<key_type, mapped_type, key_compare>;
+  using size_type = std::size_t;
+
+  rcu_map() : version_(new version_type{}) {}
+
+  rcu_map(std::initializer_list<value_type> const &items)
+      : version_(new version_type(items)) {}
+
+  rcu_map(const rcu_map &) = delete;
+
+  rcu_map &operator=(const rcu_map &) = delete;
+
+  // Readers must be done with the map by now, so the last version is freed
+  // right away. Retired versions share nodes with it only by reference.
+  ~rcu_map() { delete version_.load(std::memory_order_relaxed); }
+
+  bool contains(const key_type &key) const {
+    epoch_domain::guard guard(Domain());
+    return Current()->tree_->Contains(key);
+  }
+
+  // Returns a copy: the element may be gone as soon as the call returns.
+  mapped_type at(const key_type &key) const {
+    epoch_domain::guard guard(Domain());
+    const value_type *value = Current()->tree_->FindValue(key);
+    if (value == nullptr) {
+      throw std::out_of_range("there is no such key");
+    }
+    return value->second;
+  }
+
+  std::optional<mapped_type> find(const key_type &key) const {
+    epoch_domain::guard guard(Domain());
+    const value_type *value = Current()->tree_->FindValue(key);
+    if (value == nullptr) {
+      return std::nullopt;
+    }
+    return value->second;
+  }
+
+  size_type size() const {
+    epoch_domain::guard guard(Domain());
+    return Current()->size();
+  }
+
+  bool empty() const { return size() == 0; }
+
+  // Calls function on every element in key order, all from one version.
+  // Function must not modify this map.
+  template <typename Function>
+  void for_each(Function function) const {
+    epoch_domain::guard guard(Domain());
+    for (const value_type &item : *Current()) {
+      function(item);
+    }
+  }
+
+  // Returns the current version, which stays valid and unchanged for as long
+  // as the caller keeps it. Costs one atomic increment on the root node.
+  version_type snapshot() const {
+    epoch_domain::guard guard(Domain());
+    return *Current();
+  }
+
+  bool insert(const key_type &key, const mapped_type &obj) {
+    bool inserted = false;
+    update([&](version_type &map) { inserted = map.insert(key, obj).second; });
+    return inserted;
+  }
+
+  void insert_or_assign(const key_type &key, const mapped_type &obj) {
+    update([&](version_type &map) { map.insert_or_assign(key, obj); });
+  }
+
+  size_type erase(const key_type &key) {
+    size_type erased = 0;
+    update([&](version_type &map) { erased = map.erase(key); });
+    return erased;
+  }
+
+  void clear() {
+    update([](version_type &map) { map.clear(); });
+  }
+
+  // Applies function to a private copy of the current version and publishes
+  // the result. Readers see either none or all of its changes.
+  template <typename Function>
+  void update(Function function) {
+    std::lock_guard<std::mutex> lock(writer_mutex_);
+    version_type *current = version_.load(std::memory_order_relaxed);
+    std::unique_ptr<version_type> next(new version_type(*current));
+    function(*next);
+    version_.store(next.release());
+    Domain().Retire(current);
+  }
+
+ private:
+  static epoch_domain &Domain() { return epoch_domain::Shared(); }
+
+  const version_type *Current() const { return version_.load(); }
+
+  std::atomic<version_type *> version_;
+  std::mutex writer_mutex_;
+};
+
+}  // namespace s21
+
+#endif  // CONTAINERS_S21_RCU_MAP_H_
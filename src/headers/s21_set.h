@@ -1,27 +1,64 @@
 #ifndef CONTAINERS_S21_SET_H_
 #define CONTAINERS_S21_SET_H_
 
+#include <iterator>
+#include <string>
+
+#include "s21_frozen_set.h"
 #include "s21_tree.h"
 
 namespace s21 {
-template <class Key>
+template <class Key, class Compare = std::less<Key>,
+          class Traits = tree_traits>
+class set;
+
+template <class Key, class Compare, class Traits>
+set<Key, Compare, Traits> set_union(
+    const set<Key, Compare, Traits> &first,
+    const set<Key, Compare, Traits> &second,
+    thread_pool &threads = thread_pool::Shared());
+
+template <class Key, class Compare, class Traits>
+set<Key, Compare, Traits> set_intersection(
+    const set<Key, Compare, Traits> &first,
+    const set<Key, Compare, Traits> &second,
+    thread_pool &threads = thread_pool::Shared());
+
+template <class Key, class Compare, class Traits>
+set<Key, Compare, Traits> set_difference(
+    const set<Key, Compare, Traits> &first,
+    const set<Key, Compare, Traits> &second,
+    thread_pool &threads = thread_pool::Shared());
+
+// A transparent Compare such as std::less<> enables lookups by key-like
+// types. Traits selects optional tree bookkeeping; order_statistics_traits
+// enables nth() and rank(), statistics_traits enables stats() and
+// threaded_traits makes iterator steps O(1).
+template <class Key, class Compare, class Traits>
 class set {
  public:
   using key_type = Key;
   using value_type = key_type;
+  using key_compare = Compare;
   using reference = value_type &;
   using const_reference = const value_type &;
-  using tree_type = tree<value_type>;
+  using tree_type = tree<value_type, key_compare, Traits>;
   using iterator = typename tree_type::iterator;
   using const_iterator = typename tree_type::const_iterator;
+  using reverse_iterator = std::reverse_iterator<iterator>;
+  using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+  using node_type = typename tree_type::node_type;
+  using insert_return_type = typename tree_type::insert_return_type;
   using size_type = std::size_t;
 
   set() : tree_(new tree_type{}) {}
 
-  set(std::initializer_list<value_type> const &items) : set() {
-    for (auto item : items) {
-      insert(item);
-    }
+  set(std::initializer_list<value_type> const &items)
+      : set(items.begin(), items.end()) {}
+
+  template <typename InputIt>
+  set(InputIt first, InputIt last) : set() {
+    tree_->InsertRangeUnique(first, last);
   }
 
   set(const set &other) : tree_(new tree_type(*other.tree_)) {}
@@ -51,6 +88,18 @@ class set {
 
   const_iterator end() const noexcept { return tree_->End(); }
 
+  reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+
+  const_reverse_iterator rbegin() const noexcept {
+    return const_reverse_iterator(end());
+  }
+
+  reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+
+  const_reverse_iterator rend() const noexcept {
+    return const_reverse_iterator(begin());
+  }
+
   bool empty() const noexcept { return tree_->Empty(); }
 
   size_type size() const noexcept { return tree_->Size(); }
@@ -59,15 +108,62 @@ class set {
 
   void clear() noexcept { tree_->Clear(); }
 
+  // Replaces the content with an already sorted range in linear time.
+  template <typename ForwardIt>
+  void assign_sorted(ForwardIt first, ForwardIt last) {
+    tree_->AssignSortedUnique(first, last);
+  }
+
   std::pair<iterator, bool> insert(const value_type &value) {
     return tree_->InsertUnique(value);
   }
 
+  // Amortized O(1) when value belongs right before hint, e.g. end() for
+  // ascending input.
+  iterator insert(const_iterator hint, const value_type &value) {
+    return tree_->InsertUniqueHint(hint, value).first;
+  }
+
+  template <typename... Args>
+  iterator emplace_hint(const_iterator hint, Args &&...args) {
+    return tree_->EmplaceUniqueHint(hint, std::forward<Args>(args)...).first;
+  }
+
+  // Unlinks an element without freeing it; see insert(node_type &&).
+  node_type extract(iterator pos) noexcept { return tree_->Extract(pos); }
+
+  node_type extract(const key_type &key) noexcept {
+    return tree_->Extract(key);
+  }
+
+  // Links an extracted node in without allocating. If its key is present
+  // already, the node is handed back in the result.
+  insert_return_type insert(node_type &&node) {
+    return tree_->InsertNode(std::move(node), true);
+  }
+
   void erase(iterator pos) noexcept { tree_->Erase(pos); }
 
+  // Removes [first, last) in O(log n) plus the cost of destroying the
+  // elements; returns last.
+  iterator erase(iterator first, iterator last) noexcept {
+    tree_->Erase(first, last);
+    return last;
+  }
+
+  // Removes the elements equal to key; returns how many there were.
+  size_type erase(const key_type &key) noexcept { return tree_->Erase(key); }
+
+  // Removes the elements for which predicate returns true in one pass;
+  // returns how many there were.
+  template <typename Predicate>
+  size_type erase_if(Predicate predicate) {
+    return tree_->EraseIf(predicate);
+  }
+
   void swap(set &other) noexcept { tree_->Swap(*other.tree_); }
 
-  void merge(set &other) noexcept { tree_->MergeUnique(*other.tree_); }
+  void merge(set &other) { tree_->MergeUnique(*other.tree_); }
 
   iterator find(const key_type &key) noexcept { return tree_->Find(key); }
 
@@ -79,15 +175,148 @@ class set {
     return tree_->Find(key) != tree_->End();
   }
 
+  // The results of find() or contains() for every key of [first, last),
+  // written to out in order. Faster than one call per key on trees larger
+  // than the cache, as the lookups overlap their cache misses.
+  template <typename ForwardIt, typename OutputIt>
+  OutputIt find_batch(ForwardIt first, ForwardIt last, OutputIt out) {
+    return tree_->FindBatch(first, last, out);
+  }
+
+  template <typename ForwardIt, typename OutputIt>
+  OutputIt find_batch(ForwardIt first, ForwardIt last, OutputIt out) const {
+    return tree_->FindBatch(first, last, out);
+  }
+
+  template <typename ForwardIt, typename OutputIt>
+  OutputIt contains_batch(ForwardIt first, ForwardIt last,
+                          OutputIt out) const {
+    return tree_->ContainsBatch(first, last, out);
+  }
+
+  size_type count(const key_type &key) const { return tree_->Count(key); }
+
+  // Element at the given position in key order, end() if there is none.
+  iterator nth(size_type index) noexcept { return tree_->Select(index); }
+
+  const_iterator nth(size_type index) const noexcept {
+    return tree_->Select(index);
+  }
+
+  // Number of elements less than key.
+  size_type rank(const key_type &key) const noexcept {
+    return tree_->Rank(key);
+  }
+
+  // Operation counts and depth histogram of the tree, see tree::Stats.
+  // Needs statistics_traits.
+  tree_stats stats() const { return tree_->Stats(); }
+
+  // Read-only copy laid out for fast lookups; see frozen_set.
+  frozen_set<key_type, key_compare> freeze() const {
+    return frozen_set<key_type, key_compare>(begin(), size());
+  }
+
+  // Writes a versioned binary image of the set to path in O(n), without a
+  // frozen copy. Keys must be trivially copyable. Images need
+  // s21_frozen_image.h, for this and open_mapped().
+  void save(const std::string &path) const {
+    frozen_set<key_type, key_compare>::tree_type::Save(path, begin(), size());
+  }
+
+  // Maps an image written by save() and serves lookups and iteration from
+  // it directly, so reloading costs O(1) instead of n inserts. Throws
+  // std::system_error or std::runtime_error if path is not such an image.
+  static frozen_set<key_type, key_compare> open_mapped(
+      const std::string &path) {
+    return frozen_set<key_type, key_compare>::open_mapped(path);
+  }
+
+  // Lookups by key-like types, available with a transparent Compare.
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  iterator find(const K &key) {
+    return tree_->Find(key);
+  }
+
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  const_iterator find(const K &key) const {
+    return tree_->Find(key);
+  }
+
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  bool contains(const K &key) const {
+    return tree_->Find(key) != tree_->End();
+  }
+
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  size_type count(const K &key) const {
+    return tree_->Count(key);
+  }
+
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  size_type rank(const K &key) const {
+    return tree_->Rank(key);
+  }
+
+  // Inserts one element per argument, each constructed in its node from
+  // the argument; an argument that is a key_type present already costs no
+  // allocation. emplace_hint constructs a single element from several
+  // arguments.
   template <typename... Args>
   std::vector<std::pair<iterator, bool>> emplace(Args &&...args) {
     return tree_->EmplaceUnique(std::forward<Args>(args)...);
   }
 
+  friend set set_union<>(const set &first, const set &second,
+                         thread_pool &threads);
+
+  friend set set_intersection<>(const set &first, const set &second,
+                                thread_pool &threads);
+
+  friend set set_difference<>(const set &first, const set &second,
+                              thread_pool &threads);
+
  private:
+  explicit set(tree_type &&tree) : tree_(new tree_type(std::move(tree))) {}
+
   tree_type *tree_;
 };
 
+// Keys present in first or second.
+template <class Key, class Compare, class Traits>
+set<Key, Compare, Traits> set_union(const set<Key, Compare, Traits> &first,
+                                    const set<Key, Compare, Traits> &second,
+                                    thread_pool &threads) {
+  using result_type = set<Key, Compare, Traits>;
+  return result_type(result_type::tree_type::Union(*first.tree_,
+                                                   *second.tree_, threads));
+}
+
+// Keys present in both first and second.
+template <class Key, class Compare, class Traits>
+set<Key, Compare, Traits> set_intersection(
+    const set<Key, Compare, Traits> &first,
+    const set<Key, Compare, Traits> &second, thread_pool &threads) {
+  using result_type = set<Key, Compare, Traits>;
+  return result_type(result_type::tree_type::Intersection(
+      *first.tree_, *second.tree_, threads));
+}
+
+// Keys of first that are not present in second.
+template <class Key, class Compare, class Traits>
+set<Key, Compare, Traits> set_difference(
+    const set<Key, Compare, Traits> &first,
+    const set<Key, Compare, Traits> &second, thread_pool &threads) {
+  using result_type = set<Key, Compare, Traits>;
+  return result_type(result_type::tree_type::Difference(
+      *first.tree_, *second.tree_, threads));
+}
+
 }  // namespace s21
 
 #endif  // CONTAINERS_S21_SET_H_
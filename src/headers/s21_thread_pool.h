@@ -0,0 +1,210 @@
+#ifndef CONTAINERS_S21_THREAD_POOL_H_
+#define CONTAINERS_S21_THREAD_POOL_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace s21 {
+// Fixed-size pool of worker threads for fork-join parallelism. The calling
+// thread counts as one of Size() threads. A worker waiting for a forked task
+// runs other queued ones meanwhile, so nested Invoke calls never deadlock;
+// outside threads only wait, which keeps ThisThreadIndex() unique among the
+// threads working on one fork-join tree.
+class thread_pool {
+ public:
+  using size_type = std::size_t;
+
+  explicit thread_pool(size_type threads = DefaultSize()) {
+    for (size_type index = 1; index < threads; ++index) {
+      workers_.emplace_back([this, index] { WorkerLoop(index); });
+    }
+  }
+
+  thread_pool(const thread_pool &) = delete;
+
+  thread_pool &operator=(const thread_pool &) = delete;
+
+  ~thread_pool() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stopping_ = true;
+    }
+    wake_.notify_all();
+    for (std::thread &worker : workers_) {
+      worker.join();
+    }
+  }
+
+  size_type Size() const noexcept { return workers_.size() + 1; }
+
+  // Index of the current thread in [0, Size()): workers are numbered from 1,
+  // any thread outside the pool is 0.
+  size_type ThisThreadIndex() const noexcept {
+    return current_pool_ == this ? current_index_ : 0;
+  }
+
+  // Runs left and right, possibly in parallel, and returns when both are
+  // done. An exception thrown by either of them is rethrown afterwards.
+  template <typename Left, typename Right>
+  void Invoke(Left &&left, Right &&right) {
+    if (workers_.empty()) {
+      left();
+      right();
+      return;
+    }
+    using right_type = std::remove_reference_t<Right>;
+    Task task{&Call<right_type>, const_cast<void *>(static_cast<const void *>(
+                                     std::addressof(right)))};
+    Push(&task);
+    std::exception_ptr left_error;
+    try {
+      left();
+    } catch (...) {
+      left_error = std::current_exception();
+    }
+    if (Remove(&task)) {
+      Run(&task);
+    } else {
+      while (!task.done_.load(std::memory_order_acquire)) {
+        if (current_pool_ != this || !RunOne()) {
+          std::this_thread::yield();
+        }
+      }
+    }
+    if (left_error) {
+      std::rethrow_exception(left_error);
+    }
+    if (task.error_) {
+      std::rethrow_exception(task.error_);
+    }
+  }
+
+  // Process-wide pool sized to the hardware, used when no pool is given.
+  static thread_pool &Shared();
+
+  // The shared pool if Shared() has constructed it and it is not destroyed
+  // yet, nullptr otherwise. For code that may neither start threads nor run
+  // after the pool is gone, such as destructors of static containers.
+  static thread_pool *SharedIfAlive() noexcept {
+    return shared_.load(std::memory_order_acquire);
+  }
+
+  static size_type DefaultSize() noexcept {
+    size_type threads = std::thread::hardware_concurrency();
+    return threads > 0 ? threads : 1;
+  }
+
+ private:
+  struct Task {
+    Task(void (*call)(void *), void *function)
+        : call_(call), function_(function) {}
+
+    void (*call_)(void *);
+    void *function_;
+    std::exception_ptr error_;
+    std::atomic<bool> done_{false};
+  };
+
+  template <typename Function>
+  static void Call(void *function) {
+    (*static_cast<Function *>(function))();
+  }
+
+  static void Run(Task *task) noexcept {
+    try {
+      task->call_(task->function_);
+    } catch (...) {
+      task->error_ = std::current_exception();
+    }
+    task->done_.store(true, std::memory_order_release);
+  }
+
+  void Push(Task *task) {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      tasks_.push_back(task);
+    }
+    wake_.notify_one();
+  }
+
+  bool Remove(Task *task) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto it = tasks_.rbegin(); it != tasks_.rend(); ++it) {
+      if (*it == task) {
+        tasks_.erase(std::next(it).base());
+        return true;
+      }
+    }
+    return false;
+  }
+
+  bool RunOne() {
+    Task *task = nullptr;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (tasks_.empty()) {
+        return false;
+      }
+      task = tasks_.front();
+      tasks_.pop_front();
+    }
+    Run(task);
+    return true;
+  }
+
+  void WorkerLoop(size_type index) {
+    current_pool_ = this;
+    current_index_ = index;
+    while (true) {
+      Task *task = nullptr;
+      {
+        std::unique_lock<std::mutex> lock(mutex_);
+        wake_.wait(lock, [this] { return stopping_ || !tasks_.empty(); });
+        if (tasks_.empty()) {
+          return;
+        }
+        task = tasks_.front();
+        tasks_.pop_front();
+      }
+      Run(task);
+    }
+  }
+
+  // Publishes the shared pool for SharedIfAlive while it exists.
+  struct SharedPool;
+
+  static inline std::atomic<thread_pool *> shared_{nullptr};
+  static inline thread_local const thread_pool *current_pool_ = nullptr;
+  static inline thread_local size_type current_index_ = 0;
+
+  std::vector<std::thread> workers_;
+  std::deque<Task *> tasks_;
+  std::mutex mutex_;
+  std::condition_variable wake_;
+  bool stopping_ = false;
+};
+
+struct thread_pool::SharedPool {
+  SharedPool() { shared_.store(&pool_, std::memory_order_release); }
+
+  ~SharedPool() { shared_.store(nullptr, std::memory_order_release); }
+
+  thread_pool pool_;
+};
+
+inline thread_pool &thread_pool::Shared() {
+  static SharedPool shared;
+  return shared.pool_;
+}
+
+}  // namespace s21
+
+#endif  // CONTAINERS_S21_THREAD_POOL_H_
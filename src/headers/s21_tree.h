@@ -1,265 +1,2073 @@
 #ifndef CONTAINERS_S21_TREE_H_
 #define CONTAINERS_S21_TREE_H_
 
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
 #include <functional>
+#include <iterator>
 #include <limits>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
+#include "s21_node_pool.h"
+#include "s21_thread_pool.h"
+
 namespace s21 {
 enum color { black, red };
 
-template <typename Key, typename Comparison = std::less<Key>>
+// Compile-time options of s21::tree. Derive from it and override a member to
+// switch optional per-node bookkeeping on.
+struct tree_traits {
+  // Keeps the subtree size in every node: Select, Rank and Count become
+  // O(log n) at the price of one word per node.
+  static constexpr bool kOrderStatistics = false;
+  // Packs the node color into the parent pointer, see tree_node_links.
+  static constexpr bool kCompactNodes = false;
+  // Monoid whose value over its subtree every node keeps, see
+  // summary_traits. void keeps none.
+  using summary_type = void;
+  // Counts what the tree does, see tree::Stats.
+  static constexpr bool kStatistics = false;
+  // Chains the nodes in key order, see tree_node_thread.
+  static constexpr bool kThreaded = false;
+  // Makes multiset store equal keys once, see its counted specialization.
+  // The tree itself ignores it.
+  static constexpr bool kCounted = false;
+};
+
+struct order_statistics_traits : tree_traits {
+  static constexpr bool kOrderStatistics = true;
+};
+
+struct compact_traits : tree_traits {
+  static constexpr bool kCompactNodes = true;
+};
+
+struct statistics_traits : tree_traits {
+  static constexpr bool kStatistics = true;
+};
+
+struct threaded_traits : tree_traits {
+  static constexpr bool kThreaded = true;
+};
+
+// What a tree with kStatistics did since it was constructed, and its
+// current shape.
+struct tree_stats {
+  std::size_t comparisons = 0;
+  std::size_t rotations = 0;
+  std::size_t recolorings = 0;
+  std::size_t allocations = 0;
+  std::size_t frees = 0;
+  // Times erasing the first or last element had to find its successor.
+  std::size_t extreme_updates = 0;
+  // Number of elements at each depth, the root being at depth 0.
+  std::vector<std::size_t> depth_histogram;
+};
+
+// Comparator of a tree with kStatistics: calls Comparison and holds the
+// counters of the tree, so trees without statistics keep a plain
+// Comparison and pay nothing. The counters are relaxed atomics, as const
+// lookups and parallel set operations count concurrently. Copies take the
+// comparison but not the counts; Swap exchanges both, so that the counts
+// stay with the elements when trees are swapped or moved.
+template <typename Comparison>
+class statistics_comparison {
+ public:
+  enum counter {
+    kComparisons,
+    kRotations,
+    kRecolorings,
+    kExtremeUpdates,
+    kCounters
+  };
+
+  statistics_comparison() = default;
+
+  statistics_comparison(const statistics_comparison &other)
+      : compare_(other.compare_) {}
+
+  statistics_comparison &operator=(const statistics_comparison &other) {
+    compare_ = other.compare_;
+    return *this;
+  }
+
+  template <typename Left, typename Right>
+  bool operator()(const Left &left, const Right &right) const {
+    Add(kComparisons);
+    return compare_(left, right);
+  }
+
+  void Add(counter which, std::size_t amount = 1) const noexcept {
+    counts_[which].fetch_add(amount, std::memory_order_relaxed);
+  }
+
+  std::size_t Get(counter which) const noexcept {
+    return counts_[which].load(std::memory_order_relaxed);
+  }
+
+  void Swap(statistics_comparison &other) noexcept {
+    std::swap(compare_, other.compare_);
+    for (int which = 0; which < kCounters; ++which) {
+      std::size_t count = counts_[which].load(std::memory_order_relaxed);
+      counts_[which].store(other.counts_[which].load(std::memory_order_relaxed),
+                           std::memory_order_relaxed);
+      other.counts_[which].store(count, std::memory_order_relaxed);
+    }
+  }
+
+ private:
+  Comparison compare_;
+  mutable std::atomic<std::size_t> counts_[kCounters] = {};
+};
+
+// Keeps Summary over the subtree of every node, which makes Aggregate over a
+// key range O(log n). Summary describes a monoid over the elements:
+//
+//   struct Summary {
+//     using value_type = ...;
+//     static value_type Identity();
+//     static value_type Of(const Element &element);
+//     static value_type Combine(const value_type &left,
+//                               const value_type &right);
+//   };
+//
+// Combine must be associative with Identity as its neutral element; it need
+// not be commutative. None of them may throw. The summary of an element is
+// taken when it is linked in, so an element changed in place afterwards
+// needs the tree to be told, see Refresh.
+template <class Summary, class Base = tree_traits>
+struct summary_traits : Base {
+  using summary_type = Summary;
+};
+
+// Summaries of the mapped values of a map: their sum, minimum and maximum.
+template <typename T>
+struct mapped_sum {
+  using value_type = T;
+
+  static value_type Identity() noexcept { return value_type(); }
+
+  template <typename Element>
+  static value_type Of(const Element &element) noexcept {
+    return element.second;
+  }
+
+  static value_type Combine(const value_type &left,
+                            const value_type &right) noexcept {
+    return left + right;
+  }
+};
+
+template <typename T>
+struct mapped_min {
+  using value_type = T;
+
+  static value_type Identity() noexcept {
+    return std::numeric_limits<value_type>::max();
+  }
+
+  template <typename Element>
+  static value_type Of(const Element &element) noexcept {
+    return element.second;
+  }
+
+  static value_type Combine(const value_type &left,
+                            const value_type &right) noexcept {
+    return std::min(left, right);
+  }
+};
+
+template <typename T>
+struct mapped_max {
+  using value_type = T;
+
+  static value_type Identity() noexcept {
+    return std::numeric_limits<value_type>::lowest();
+  }
+
+  template <typename Element>
+  static value_type Of(const Element &element) noexcept {
+    return element.second;
+  }
+
+  static value_type Combine(const value_type &left,
+                            const value_type &right) noexcept {
+    return std::max(left, right);
+  }
+};
+
+template <bool OrderStatistics>
+struct tree_node_size {};
+
+template <>
+struct tree_node_size<true> {
+  std::size_t size_ = 1;
+};
+
+// Neighbours of a node in key order. The chain is circular through the head
+// node, so iterator increments and decrements are a single load each, at
+// the price of two words per node.
+template <typename Node, bool Threaded>
+struct tree_node_thread {};
+
+template <typename Node>
+struct tree_node_thread<Node, true> {
+  Node *prev_ = nullptr;
+  Node *next_ = nullptr;
+};
+
+template <typename Summary>
+struct tree_node_summary {
+  typename Summary::value_type summary_ = Summary::Identity();
+};
+
+template <>
+struct tree_node_summary<void> {};
+
+// Links, key and color of a tree node. key_ sits in a union so that the head
+// node can leave it unconstructed; its owner destroys it explicitly.
+template <typename Node, typename Key, bool Compact>
+struct tree_node_links {
+  tree_node_links() : parent_(nullptr), left_(nullptr), right_(nullptr) {}
+
+  template <typename... Args>
+  explicit tree_node_links(color node_color, Args &&...args)
+      : parent_(nullptr),
+        left_(nullptr),
+        right_(nullptr),
+        key_(std::forward<Args>(args)...),
+        color_(node_color) {}
+
+  ~tree_node_links() {}
+
+  Node *Parent() const noexcept { return parent_; }
+
+  void SetParent(Node *parent) noexcept { parent_ = parent; }
+
+  color Color() const noexcept { return color_; }
+
+  void SetColor(color node_color) noexcept { color_ = node_color; }
+
+  Node *parent_;
+  Node *left_;
+  Node *right_;
+  union {
+    Key key_;
+  };
+  color color_ = red;
+};
+
+// Compact layout: the color lives in the lowest bit of the parent pointer,
+// which the alignment of Node leaves free. Saves a word per node whenever the
+// key size is a multiple of the pointer size.
+template <typename Node, typename Key>
+struct tree_node_links<Node, Key, true> {
+  tree_node_links() : parent_(red), left_(nullptr), right_(nullptr) {}
+
+  template <typename... Args>
+  explicit tree_node_links(color node_color, Args &&...args)
+      : parent_(node_color),
+        left_(nullptr),
+        right_(nullptr),
+        key_(std::forward<Args>(args)...) {}
+
+  ~tree_node_links() {}
+
+  Node *Parent() const noexcept {
+    return reinterpret_cast<Node *>(parent_ & ~kColorMask);
+  }
+
+  void SetParent(Node *parent) noexcept {
+    parent_ = reinterpret_cast<std::uintptr_t>(parent) | (parent_ & kColorMask);
+  }
+
+  color Color() const noexcept {
+    return static_cast<color>(parent_ & kColorMask);
+  }
+
+  void SetColor(color node_color) noexcept {
+    parent_ = (parent_ & ~kColorMask) | node_color;
+  }
+
+  static constexpr std::uintptr_t kColorMask = 1;
+
+  std::uintptr_t parent_;
+  Node *left_;
+  Node *right_;
+  union {
+    Key key_;
+  };
+};
+
+template <typename Key, typename Comparison = std::less<Key>,
+          typename Traits = tree_traits>
 class tree {
  private:
   struct Node;
   struct Iterator;
   struct IteratorConst;
+  class NodeHandle;
 
  public:
   using key_type = Key;
+  using traits_type = Traits;
+  using summary_type = typename traits_type::summary_type;
   using reference = key_type &;
   using const_reference = const key_type &;
   using iterator = Iterator;
   using const_iterator = IteratorConst;
+  using node_type = NodeHandle;
   using size_type = std::size_t;
 
-  tree() : head_(new Node), size_(0U) {}
+  // Result of inserting a node handle: where the key is, whether the node
+  // was linked, and the node itself if it was not.
+  struct insert_return_type {
+    iterator position;
+    bool inserted;
+    node_type node;
+  };
+
+  tree()
+      : head_(new Node),
+        size_(0U),
+        pool_(std::make_shared<node_pool_type>()) {}
+
+  tree(const tree &other) : tree() {
+    if (other.Size() > 0) {
+      CopyTreeFromOther(other);
+    }
+  }
+
+  tree(tree &&other) noexcept : tree() { Swap(other); }
+
+  tree &operator=(const tree &other) {
+    if (this != &other) {
+      if (other.Size() > 0) {
+        CopyTreeFromOther(other);
+      } else {
+        Clear();
+      }
+    }
+    return *this;
+  }
+
+  tree &operator=(tree &&other) noexcept {
+    Clear();
+    Swap(other);
+    return *this;
+  }
+
+  ~tree() {
+    Clear();
+    delete head_;
+    head_ = nullptr;
+  }
+
+  // Large trees with non-trivial keys destroy them on the shared thread
+  // pool, if it runs already: Clear neither starts the pool nor uses it
+  // once it is destroyed, as it also runs from destructors.
+  void Clear() noexcept {
+    thread_pool *threads = nullptr;
+    if (!std::is_trivially_destructible_v<key_type> &&
+        size_ >= kParallelThreshold) {
+      threads = thread_pool::SharedIfAlive();
+    }
+    bool parallel = threads != nullptr && threads->Size() > 1;
+    Node *root = Root();
+    if (parallel) {
+      root = DestroyKeysParallel(root, *threads, ForkDepth(threads->Size()));
+    }
+    if (OwnsPool() && kTrivialSummary) {
+      if (!parallel) {
+        DestroyKeys(root);
+      }
+      pool_->Release();
+    } else if (parallel) {
+      FreeNodesIn(*Pool(), root);
+    } else {
+      Destroy(Root());
+    }
+    InitializeHead();
+    size_ = 0;
+  }
+
+  size_type Size() const noexcept { return size_; }
+
+  bool Empty() const noexcept { return size_ == 0; }
+
+  // Bytes taken by one element, links and bookkeeping included.
+  static constexpr size_type NodeSize() noexcept { return sizeof(Node); }
+
+  // Operation counts since construction and the depth histogram, which
+  // takes a walk over the tree. Allocations and frees are counted by the
+  // node pool, which moves along with the elements; a node that moves to
+  // another tree counts as freed here and allocated there. Needs
+  // kStatistics.
+  tree_stats Stats() {
+    static_assert(kStatistics, "Stats needs kStatistics");
+    tree_stats stats;
+    stats.comparisons = cmp_.Get(counter::kComparisons);
+    stats.rotations = cmp_.Get(counter::kRotations);
+    stats.recolorings = cmp_.Get(counter::kRecolorings);
+    stats.extreme_updates = cmp_.Get(counter::kExtremeUpdates);
+    stats.allocations = Pool()->Allocations();
+    stats.frees = Pool()->Frees();
+    stats.depth_histogram = DepthHistogram();
+    return stats;
+  }
+
+  size_type MaxSize() const noexcept {
+    return ((std::numeric_limits<size_type>::max() / 2) - sizeof(tree) -
+            sizeof(Node)) /
+           sizeof(Node);
+  }
+
+  iterator Begin() noexcept { return iterator(MostLeft()); }
+
+  iterator End() noexcept { return iterator(head_); }
+
+  // Moves every node of other into this tree without reallocating it. Both
+  // trees are combined by split/join in O(m log(n / m + 1)), m <= n; with
+  // kThreaded relinking the chain adds O(n + m).
+  void Merge(tree &other) {
+    if (this != &other && other.size_ > 0) {
+      MergeFrom(other, false);
+    }
+  }
+
+  // Like Merge, but nodes whose key is already present stay in other.
+  void MergeUnique(tree &other) {
+    if (this != &other && other.size_ > 0) {
+      MergeFrom(other, true);
+    }
+  }
+
+  iterator Insert(const key_type &key) {
+    Node *new_node = NewNode(key);
+    return Insert(Root(), new_node, false).first;
+  }
+
+  std::pair<iterator, bool> InsertUnique(const key_type &key) {
+    Node *new_node = NewNode(key);
+    std::pair<iterator, bool> result = Insert(Root(), new_node, true);
+    if (result.second == false) {
+      DeleteNode(new_node);
+    }
+    return result;
+  }
+
+  // Inserts key next to hint if it belongs there, without a search from
+  // the root: amortized O(1) for keys arriving in order. Otherwise falls
+  // back to Insert. Equal keys go as close as possible before hint.
+  iterator InsertHint(const_iterator hint, const key_type &key) {
+    Node *new_node = NewNode(key);
+    return InsertHint(hint, new_node, false).first;
+  }
+
+  std::pair<iterator, bool> InsertUniqueHint(const_iterator hint,
+                                             const key_type &key) {
+    Node *new_node = NewNode(key);
+    std::pair<iterator, bool> result = InsertHint(hint, new_node, true);
+    if (result.second == false) {
+      DeleteNode(new_node);
+    }
+    return result;
+  }
+
+  // Like InsertHint, but constructs the key in place from args.
+  template <typename... Args>
+  iterator EmplaceHint(const_iterator hint, Args &&...args) {
+    Node *new_node = NewNode(std::in_place, std::forward<Args>(args)...);
+    return InsertHint(hint, new_node, false).first;
+  }
+
+  template <typename... Args>
+  std::pair<iterator, bool> EmplaceUniqueHint(const_iterator hint,
+                                              Args &&...args) {
+    Node *new_node = NewNode(std::in_place, std::forward<Args>(args)...);
+    std::pair<iterator, bool> result = InsertHint(hint, new_node, true);
+    if (result.second == false) {
+      DeleteNode(new_node);
+    }
+    return result;
+  }
+
+  // Inserts one element per argument, each constructed in its node
+  // straight from the argument.
+  template <typename... Args>
+  std::vector<std::pair<iterator, bool>> Emplace(Args &&...args) {
+    std::vector<std::pair<iterator, bool>> result;
+    result.reserve(sizeof...(args));
+    (result.push_back(Insert(
+         Root(), NewNode(std::in_place, std::forward<Args>(args)), false)),
+     ...);
+    return result;
+  }
+
+  template <typename... Args>
+  std::vector<std::pair<iterator, bool>> EmplaceUnique(Args &&...args) {
+    std::vector<std::pair<iterator, bool>> result;
+    result.reserve(sizeof...(args));
+    (result.push_back(EmplaceUniqueOne(std::forward<Args>(args))), ...);
+    return result;
+  }
+
+  // Constructs an element from args unless one equal to key is present;
+  // then args are left untouched. key must be comparable with the elements,
+  // like the key of a map with its pairs.
+  template <typename K, typename... Args>
+  std::pair<iterator, bool> TryEmplace(const K &key, Args &&...args) {
+    Node *parent = nullptr;
+    bool as_left = false;
+    if (Node *found = FindSlot(key, parent, as_left)) {
+      return {iterator(found), false};
+    }
+    Node *new_node = NewNode(std::in_place, std::forward<Args>(args)...);
+    return {Link(parent, as_left, new_node), true};
+  }
+
+  // Replaces the content with the keys of [first, last), which must already
+  // be sorted by the tree comparison. The tree is built bottom-up in O(n).
+  template <typename ForwardIt>
+  void AssignSorted(ForwardIt first, ForwardIt last) {
+    AssignSorted(first, last, false);
+  }
+
+  // Same as AssignSorted, but only the first of several equal keys is kept.
+  template <typename ForwardIt>
+  void AssignSortedUnique(ForwardIt first, ForwardIt last) {
+    AssignSorted(first, last, true);
+  }
+
+  // Inserts [first, last) into the tree. Sorted forward ranges going into an
+  // empty tree are bulk-loaded in O(n), anything else is inserted one by one.
+  template <typename InputIt>
+  void InsertRange(InputIt first, InputIt last) {
+    InsertRange(first, last, false);
+  }
+
+  template <typename InputIt>
+  void InsertRangeUnique(InputIt first, InputIt last) {
+    InsertRange(first, last, true);
+  }
+
+  // Set algebra over two unique-key trees, built with split/join on a copy
+  // of first. Independent subtrees are processed in parallel on threads.
+  static tree Union(const tree &first, const tree &second,
+                    thread_pool &threads) {
+    tree result;
+    result.cmp_ = first.cmp_;
+    ParallelContext context(threads, first.size_ + second.size_);
+    size_type size = 0;
+    Subtree copy = CopySubtree(first.Root(), BlackHeight(first.Root()),
+                               context, 0, size);
+    Subtree subtree = result.UnionParallel(
+        copy, second.Root(), BlackHeight(second.Root()), context, 0, size);
+    result.AttachParallel(subtree, size, context);
+    return result;
+  }
+
+  static tree Intersection(const tree &first, const tree &second,
+                           thread_pool &threads) {
+    tree result;
+    result.cmp_ = first.cmp_;
+    ParallelContext context(threads, first.size_ + second.size_);
+    size_type size = 0;
+    Subtree copy = CopySubtree(first.Root(), BlackHeight(first.Root()),
+                               context, 0, size);
+    size = 0;
+    Subtree subtree = result.IntersectionParallel(
+        copy, second.Root(), BlackHeight(second.Root()), context, 0, size);
+    result.AttachParallel(subtree, size, context);
+    return result;
+  }
+
+  static tree Difference(const tree &first, const tree &second,
+                         thread_pool &threads) {
+    tree result;
+    result.cmp_ = first.cmp_;
+    ParallelContext context(threads, first.size_ + second.size_);
+    size_type size = 0;
+    Subtree copy = CopySubtree(first.Root(), BlackHeight(first.Root()),
+                               context, 0, size);
+    size_type removed = 0;
+    Subtree subtree = result.DifferenceParallel(
+        copy, second.Root(), BlackHeight(second.Root()), context, 0, removed);
+    result.AttachParallel(subtree, size - removed, context);
+    return result;
+  }
+
+  // Iterator to the element with the given zero-based position in key
+  // order, End() if there is none. Needs kOrderStatistics.
+  iterator Select(size_type index) noexcept {
+    static_assert(kOrderStatistics, "Select needs kOrderStatistics");
+    Node *node = Root();
+    while (node != nullptr) {
+      size_type left_size = SubtreeSize(node->left_);
+      if (index < left_size) {
+        node = node->left_;
+      } else if (index == left_size) {
+        return iterator(node);
+      } else {
+        index -= left_size + 1;
+        node = node->right_;
+      }
+    }
+    return End();
+  }
+
+  // Number of elements less than key, which is also the position of
+  // LowerBound(key). Needs kOrderStatistics.
+  size_type Rank(const_reference key) const noexcept {
+    return RankOf(key);
+  }
+
+  // Number of elements equal to key: O(log n) with kOrderStatistics,
+  // O(log n + count) otherwise.
+  size_type Count(const_reference key) { return CountOf(key); }
+
+  iterator Find(const_reference key) { return FindKey(key); }
+
+  iterator LowerBound(const_reference key) { return LowerBoundKey(key); }
+
+  iterator UpperBound(const_reference key) { return UpperBoundKey(key); }
+
+  // Overloads of the lookups above for key-like types, available when the
+  // comparator is transparent (defines is_transparent, like std::less<>).
+  template <typename K, typename C = Comparison,
+            typename = typename C::is_transparent>
+  size_type Rank(const K &key) const noexcept {
+    return RankOf(key);
+  }
+
+  template <typename K, typename C = Comparison,
+            typename = typename C::is_transparent>
+  size_type Count(const K &key) {
+    return CountOf(key);
+  }
+
+  template <typename K, typename C = Comparison,
+            typename = typename C::is_transparent>
+  iterator Find(const K &key) {
+    return FindKey(key);
+  }
+
+  template <typename K, typename C = Comparison,
+            typename = typename C::is_transparent>
+  iterator LowerBound(const K &key) {
+    return LowerBoundKey(key);
+  }
+
+  template <typename K, typename C = Comparison,
+            typename = typename C::is_transparent>
+  iterator UpperBound(const K &key) {
+    return UpperBoundKey(key);
+  }
+
+  // Summary of the elements in [low, high), combined in key order, in
+  // O(log n). Needs a summary_type. low and high may be of any type the
+  // comparator accepts next to an element.
+  template <typename K>
+  auto Aggregate(const K &low, const K &high) const noexcept {
+    static_assert(kSummary, "Aggregate needs a summary_type");
+    Node *node = Root();
+    while (node != nullptr) {
+      if (cmp_(node->key_, low)) {
+        node = node->right_;
+      } else if (!cmp_(node->key_, high)) {
+        node = node->left_;
+      } else {
+        return summary_type::Combine(
+            summary_type::Combine(SummaryFrom(node->left_, low),
+                                  summary_type::Of(node->key_)),
+            SummaryBefore(node->right_, high));
+      }
+    }
+    return summary_type::Identity();
+  }
+
+  // Summary of all elements.
+  auto Aggregate() const noexcept {
+    static_assert(kSummary, "Aggregate needs a summary_type");
+    return SubtreeSummary(Root());
+  }
+
+  // Summary of the elements less than high, in O(log n).
+  template <typename K>
+  auto AggregateBefore(const K &high) const noexcept {
+    static_assert(kSummary, "AggregateBefore needs a summary_type");
+    return SummaryBefore(Root(), high);
+  }
+
+  // First element whose summary combined with those of all elements before
+  // it satisfies reached(summary), End() if there is none, together with
+  // the summary of the elements before it. reached must hold for every
+  // longer prefix once it holds for one. O(log n); needs a summary_type.
+  template <typename Reached>
+  auto SearchPrefix(Reached reached) noexcept {
+    static_assert(kSummary, "SearchPrefix needs a summary_type");
+    auto before = summary_type::Identity();
+    Node *node = Root();
+    while (node != nullptr) {
+      auto with_left =
+          summary_type::Combine(before, SubtreeSummary(node->left_));
+      if (node->left_ != nullptr && reached(with_left)) {
+        node = node->left_;
+        continue;
+      }
+      auto with_node =
+          summary_type::Combine(with_left, summary_type::Of(node->key_));
+      if (reached(with_node)) {
+        return std::make_pair(iterator(node), with_left);
+      }
+      before = with_node;
+      node = node->right_;
+    }
+    return std::make_pair(End(), before);
+  }
+
+  // Recomputes the summaries that depend on the element at pos after it was
+  // changed in place. O(log n).
+  void Refresh(const_iterator pos) noexcept {
+    UpdatePath(const_cast<Node *>(pos.node_));
+  }
+
+  // In-order walk that calls visit(it) for every element it reaches. It
+  // skips each subtree whose summary satisfies skip(summary) and ends at
+  // the first element that satisfies past(element), which must then hold
+  // for all later elements too. Needs a summary_type.
+  template <typename Skip, typename Past, typename Visit>
+  void VisitPruned(Skip skip, Past past, Visit visit) {
+    static_assert(kSummary, "VisitPruned needs a summary_type");
+    Node *path[kMaxHeight];
+    size_type depth = 0;
+    Node *node = Root();
+    while (true) {
+      for (; node != nullptr && !skip(node->summary_); node = node->left_) {
+        path[depth++] = node;
+      }
+      if (depth == 0) {
+        return;
+      }
+      node = path[--depth];
+      if (past(node->key_)) {
+        return;
+      }
+      visit(iterator(node));
+      node = node->right_;
+    }
+  }
+
+  // Writes Find(key) for every key of [first, last) to out. The lookups are
+  // run kBatchLanes at a time, one level per round, and each round
+  // prefetches the nodes the next one visits, so the cache misses of
+  // different keys overlap instead of queueing up. Keys may be of any type
+  // Find accepts.
+  template <typename ForwardIt, typename OutputIt>
+  OutputIt FindBatch(ForwardIt first, ForwardIt last, OutputIt out) {
+    LowerBoundBatch(first, last, [&](const auto &key, Node *node) {
+      *out++ = iterator(node != head_ && !cmp_(key, node->key_) ? node
+                                                                : head_);
+    });
+    return out;
+  }
+
+  // Writes Contains(key) as a bool for every key of [first, last) to out;
+  // see FindBatch.
+  template <typename ForwardIt, typename OutputIt>
+  OutputIt ContainsBatch(ForwardIt first, ForwardIt last, OutputIt out) {
+    LowerBoundBatch(first, last, [&](const auto &key, Node *node) {
+      *out++ = node != head_ && !cmp_(key, node->key_);
+    });
+    return out;
+  }
+
+  void Erase(iterator pos) noexcept {
+    Node *result = ExtractNode(pos);
+    if (result != nullptr) {
+      DeleteNode(result);
+    }
+  }
+
+  // Unlinks the element at pos and hands it over without freeing it. The
+  // node can be changed and inserted into any tree of the same type.
+  node_type Extract(iterator pos) noexcept {
+    Node *node = ExtractNode(pos);
+    if (node == nullptr) {
+      return node_type();
+    }
+    return node_type(node, pool_, pool_->HandOver(node));
+  }
+
+  // Extracts the first element equal to key, if any.
+  node_type Extract(const_reference key) noexcept {
+    return Extract(FindKey(key));
+  }
+
+  template <typename K, typename C = Comparison,
+            typename = typename C::is_transparent>
+  node_type Extract(const K &key) noexcept {
+    return Extract(FindKey(key));
+  }
+
+  // Links the node of handle into this tree without allocating. The pool
+  // of this tree takes a share in the chunk of the node. In unique mode a
+  // node whose key is present already is handed back in the result.
+  insert_return_type InsertNode(node_type &&handle, bool unique_only) {
+    if (handle.empty()) {
+      return {End(), false, node_type()};
+    }
+    pool_->TakeOver(handle.chunk_);
+    std::pair<iterator, bool> result =
+        Insert(Root(), handle.node_, unique_only);
+    if (!result.second) {
+      pool_->HandOver(handle.node_);
+      return {result.first, false, std::move(handle)};
+    }
+    handle.Release();
+    return {result.first, true, node_type()};
+  }
+
+  // Removes [first, last) and returns the number of removed elements. A
+  // range of more than kSmallErase elements is split out of the tree in
+  // O(log n) and destroyed in one pass, without rebalancing per element.
+  size_type Erase(iterator first, iterator last) noexcept {
+    size_type count = 0;
+    for (iterator it = first; it != last && count <= kSmallErase; ++it) {
+      ++count;
+    }
+    if (count <= kSmallErase) {
+      while (first != last) {
+        iterator next = first;
+        ++next;
+        Erase(first);
+        first = next;
+      }
+      return count;
+    }
+    bool from_begin = first.node_ == MostLeft();
+    bool to_end = last.node_ == head_;
+    if (from_begin && to_end) {
+      count = size_;
+      Clear();
+      return count;
+    }
+    size_type size = size_;
+    Node *before = kThreaded ? first.node_->Prev() : nullptr;
+    Subtree rest = DetachRoot();
+    Subtree right;
+    if (!to_end) {
+      SplitBefore(rest, last.node_, rest, right);
+    }
+    Subtree left;
+    if (!from_begin) {
+      SplitBefore(rest, first.node_, left, rest);
+    }
+    count = DestroyIn(*Pool(), rest.root_);
+    AttachRoot(Concatenate(left, right).root_, size - count, false);
+    if constexpr (kThreaded) {
+      Chain(head_, MostLeft());
+      Chain(MostRight(), head_);
+      Chain(before, last.node_);
+    }
+    return count;
+  }
+
+  // Removes all elements equal to key and returns how many there were.
+  size_type Erase(const_reference key) noexcept { return EraseKey(key); }
+
+  template <typename K, typename C = Comparison,
+            typename = typename C::is_transparent>
+  size_type Erase(const K &key) noexcept {
+    return EraseKey(key);
+  }
+
+  // Removes the elements for which predicate returns true in one in-order
+  // pass and rebuilds the rest as a balanced tree in O(n). Should predicate
+  // throw, the elements not yet visited are kept.
+  template <typename Predicate>
+  size_type EraseIf(Predicate predicate) {
+    NodeChain kept;
+    size_type size = size_;
+    Node *node = DetachRoot().root_;
+    try {
+      while (node != nullptr) {
+        if (node->left_ != nullptr) {
+          node = RotateToLeft(node);
+          continue;
+        }
+        Node *next = node->right_;
+        if (predicate(std::as_const(node->key_))) {
+          DeleteNode(node);
+        } else {
+          kept.Append(node);
+        }
+        node = next;
+      }
+    } catch (...) {
+      AppendInOrder(node, kept);
+      AttachChain(kept);
+      throw;
+    }
+    AttachChain(kept);
+    return size - kept.count_;
+  }
+
+  void Swap(tree &other) noexcept {
+    std::swap(head_, other.head_);
+    std::swap(size_, other.size_);
+    if constexpr (kStatistics) {
+      cmp_.Swap(other.cmp_);
+    } else {
+      std::swap(cmp_, other.cmp_);
+    }
+    std::swap(pool_, other.pool_);
+  }
+
+ private:
+  using node_pool_type = node_pool<Node, Traits::kStatistics>;
+  using counter = typename statistics_comparison<Comparison>::counter;
+
+  static constexpr bool kOrderStatistics = traits_type::kOrderStatistics;
+  static constexpr bool kCompactNodes = traits_type::kCompactNodes;
+  static constexpr bool kStatistics = traits_type::kStatistics;
+  static constexpr bool kThreaded = traits_type::kThreaded;
+  static constexpr bool kSummary =
+      !std::is_void_v<typename traits_type::summary_type>;
+  // Releasing the pool wholesale skips ~Node, which is fine as long as the
+  // summary needs no destructor.
+  static constexpr bool kTrivialSummary = std::is_trivially_destructible_v<
+      tree_node_summary<typename traits_type::summary_type>>;
+
+  void Record(counter which, size_type amount = 1) const noexcept {
+    if constexpr (kStatistics) {
+      cmp_.Add(which, amount);
+    }
+  }
+
+  // Colors a node while rebalancing; counted as a recoloring.
+  void Recolor(Node *node, color node_color) noexcept {
+    Record(counter::kRecolorings);
+    node->SetColor(node_color);
+  }
+
+  // Number of nodes at each depth of the tree.
+  std::vector<size_type> DepthHistogram() const {
+    std::vector<size_type> histogram;
+    std::pair<const Node *, size_type> pending[kMaxHeight];
+    size_type pending_count = 0;
+    const Node *node = Root();
+    size_type depth = 0;
+    while (true) {
+      for (; node != nullptr; node = node->left_, ++depth) {
+        if (histogram.size() == depth) {
+          histogram.push_back(0);
+        }
+        ++histogram[depth];
+        if (node->right_ != nullptr) {
+          pending[pending_count++] = {node->right_, depth + 1};
+        }
+      }
+      if (pending_count == 0) {
+        return histogram;
+      }
+      --pending_count;
+      node = pending[pending_count].first;
+      depth = pending[pending_count].second;
+    }
+  }
+
+  static void SwapColors(Node *node, Node *other) noexcept {
+    color node_color = node->Color();
+    node->SetColor(other->Color());
+    other->SetColor(node_color);
+  }
+
+  static size_type SubtreeSize(const Node *node) noexcept {
+    if constexpr (kOrderStatistics) {
+      return node != nullptr ? node->size_ : 0;
+    } else {
+      return node != nullptr ? 1 : 0;
+    }
+  }
+
+  static auto SubtreeSummary(const Node *node) noexcept {
+    return node != nullptr ? node->summary_ : summary_type::Identity();
+  }
+
+  // Summary of the elements of the subtree of node not less than low.
+  template <typename K>
+  auto SummaryFrom(const Node *node, const K &low) const noexcept {
+    auto result = summary_type::Identity();
+    while (node != nullptr) {
+      if (cmp_(node->key_, low)) {
+        node = node->right_;
+      } else {
+        result = summary_type::Combine(
+            summary_type::Combine(summary_type::Of(node->key_),
+                                  SubtreeSummary(node->right_)),
+            result);
+        node = node->left_;
+      }
+    }
+    return result;
+  }
+
+  // Summary of the elements of the subtree of node less than high.
+  template <typename K>
+  auto SummaryBefore(const Node *node, const K &high) const noexcept {
+    auto result = summary_type::Identity();
+    while (node != nullptr) {
+      if (cmp_(node->key_, high)) {
+        result = summary_type::Combine(
+            result, summary_type::Combine(SubtreeSummary(node->left_),
+                                          summary_type::Of(node->key_)));
+        node = node->right_;
+      } else {
+        node = node->left_;
+      }
+    }
+    return result;
+  }
+
+  // Recomputes the bookkeeping a node keeps about its subtree from its
+  // children.
+  static void Update(Node *node) noexcept {
+    if constexpr (kOrderStatistics) {
+      node->size_ = 1 + SubtreeSize(node->left_) + SubtreeSize(node->right_);
+    }
+    if constexpr (kSummary) {
+      node->summary_ = summary_type::Combine(
+          summary_type::Combine(SubtreeSummary(node->left_),
+                                summary_type::Of(node->key_)),
+          SubtreeSummary(node->right_));
+    }
+  }
+
+  // Updates every node from node up to the root of its (sub)tree.
+  void UpdatePath(Node *node) noexcept {
+    if constexpr (kOrderStatistics || kSummary) {
+      for (; node != nullptr && node != head_; node = node->Parent()) {
+        Update(node);
+      }
+    }
+  }
+
+  template <typename K>
+  size_type RankOf(const K &key) const noexcept {
+    static_assert(kOrderStatistics, "Rank needs kOrderStatistics");
+    return CountBefore(key, false);
+  }
+
+  template <typename K>
+  size_type CountOf(const K &key) {
+    if constexpr (kOrderStatistics) {
+      return CountBefore(key, true) - CountBefore(key, false);
+    } else {
+      size_type count = 0;
+      for (iterator it = LowerBoundKey(key); it != End() && !cmp_(key, *it);
+           ++it) {
+        ++count;
+      }
+      return count;
+    }
+  }
+
+  template <typename K>
+  iterator FindKey(const K &key) {
+    iterator result = LowerBoundKey(key);
+    if (result == End() || cmp_(key, *result)) {
+      return End();
+    }
+    return result;
+  }
+
+  template <typename K>
+  iterator LowerBoundKey(const K &key) {
+    Node *start = Root();
+    Node *result = End().node_;
+    while (start != nullptr) {
+      if (!cmp_(start->key_, key)) {
+        result = start;
+        start = start->left_;
+      } else {
+        start = start->right_;
+      }
+    }
+    return iterator(result);
+  }
+
+  // Calls visit(key, node) for every key of [first, last) in order, node
+  // being the lower bound of key or head_.
+  template <typename ForwardIt, typename Visit>
+  void LowerBoundBatch(ForwardIt first, ForwardIt last, Visit visit) {
+    using key_pointer = decltype(&*first);
+    key_pointer keys[kBatchLanes];
+    Node *nodes[kBatchLanes];
+    Node *results[kBatchLanes];
+    while (first != last) {
+      size_type lanes = 0;
+      for (; lanes < kBatchLanes && first != last; ++lanes, ++first) {
+        keys[lanes] = &*first;
+        nodes[lanes] = Root();
+        results[lanes] = head_;
+      }
+      for (bool active = true; active;) {
+        active = false;
+        for (size_type lane = 0; lane < lanes; ++lane) {
+          Node *node = nodes[lane];
+          if (node == nullptr) {
+            continue;
+          }
+          if (!cmp_(node->key_, *keys[lane])) {
+            results[lane] = node;
+            node = node->left_;
+          } else {
+            node = node->right_;
+          }
+          if (node != nullptr) {
+            Prefetch(node);
+            active = true;
+          }
+          nodes[lane] = node;
+        }
+      }
+      for (size_type lane = 0; lane < lanes; ++lane) {
+        visit(*keys[lane], results[lane]);
+      }
+    }
+  }
+
+  static void Prefetch(const Node *node) noexcept {
+#if defined(__GNUC__)
+    __builtin_prefetch(node);
+#else
+    (void)node;
+#endif
+  }
+
+  // An argument that already is an element is looked up before a node is
+  // allocated for it; anything else is constructed first to get its key.
+  template <typename Arg>
+  std::pair<iterator, bool> EmplaceUniqueOne(Arg &&arg) {
+    if constexpr (std::is_same_v<std::decay_t<Arg>, key_type>) {
+      return TryEmplace(arg, std::forward<Arg>(arg));
+    } else {
+      Node *new_node = NewNode(std::in_place, std::forward<Arg>(arg));
+      std::pair<iterator, bool> result = Insert(Root(), new_node, true);
+      if (result.second == false) {
+        DeleteNode(new_node);
+      }
+      return result;
+    }
+  }
+
+  // Searches for key like a unique insert. Returns the node equal to key,
+  // or null after setting parent and as_left to where key belongs.
+  template <typename K>
+  Node *FindSlot(const K &key, Node *&parent, bool &as_left) {
+    Node *node = Root();
+    while (node != nullptr) {
+      parent = node;
+      if (cmp_(key, node->key_)) {
+        as_left = true;
+        node = node->left_;
+      } else if (cmp_(node->key_, key)) {
+        as_left = false;
+        node = node->right_;
+      } else {
+        return node;
+      }
+    }
+    return nullptr;
+  }
+
+  template <typename K>
+  size_type EraseKey(const K &key) noexcept {
+    iterator first = LowerBoundKey(key);
+    if (first == End() || cmp_(key, *first)) {
+      return 0;
+    }
+    return Erase(first, UpperBoundKey(key));
+  }
+
+  template <typename K>
+  iterator UpperBoundKey(const K &key) {
+    Node *start = Root();
+    Node *result = End().node_;
+
+    while (start != nullptr) {
+      if (cmp_(key, start->key_)) {
+        result = start;
+        start = start->left_;
+      } else
+        start = start->right_;
+    }
+    return iterator(result);
+  }
+
+  // Number of elements less than key, or not greater than key if inclusive.
+  template <typename K>
+  size_type CountBefore(const K &key, bool inclusive) const noexcept {
+    size_type count = 0;
+    const Node *node = Root();
+    while (node != nullptr) {
+      bool before = inclusive ? !cmp_(key, node->key_) : cmp_(node->key_, key);
+      if (before) {
+        count += SubtreeSize(node->left_) + 1;
+        node = node->right_;
+      } else {
+        node = node->left_;
+      }
+    }
+    return count;
+  }
+
+  // Trees of kParallelThreshold nodes and more are copied on the shared
+  // thread pool, each thread into its own node_pool.
+  void CopyTreeFromOther(const tree &other) {
+    tree copy;
+    copy.cmp_ = other.cmp_;
+    size_type count = 0;
+    if (other.size_ >= kParallelThreshold) {
+      ParallelContext context(thread_pool::Shared(), other.size_);
+      Node *root = CopyParallel(other.Root(), context, 0, count);
+      copy.AttachParallel(Subtree{root, 0}, count, context);
+    } else {
+      Node *root = CopyIn(*copy.Pool(), other.Root(), count);
+      copy.AttachRoot(root, count);
+    }
+    Swap(copy);
+  }
+
+  // Copies a subtree without recursion. The walk climbs back through the
+  // parent pointers of the copy and a fixed stack of source nodes, as the
+  // source may be a split piece whose parent pointers are stale.
+  static Node *CopyIn(node_pool_type &pool, const Node *source,
+                      size_type &count) {
+    const Node *path[kMaxHeight];
+    size_type height = 0;
+    Node *root = NewNodeIn(pool, source->key_, source->Color());
+    ++count;
+    const Node *from = source;
+    Node *to = root;
+    try {
+      while (true) {
+        const Node *child = nullptr;
+        bool left = false;
+        if (from->left_ != nullptr && to->left_ == nullptr) {
+          child = from->left_;
+          left = true;
+        } else if (from->right_ != nullptr && to->right_ == nullptr) {
+          child = from->right_;
+        }
+        if (child != nullptr) {
+          Node *copy = NewNodeIn(pool, child->key_, child->Color());
+          ++count;
+          (left ? to->left_ : to->right_) = copy;
+          copy->SetParent(to);
+          path[height++] = from;
+          from = child;
+          to = copy;
+          continue;
+        }
+        Update(to);
+        if (height == 0) {
+          break;
+        }
+        from = path[--height];
+        to = to->Parent();
+      }
+    } catch (...) {
+      DestroyIn(pool, root);
+      throw;
+    }
+    root->SetParent(nullptr);
+    return root;
+  }
+
+  template <typename InputIt>
+  void InsertRange(InputIt first, InputIt last, bool unique_only) {
+    using category = typename std::iterator_traits<InputIt>::iterator_category;
+    if constexpr (std::is_base_of_v<std::forward_iterator_tag, category>) {
+      if (Empty() && std::is_sorted(first, last, std::cref(cmp_))) {
+        AssignSorted(first, last, unique_only);
+        return;
+      }
+    }
+    for (; first != last; ++first) {
+      Node *new_node = NewNode(*first);
+      if (InsertHint(End(), new_node, unique_only).second == false) {
+        DeleteNode(new_node);
+      }
+    }
+  }
+
+  template <typename ForwardIt>
+  void AssignSorted(ForwardIt first, ForwardIt last, bool unique_only) {
+    size_type count = 0;
+    for (ForwardIt it = first; it != last; ++count) {
+      SkipSorted(it, last, unique_only);
+    }
+    tree sorted;
+    sorted.cmp_ = cmp_;
+    if (count > 0) {
+      auto next_node = [&sorted, &first, last, unique_only]() {
+        Node *node = sorted.NewNode(*first);
+        sorted.SkipSorted(first, last, unique_only);
+        return node;
+      };
+      sorted.AttachBalanced(next_node, count);
+    }
+    Swap(sorted);
+  }
+
+  template <typename ForwardIt>
+  void SkipSorted(ForwardIt &it, ForwardIt last, bool unique_only) const {
+    ForwardIt current = it;
+    ++it;
+    while (unique_only && it != last && !cmp_(*current, *it)) {
+      ++it;
+    }
+  }
+
+  // Nodes rejected by a unique merge, chained in key order through right_.
+  struct NodeChain {
+    void Append(Node *node) noexcept {
+      node->right_ = nullptr;
+      if (last_ == nullptr) {
+        first_ = node;
+      } else {
+        last_->right_ = node;
+      }
+      last_ = node;
+      ++count_;
+    }
+
+    Node *first_ = nullptr;
+    Node *last_ = nullptr;
+    size_type count_ = 0;
+  };
+
+  // A red-black tree cut loose from any head: the root has no parent and is
+  // black, height_ is its black height.
+  struct Subtree {
+    Node *root_ = nullptr;
+    size_type height_ = 0;
+  };
+
+  void MergeFrom(tree &other, bool unique_only) {
+    pool_->Share(*other.pool_);
+    size_type other_size = other.size_;
+    size_type size = size_ + other_size;
+    Subtree root = DetachRoot();
+    Subtree other_root = other.DetachRoot();
+    NodeChain rejected;
+    root = Union(root, other_root, unique_only, rejected);
+    AttachRoot(root.root_, size - rejected.count_);
+    pool_->Moved(*other.pool_, other_size - rejected.count_);
+    other.AttachChain(rejected);
+  }
+
+  // Hangs the nodes of chain under the empty head as a balanced tree.
+  void AttachChain(const NodeChain &chain) noexcept {
+    if (chain.count_ > 0) {
+      Node *current = chain.first_;
+      auto next_node = [&current]() {
+        Node *node = current;
+        current = current->right_;
+        return node;
+      };
+      AttachBalanced(next_node, chain.count_);
+    }
+  }
+
+  // Appends the nodes of a detached subtree to chain in key order.
+  static void AppendInOrder(Node *node, NodeChain &chain) noexcept {
+    while (node != nullptr) {
+      if (node->left_ != nullptr) {
+        node = RotateToLeft(node);
+      } else {
+        Node *next = node->right_;
+        chain.Append(node);
+        node = next;
+      }
+    }
+  }
+
+  Subtree DetachRoot() noexcept {
+    Subtree root{Root(), BlackHeight(Root())};
+    if (root.root_ != nullptr) {
+      root.root_->SetParent(nullptr);
+    }
+    InitializeHead();
+    size_ = 0;
+    return root;
+  }
+
+  // Hangs a subtree under the empty head. A threaded tree gets its chain
+  // rebuilt in O(size) unless the caller took care of it.
+  void AttachRoot(Node *root, size_type size, bool thread = true) noexcept {
+    size_ = size;
+    if (root != nullptr) {
+      SetRoot(root);
+      root->SetParent(head_);
+      root->SetColor(black);
+      MostLeft() = SearchMinimum(root);
+      MostRight() = SearchMaximum(root);
+    }
+    if (thread) {
+      Thread();
+    }
+  }
+
+  static size_type BlackHeight(const Node *node) noexcept {
+    size_type height = 0;
+    for (; node != nullptr; node = node->left_) {
+      if (node->Color() == black) {
+        ++height;
+      }
+    }
+    return height;
+  }
+
+  // Black height a child would have as a black subtree root, given the one
+  // of its parent as a black subtree root.
+  static size_type ChildHeight(const Node *child,
+                               size_type parent_height) noexcept {
+    if (child != nullptr && child->Color() == red) {
+      return parent_height;
+    }
+    return parent_height - 1;
+  }
+
+  // Cuts a child off a detached subtree root and makes it a subtree itself.
+  static Subtree DetachChild(Node *child, size_type parent_height) noexcept {
+    Subtree subtree{child, ChildHeight(child, parent_height)};
+    if (child != nullptr) {
+      child->SetParent(nullptr);
+      child->SetColor(black);
+    }
+    return subtree;
+  }
+
+  // Joins two subtrees with keys left <= middle <= right in
+  // O(|left.height_ - right.height_| + 1).
+  Subtree Join(Subtree left, Node *middle, Subtree right) {
+    middle->SetParent(nullptr);
+    if (left.height_ == right.height_) {
+      LinkChildren(middle, left.root_, right.root_);
+      Update(middle);
+      middle->SetColor(black);
+      return {middle, left.height_ + 1};
+    }
+    bool left_taller = left.height_ > right.height_;
+    Subtree taller = left_taller ? left : right;
+    size_type target_height = left_taller ? right.height_ : left.height_;
+    Node *parent = nullptr;
+    Node *spine = taller.root_;
+    size_type spine_height = taller.height_;
+    while (spine != nullptr &&
+           (spine->Color() == red || spine_height != target_height)) {
+      if (spine->Color() == black) {
+        --spine_height;
+      }
+      parent = spine;
+      spine = left_taller ? spine->right_ : spine->left_;
+    }
+    middle->SetParent(parent);
+    middle->SetColor(red);
+    if (left_taller) {
+      LinkChildren(middle, spine, right.root_);
+      parent->right_ = middle;
+    } else {
+      LinkChildren(middle, left.root_, spine);
+      parent->left_ = middle;
+    }
+    UpdatePath(middle);
+    if (BalancingInsert(middle)) {
+      ++taller.height_;
+    }
+    while (taller.root_->Parent() != nullptr) {
+      taller.root_ = taller.root_->Parent();
+    }
+    return taller;
+  }
+
+  // Joins two subtrees with keys left <= right.
+  Subtree Concatenate(Subtree left, Subtree right) {
+    if (left.root_ == nullptr) {
+      return right;
+    }
+    if (right.root_ == nullptr) {
+      return left;
+    }
+    Node *first = nullptr;
+    right = SplitFirst(right, first);
+    return Join(left, first, right);
+  }
+
+  // Takes the smallest node out of a subtree.
+  Subtree SplitFirst(Subtree subtree, Node *&first) {
+    Node *node = subtree.root_;
+    Subtree left = DetachChild(node->left_, subtree.height_);
+    Subtree right = DetachChild(node->right_, subtree.height_);
+    node->left_ = node->right_ = nullptr;
+    if (left.root_ == nullptr) {
+      first = node;
+      return right;
+    }
+    return Join(SplitFirst(left, first), node, right);
+  }
+
+  static void LinkChildren(Node *node, Node *left, Node *right) noexcept {
+    node->left_ = left;
+    node->right_ = right;
+    if (left != nullptr) {
+      left->SetParent(node);
+    }
+    if (right != nullptr) {
+      right->SetParent(node);
+    }
+  }
+
+  // Splits a subtree into keys before and after key. Keys equal to key go
+  // left, unless unique_only is set: then the equal node is returned through
+  // equal and left out of both halves.
+  void Split(Subtree subtree, const_reference key, bool unique_only,
+             Subtree &left, Node *&equal, Subtree &right) {
+    Node *node = subtree.root_;
+    if (node == nullptr) {
+      left = right = Subtree{};
+      return;
+    }
+    Subtree node_left = DetachChild(node->left_, subtree.height_);
+    Subtree node_right = DetachChild(node->right_, subtree.height_);
+    node->left_ = node->right_ = nullptr;
+    if (cmp_(key, node->key_)) {
+      Subtree middle;
+      Split(node_left, key, unique_only, left, equal, middle);
+      right = Join(middle, node, node_right);
+    } else if (unique_only && !cmp_(node->key_, key)) {
+      left = node_left;
+      right = node_right;
+      equal = node;
+    } else {
+      Subtree middle;
+      Split(node_right, key, unique_only, middle, equal, right);
+      left = Join(node_left, node, middle);
+    }
+  }
+
+  // Splits a subtree into the nodes before pivot and the rest, pivot being
+  // the first node of right. Works by position, so it can split between
+  // equal keys.
+  void SplitBefore(Subtree subtree, Node *pivot, Subtree &left,
+                   Subtree &right) {
+    Node *path[kMaxHeight];
+    size_type depth = 0;
+    for (Node *node = pivot; node != nullptr; node = node->Parent()) {
+      path[depth++] = node;
+    }
+    SplitAlong(subtree, path, depth, left, right);
+  }
+
+  // Splits along path, which lists the nodes from pivot up to the subtree
+  // root at path[depth - 1].
+  void SplitAlong(Subtree subtree, Node *const *path, size_type depth,
+                  Subtree &left, Subtree &right) {
+    Node *node = subtree.root_;
+    Subtree node_left = DetachChild(node->left_, subtree.height_);
+    Subtree node_right = DetachChild(node->right_, subtree.height_);
+    node->left_ = node->right_ = nullptr;
+    if (depth == 1) {
+      left = node_left;
+      right = Join(Subtree{}, node, node_right);
+    } else if (path[depth - 2] == node_left.root_) {
+      Subtree middle;
+      SplitAlong(node_left, path, depth - 1, left, middle);
+      right = Join(middle, node, node_right);
+    } else {
+      Subtree middle;
+      SplitAlong(node_right, path, depth - 1, middle, right);
+      left = Join(node_left, node, middle);
+    }
+  }
 
-  tree(const tree &other) : tree() {
-    if (other.Size() > 0) {
-      CopyTreeFromOther(other);
+  // Union of two subtrees by recursing over the structure of other and
+  // splitting root around each of its keys. In unique mode the nodes of
+  // other with a key already in root go to rejected.
+  Subtree Union(Subtree root, Subtree other, bool unique_only,
+                NodeChain &rejected) {
+    if (other.root_ == nullptr) {
+      return root;
+    }
+    if (root.root_ == nullptr) {
+      return other;
     }
+    Node *middle = other.root_;
+    Subtree other_left = DetachChild(middle->left_, other.height_);
+    Subtree other_right = DetachChild(middle->right_, other.height_);
+    middle->left_ = middle->right_ = nullptr;
+    Subtree left, right;
+    Node *equal = nullptr;
+    Split(root, middle->key_, unique_only, left, equal, right);
+    left = Union(left, other_left, unique_only, rejected);
+    if (equal != nullptr) {
+      rejected.Append(middle);
+      middle = equal;
+    }
+    right = Union(right, other_right, unique_only, rejected);
+    return Join(left, middle, right);
   }
 
-  tree(tree &&other) noexcept : tree() { Swap(other); }
+  // State shared by the tasks of one parallel set operation. Every thread
+  // of the pool allocates from and frees into its own node_pool, and the
+  // pool of the result tree absorbs them all at the end.
+  struct ParallelContext {
+    ParallelContext(thread_pool &threads, size_type size)
+        : threads_(threads),
+          pools_(threads.Size()),
+          fork_depth_(size >= kParallelThreshold ? ForkDepth(threads.Size())
+                                                 : 0) {
+      for (auto &pool : pools_) {
+        pool = std::make_shared<node_pool_type>();
+      }
+    }
 
-  tree &operator=(const tree &other) {
-    if (this != &other) {
-      if (other.Size() > 0) {
-        CopyTreeFromOther(other);
+    node_pool_type &Pool() { return *pools_[threads_.ThisThreadIndex()]; }
+
+    template <typename Left, typename Right>
+    void Invoke(size_type depth, Left &&left, Right &&right) {
+      if (depth < fork_depth_) {
+        threads_.Invoke(left, right);
       } else {
-        Clear();
+        left();
+        right();
       }
     }
-    return *this;
-  }
 
-  tree &operator=(tree &&other) noexcept {
-    Clear();
-    Swap(other);
-    return *this;
-  }
+    thread_pool &threads_;
+    std::vector<std::shared_ptr<node_pool_type>> pools_;
+    size_type fork_depth_;
+  };
 
-  ~tree() {
-    Clear();
-    delete head_;
-    head_ = nullptr;
-  }
+  static constexpr size_type kParallelThreshold = 1U << 14;
 
-  void Clear() noexcept {
-    Destroy(Root());
-    InitializeHead();
-    size_ = 0;
-  }
+  // Ranges up to this size are erased node by node, which is cheaper than
+  // two splits and a concatenation.
+  static constexpr size_type kSmallErase = 16;
 
-  size_type Size() const noexcept { return size_; }
+  // Lookups FindBatch keeps in flight: enough to cover the memory latency
+  // with the misses of the others, few enough to stay in registers and L1.
+  static constexpr size_type kBatchLanes = 16;
 
-  bool Empty() const noexcept { return size_ == 0; }
+  // Bound on the height of a red-black tree of any size.
+  static constexpr size_type kMaxHeight =
+      2 * std::numeric_limits<size_type>::digits;
 
-  size_type MaxSize() const noexcept {
-    return ((std::numeric_limits<size_type>::max() / 2) - sizeof(tree) -
-            sizeof(Node)) /
-           sizeof(Node);
+  // Recursion depth down to which subtrees are forked: about four tasks per
+  // thread balance the load between unequal subtrees.
+  static size_type ForkDepth(size_type threads) noexcept {
+    size_type depth = 0;
+    while (threads > 1 && (size_type{1} << depth) < threads * 4) {
+      ++depth;
+    }
+    return depth;
   }
 
-  iterator Begin() noexcept { return iterator(MostLeft()); }
-
-  iterator End() noexcept { return iterator(head_); }
+  void AttachParallel(Subtree subtree, size_type size,
+                      ParallelContext &context) {
+    for (auto &pool : context.pools_) {
+      pool_->Absorb(*pool);
+    }
+    AttachRoot(subtree.root_, size);
+  }
 
-  void Merge(tree &other) {
-    if (this != &other) {
-      iterator other_begin = other.Begin();
-      while (other.size_ > 0) {
-        Node *moving_node = other_begin.node_;
-        ++other_begin;
-        if (moving_node->left_ != nullptr) {
-          moving_node->left_->parent_ = moving_node->parent_;
-        }
-        if (moving_node->right_ != nullptr) {
-          moving_node->right_->parent_ = moving_node->parent_;
-        }
-        if (moving_node->parent_->left_ == moving_node) {
-          moving_node->parent_->left_ = nullptr;
-        }
-        if (moving_node->parent_->right_ == moving_node) {
-          moving_node->parent_->right_ = nullptr;
-        }
-        moving_node->left_ = nullptr;
-        moving_node->right_ = nullptr;
-        moving_node->parent_ = nullptr;
-        moving_node->color_ = red;
-        --other.size_;
-        Insert(Root(), moving_node, false);
-      }
-      other.InitializeHead();
+  static Node *CopyParallel(const Node *node, ParallelContext &context,
+                            size_type depth, size_type &count) {
+    if (depth >= context.fork_depth_) {
+      return CopyIn(context.Pool(), node, count);
+    }
+    Node *copy = NewNodeIn(context.Pool(), node->key_, node->Color());
+    Node *left = nullptr;
+    Node *right = nullptr;
+    size_type left_count = 0;
+    size_type right_count = 0;
+    try {
+      context.Invoke(
+          depth,
+          [&] {
+            if (node->left_ != nullptr) {
+              left = CopyParallel(node->left_, context, depth + 1, left_count);
+            }
+          },
+          [&] {
+            if (node->right_ != nullptr) {
+              right =
+                  CopyParallel(node->right_, context, depth + 1, right_count);
+            }
+          });
+    } catch (...) {
+      DestroyIn(context.Pool(), left);
+      DestroyIn(context.Pool(), right);
+      DeleteNodeIn(context.Pool(), copy);
+      throw;
     }
+    LinkChildren(copy, left, right);
+    Update(copy);
+    count += left_count + right_count + 1;
+    return copy;
   }
 
-  void MergeUnique(tree &other) {
-    if (this != &other) {
-      iterator other_begin = other.Begin();
-      iterator other_end = other.End();
-
-      while (other_begin != other_end) {
-        iterator result_it = Find(other_begin.node_->key_);
-        if (result_it == End()) {
-          iterator tmp = other_begin;
-          ++other_begin;
-          Node *moving_node = other.ExtractNode(tmp);
-          Insert(Root(), moving_node, false);
-        } else {
-          ++other_begin;
-        }
-      }
+  static Subtree CopySubtree(const Node *node, size_type height,
+                             ParallelContext &context, size_type depth,
+                             size_type &count) {
+    if (node == nullptr) {
+      return Subtree{};
     }
+    Node *copy = CopyParallel(node, context, depth, count);
+    copy->SetParent(nullptr);
+    copy->SetColor(black);
+    return {copy, height};
   }
 
-  iterator Insert(const key_type &key) {
-    Node *new_node = new Node{key};
-    return Insert(Root(), new_node, false).first;
+  static void DestroyParallel(Node *node, ParallelContext &context,
+                              size_type depth) noexcept {
+    if (node == nullptr) {
+      return;
+    }
+    if (depth >= context.fork_depth_) {
+      DestroyIn(context.Pool(), node);
+      return;
+    }
+    context.threads_.Invoke(
+        [&] { DestroyParallel(node->left_, context, depth + 1); },
+        [&] { DestroyParallel(node->right_, context, depth + 1); });
+    DeleteNodeIn(context.Pool(), node);
   }
 
-  std::pair<iterator, bool> InsertUnique(const key_type &key) {
-    Node *new_node = new Node{key};
-    std::pair<iterator, bool> result = Insert(Root(), new_node, true);
-    if (result.second == false) {
-      delete new_node;
+  // The set operations below recurse over the structure of the read-only
+  // other tree and split the working copy of the first operand around its
+  // keys. Both halves are independent and run as parallel tasks near the
+  // top of the recursion. added / kept / removed count result nodes.
+  Subtree UnionParallel(Subtree root, const Node *other,
+                        size_type other_height, ParallelContext &context,
+                        size_type depth, size_type &added) {
+    if (other == nullptr) {
+      return root;
     }
-    return result;
+    if (root.root_ == nullptr) {
+      return CopySubtree(other, other_height, context, depth, added);
+    }
+    Subtree left, right;
+    Node *middle = nullptr;
+    Split(root, other->key_, true, left, middle, right);
+    size_type left_added = 0;
+    size_type right_added = 0;
+    context.Invoke(
+        depth,
+        [&] {
+          left = UnionParallel(left, other->left_,
+                               ChildHeight(other->left_, other_height),
+                               context, depth + 1, left_added);
+        },
+        [&] {
+          right = UnionParallel(right, other->right_,
+                                ChildHeight(other->right_, other_height),
+                                context, depth + 1, right_added);
+        });
+    added += left_added + right_added;
+    if (middle == nullptr) {
+      middle = NewNodeIn(context.Pool(), other->key_);
+      ++added;
+    }
+    return Join(left, middle, right);
   }
 
-  template <typename... Args>
-  std::vector<std::pair<iterator, bool>> Emplace(Args &&...args) {
-    std::vector<std::pair<iterator, bool>> result;
-    result.reserve(sizeof...(args));
-    for (auto item : {std::forward<Args>(args)...}) {
-      Node *new_node = new Node(std::move(item));
-      std::pair<iterator, bool> result_insert = Insert(Root(), new_node, false);
-      result.push_back(result_insert);
+  Subtree IntersectionParallel(Subtree root, const Node *other,
+                               size_type other_height,
+                               ParallelContext &context, size_type depth,
+                               size_type &kept) {
+    if (root.root_ == nullptr) {
+      return root;
     }
-    return result;
+    if (other == nullptr) {
+      DestroyParallel(root.root_, context, depth);
+      return Subtree{};
+    }
+    Subtree left, right;
+    Node *middle = nullptr;
+    Split(root, other->key_, true, left, middle, right);
+    size_type left_kept = 0;
+    size_type right_kept = 0;
+    context.Invoke(
+        depth,
+        [&] {
+          left = IntersectionParallel(left, other->left_,
+                                      ChildHeight(other->left_, other_height),
+                                      context, depth + 1, left_kept);
+        },
+        [&] {
+          right = IntersectionParallel(
+              right, other->right_, ChildHeight(other->right_, other_height),
+              context, depth + 1, right_kept);
+        });
+    kept += left_kept + right_kept;
+    if (middle == nullptr) {
+      return Concatenate(left, right);
+    }
+    ++kept;
+    return Join(left, middle, right);
   }
 
-  template <typename... Args>
-  std::vector<std::pair<iterator, bool>> EmplaceUnique(Args &&...args) {
-    std::vector<std::pair<iterator, bool>> result;
-    result.reserve(sizeof...(args));
+  Subtree DifferenceParallel(Subtree root, const Node *other,
+                             size_type other_height, ParallelContext &context,
+                             size_type depth, size_type &removed) {
+    if (root.root_ == nullptr || other == nullptr) {
+      return root;
+    }
+    Subtree left, right;
+    Node *middle = nullptr;
+    Split(root, other->key_, true, left, middle, right);
+    size_type left_removed = 0;
+    size_type right_removed = 0;
+    context.Invoke(
+        depth,
+        [&] {
+          left = DifferenceParallel(left, other->left_,
+                                    ChildHeight(other->left_, other_height),
+                                    context, depth + 1, left_removed);
+        },
+        [&] {
+          right = DifferenceParallel(right, other->right_,
+                                     ChildHeight(other->right_, other_height),
+                                     context, depth + 1, right_removed);
+        });
+    removed += left_removed + right_removed;
+    if (middle != nullptr) {
+      DeleteNodeIn(context.Pool(), middle);
+      ++removed;
+    }
+    return Concatenate(left, right);
+  }
 
-    for (auto item : {std::forward<Args>(args)...}) {
-      Node *new_node = new Node(std::move(item));
-      std::pair<iterator, bool> result_insert = Insert(Root(), new_node, true);
-      if (result_insert.second == false) {
-        delete new_node;
+  // Links count nodes produced in ascending order by next_node into a
+  // perfectly balanced tree and hangs it under the empty head. Every level is
+  // full except possibly the deepest one, whose nodes are colored red, so the
+  // result is a valid red-black tree without any rotations.
+  template <typename NodeSource>
+  void AttachBalanced(NodeSource &next_node, size_type count) {
+    Node *most_left = nullptr;
+    Node *most_right = nullptr;
+    auto tracked_node = [&next_node, &most_left, &most_right]() {
+      Node *node = next_node();
+      if (most_left == nullptr) {
+        most_left = node;
+      } else if constexpr (kThreaded) {
+        Chain(most_right, node);
       }
-      result.push_back(result_insert);
+      most_right = node;
+      return node;
+    };
+    size_type red_depth = 0;
+    while ((count >> (red_depth + 1)) != 0) {
+      ++red_depth;
     }
-    return result;
+    SetRoot(BuildBalanced(tracked_node, count, 0, red_depth));
+    Root()->SetParent(head_);
+    Root()->SetColor(black);
+    MostLeft() = most_left;
+    MostRight() = most_right;
+    if constexpr (kThreaded) {
+      Chain(head_, most_left);
+      Chain(most_right, head_);
+    }
+    size_ = count;
   }
 
-  iterator Find(const_reference key) {
-    iterator result = LowerBound(key);
-    if (result == End() || cmp_(key, *result)) {
-      return End();
+  template <typename NodeSource>
+  Node *BuildBalanced(NodeSource &next_node, size_type count, size_type depth,
+                      size_type red_depth) {
+    if (count == 0) {
+      return nullptr;
     }
-    return result;
+    size_type left_count = (count - 1) / 2;
+    Node *left = BuildBalanced(next_node, left_count, depth + 1, red_depth);
+    Node *node;
+    try {
+      node = next_node();
+    } catch (...) {
+      Destroy(left);
+      throw;
+    }
+    node->left_ = left;
+    node->right_ = nullptr;
+    if (left != nullptr) {
+      left->SetParent(node);
+    }
+    try {
+      node->right_ = BuildBalanced(next_node, count - 1 - left_count,
+                                   depth + 1, red_depth);
+    } catch (...) {
+      Destroy(node);
+      throw;
+    }
+    if (node->right_ != nullptr) {
+      node->right_->SetParent(node);
+    }
+    node->SetColor(depth == red_depth ? red : black);
+    Update(node);
+    return node;
   }
 
-  iterator LowerBound(const_reference key) {
-    Node *start = Root();
-    Node *result = End().node_;
-    while (start != nullptr) {
-      if (!cmp_(start->key_, key)) {
-        result = start;
-        start = start->left_;
+  void Destroy(Node *node) noexcept { DestroyIn(*Pool(), node); }
+
+  // The walks below take a subtree apart without recursion: a node with a
+  // left child is rotated right until the leftmost node is on top, and the
+  // node on top is processed before moving on to its right child. Only child
+  // pointers are followed, so parent pointers may be stale. DestroyIn
+  // returns the number of nodes it freed.
+  static size_type DestroyIn(node_pool_type &pool, Node *node) noexcept {
+    size_type count = 0;
+    while (node != nullptr) {
+      if (node->left_ != nullptr) {
+        node = RotateToLeft(node);
       } else {
-        start = start->right_;
+        Node *next = node->right_;
+        DeleteNodeIn(pool, node);
+        node = next;
+        ++count;
       }
     }
-    return iterator(result);
+    return count;
   }
 
-  iterator UpperBound(const_reference key) {
-    Node *start = Root();
-    Node *result = End().node_;
+  // Returns the slots of a subtree whose keys are destroyed already.
+  static void FreeNodesIn(node_pool_type &pool, Node *node) noexcept {
+    while (node != nullptr) {
+      if (node->left_ != nullptr) {
+        node = RotateToLeft(node);
+      } else {
+        Node *next = node->right_;
+        node->~Node();
+        pool.Deallocate(node);
+        node = next;
+      }
+    }
+  }
 
-    while (start != nullptr) {
-      if (cmp_(key, start->key_)) {
-        result = start;
-        start = start->left_;
-      } else
-        start = start->right_;
+  // Returns the subtree reshaped into a right spine, every node still
+  // linked, so that FreeNodesIn can return the slots afterwards.
+  static Node *DestroyKeys(Node *node) noexcept {
+    if (std::is_trivially_destructible_v<key_type>) return node;
+    Node **link = &node;
+    while (*link != nullptr) {
+      if ((*link)->left_ != nullptr) {
+        *link = RotateToLeft(*link);
+      } else {
+        (*link)->DestroyKey();
+        link = &(*link)->right_;
+      }
     }
-    return iterator(result);
+    return node;
   }
 
-  void Erase(iterator pos) noexcept {
-    Node *result = ExtractNode(pos);
-    delete result;
+  // Like DestroyKeys, forking the top depth levels; the node pool is not
+  // touched, as it is not synchronized.
+  static Node *DestroyKeysParallel(Node *node, thread_pool &threads,
+                                   size_type depth) noexcept {
+    if (node == nullptr || depth == 0) {
+      return DestroyKeys(node);
+    }
+    Node *left = node->left_;
+    Node *right = node->right_;
+    try {
+      threads.Invoke(
+          [&] { left = DestroyKeysParallel(left, threads, depth - 1); },
+          [&] { right = DestroyKeysParallel(right, threads, depth - 1); });
+    } catch (const std::bad_alloc &) {
+      // Invoke could not queue the right half and ran neither.
+      left = DestroyKeys(left);
+      right = DestroyKeys(right);
+    }
+    node->left_ = left;
+    node->right_ = right;
+    node->DestroyKey();
+    return node;
   }
 
-  void Swap(tree &other) noexcept {
-    std::swap(head_, other.head_);
-    std::swap(size_, other.size_);
-    std::swap(cmp_, other.cmp_);
+  static Node *RotateToLeft(Node *node) noexcept {
+    Node *left = node->left_;
+    node->left_ = left->right_;
+    left->right_ = node;
+    return left;
   }
 
- private:
-  void CopyTreeFromOther(const tree &other) {
-    Node *other_copy_root = CopyTree(other.Root(), nullptr);
-    Clear();
-    Root() = other_copy_root;
-    Root()->parent_ = head_;
-    MostLeft() = SearchMinimum(Root());
-    MostRight() = SearchMaximum(Root());
-    size_ = other.size_;
-    cmp_ = other.cmp_;
+  template <typename... Args>
+  Node *NewNode(Args &&...args) {
+    return NewNodeIn(*Pool(), std::forward<Args>(args)...);
   }
 
-  Node *CopyTree(const Node *node, Node *parent) {
-    Node *copy = new Node{node->key_, node->color_};
+  template <typename... Args>
+  static Node *NewNodeIn(node_pool_type &pool, Args &&...args) {
+    Node *memory = pool.Allocate();
     try {
-      if (node->left_) {
-        copy->left_ = CopyTree(node->left_, copy);
-      }
-
-      if (node->right_) {
-        copy->right_ = CopyTree(node->right_, copy);
-      }
+      return new (memory) Node(std::forward<Args>(args)...);
     } catch (...) {
-      Destroy(copy);
+      pool.Deallocate(memory);
       throw;
     }
-
-    copy->parent_ = parent;
-    return copy;
   }
 
-  void Destroy(Node *node) noexcept {
-    if (node == nullptr) return;
-    Destroy(node->left_);
-    Destroy(node->right_);
-    delete node;
+  void DeleteNode(Node *node) noexcept { DeleteNodeIn(*Pool(), node); }
+
+  static void DeleteNodeIn(node_pool_type &pool, Node *node) noexcept {
+    node->DestroyKey();
+    node->~Node();
+    pool.Deallocate(node);
   }
 
+  node_pool_type *Pool() noexcept { return pool_.get(); }
+
+  // False while node handles from this tree are alive.
+  bool OwnsPool() noexcept { return pool_.use_count() == 1; }
+
   void InitializeHead() {
-    Root() = nullptr;
+    SetRoot(nullptr);
     MostLeft() = head_;
     MostRight() = head_;
+    if constexpr (kThreaded) {
+      Chain(head_, head_);
+    }
+  }
+
+  // Makes right the successor of left in the chain of a threaded tree.
+  static void Chain(Node *left, Node *right) noexcept {
+    left->next_ = right;
+    right->prev_ = left;
+  }
+
+  // Rebuilds the chain of a threaded tree from its links.
+  void Thread() noexcept {
+    if constexpr (kThreaded) {
+      Node *previous = head_;
+      for (Node *node = MostLeft(); node != head_; node = node->NextInTree()) {
+        Chain(previous, node);
+        previous = node;
+      }
+      Chain(previous, head_);
+    }
   }
 
-  Node *&Root() { return head_->parent_; }
+  Node *Root() const noexcept { return head_->Parent(); }
 
-  const Node *Root() const { return head_->parent_; }
+  void SetRoot(Node *root) noexcept { head_->SetParent(root); }
 
   Node *&MostLeft() { return head_->left_; }
 
@@ -285,18 +2093,33 @@ class tree {
         }
       }
     }
+    bool as_left = parent != nullptr && cmp_(new_node->key_, parent->key_);
+    return {Link(parent, as_left, new_node), true};
+  }
+
+  // Links new_node as a child of parent, or as the root if parent is null,
+  // and rebalances.
+  iterator Link(Node *parent, bool as_left, Node *new_node) {
     if (parent != nullptr) {
-      new_node->parent_ = parent;
-      if (cmp_(new_node->key_, parent->key_)) {
+      new_node->SetParent(parent);
+      if (as_left) {
         parent->left_ = new_node;
       } else {
         parent->right_ = new_node;
       }
     } else {
-      new_node->color_ = black;
-      new_node->parent_ = head_;
-      Root() = new_node;
+      new_node->SetColor(black);
+      new_node->SetParent(head_);
+      SetRoot(new_node);
+    }
+    if constexpr (kThreaded) {
+      Node *next = parent == nullptr ? head_
+                   : as_left         ? parent
+                                     : parent->next_;
+      Chain(next->prev_, new_node);
+      Chain(new_node, next);
     }
+    UpdatePath(new_node);
     ++size_;
     if (MostLeft() == head_ || MostLeft()->left_ != nullptr) {
       MostLeft() = new_node;
@@ -305,88 +2128,150 @@ class tree {
       MostRight() = new_node;
     }
     BalancingInsert(new_node);
-    return {iterator(new_node), true};
+    return iterator(new_node);
+  }
+
+  // Links new_node next to hint when its key fits between hint and its
+  // neighbour: one of the two always has a free child slot on that side.
+  std::pair<iterator, bool> InsertHint(const_iterator hint, Node *new_node,
+                                       bool unique_only) {
+    Node *position = const_cast<Node *>(hint.node_);
+    const key_type &key = new_node->key_;
+    // before(a, b): a must be placed before b.
+    auto before = [this, unique_only](const key_type &a, const key_type &b) {
+      return unique_only ? cmp_(a, b) : !cmp_(b, a);
+    };
+    if (size_ == 0) {
+      return {Link(nullptr, false, new_node), true};
+    }
+    if (position == head_) {
+      if (before(MostRight()->key_, key)) {
+        return {Link(MostRight(), false, new_node), true};
+      }
+    } else if (before(key, position->key_)) {
+      if (position == MostLeft()) {
+        return {Link(position, true, new_node), true};
+      }
+      Node *previous = position->Prev();
+      if (before(previous->key_, key)) {
+        if (previous->right_ == nullptr) {
+          return {Link(previous, false, new_node), true};
+        }
+        return {Link(position, true, new_node), true};
+      }
+    } else if (unique_only && !cmp_(position->key_, key)) {
+      return {iterator(position), false};
+    } else if (position == MostRight()) {
+      return {Link(position, false, new_node), true};
+    } else {
+      Node *next = position->Next();
+      if (before(key, next->key_)) {
+        if (position->right_ == nullptr) {
+          return {Link(position, false, new_node), true};
+        }
+        return {Link(next, true, new_node), true};
+      }
+    }
+    return Insert(Root(), new_node, unique_only);
   }
 
-  void BalancingInsert(Node *node) {
-    Node *parent = node->parent_;
-    while (node != Root() && parent->color_ == red) {
-      Node *gparent = parent->parent_;
+  // Restores the red-black properties above a freshly linked red node. Also
+  // works inside a detached subtree; returns true if the subtree root had to
+  // be recolored black, which raises its black height by one.
+  bool BalancingInsert(Node *node) {
+    Node *parent = node->Parent();
+    while (!IsRoot(node) && parent->Color() == red) {
+      Node *gparent = parent->Parent();
       if (gparent->left_ == parent) {
         Node *uncle = gparent->right_;
-        if (uncle != nullptr && uncle->color_ == red) {
-          parent->color_ = black;
-          uncle->color_ = black;
-          gparent->color_ = red;
+        if (uncle != nullptr && uncle->Color() == red) {
+          Recolor(parent, black);
+          Recolor(uncle, black);
+          Recolor(gparent, red);
           node = gparent;
-          parent = node->parent_;
+          parent = node->Parent();
         } else {
           if (parent->right_ == node) {
             RotateLeft(parent);
             std::swap(parent, node);
           }
           RotateRight(gparent);
-          gparent->color_ = red;
-          parent->color_ = black;
+          Recolor(gparent, red);
+          Recolor(parent, black);
           break;
         }
       } else {
         Node *uncle = gparent->left_;
-        if (uncle != nullptr && uncle->color_ == red) {
-          parent->color_ = black;
-          uncle->color_ = black;
-          gparent->color_ = red;
+        if (uncle != nullptr && uncle->Color() == red) {
+          Recolor(parent, black);
+          Recolor(uncle, black);
+          Recolor(gparent, red);
           node = gparent;
-          parent = node->parent_;
+          parent = node->Parent();
         } else {
           if (parent->left_ == node) {
             RotateRight(parent);
             std::swap(parent, node);
           }
           RotateLeft(gparent);
-          gparent->color_ = red;
-          parent->color_ = black;
+          Recolor(gparent, red);
+          Recolor(parent, black);
           break;
         }
       }
     }
-    Root()->color_ = black;
+    if (IsRoot(node) && node->Color() == red) {
+      Recolor(node, black);
+      return true;
+    }
+    return false;
   }
 
-  void RotateRight(Node *node) {
-    Node *const pivot = node->left_;
-    pivot->parent_ = node->parent_;
-    if (node == Root()) {
-      Root() = pivot;
-    } else if (node->parent_->left_ == node) {
-      node->parent_->left_ = pivot;
+  bool IsRoot(const Node *node) const noexcept {
+    return node->Parent() == nullptr || node->Parent() == head_;
+  }
+
+  void ReplaceChild(Node *parent, Node *child, Node *replacement) noexcept {
+    if (parent == nullptr) {
+      return;
+    }
+    if (parent == head_) {
+      SetRoot(replacement);
+    } else if (parent->left_ == child) {
+      parent->left_ = replacement;
     } else {
-      node->parent_->right_ = pivot;
+      parent->right_ = replacement;
     }
+  }
+
+  void RotateRight(Node *node) {
+    Record(counter::kRotations);
+    Node *const pivot = node->left_;
+    pivot->SetParent(node->Parent());
+    ReplaceChild(node->Parent(), node, pivot);
     node->left_ = pivot->right_;
     if (pivot->right_ != nullptr) {
-      pivot->right_->parent_ = node;
+      pivot->right_->SetParent(node);
     }
-    node->parent_ = pivot;
+    node->SetParent(pivot);
     pivot->right_ = node;
+    Update(node);
+    Update(pivot);
   }
 
   void RotateLeft(Node *node) {
+    Record(counter::kRotations);
     Node *const pivot = node->right_;
-    pivot->parent_ = node->parent_;
-    if (node == Root()) {
-      Root() = pivot;
-    } else if (node->parent_->left_ == node) {
-      node->parent_->left_ = pivot;
-    } else {
-      node->parent_->right_ = pivot;
-    }
+    pivot->SetParent(node->Parent());
+    ReplaceChild(node->Parent(), node, pivot);
     node->right_ = pivot->left_;
     if (pivot->left_ != nullptr) {
-      pivot->left_->parent_ = node;
+      pivot->left_->SetParent(node);
     }
-    node->parent_ = pivot;
+    node->SetParent(pivot);
     pivot->left_ = node;
+    Update(node);
+    Update(pivot);
   }
 
   Node *ExtractNode(iterator pos) {
@@ -395,11 +2280,24 @@ class tree {
     }
 
     Node *deleted_node = pos.node_;
+    if constexpr (kThreaded) {
+      Chain(deleted_node->prev_, deleted_node->next_);
+    }
+    Node *most_left = MostLeft();
+    Node *most_right = MostRight();
+    if (deleted_node == most_left) {
+      Record(counter::kExtremeUpdates);
+      most_left = (++iterator(deleted_node)).node_;
+    }
+    if (deleted_node == most_right) {
+      Record(counter::kExtremeUpdates);
+      most_right = deleted_node->Prev();
+    }
     if (deleted_node->left_ != nullptr && deleted_node->right_ != nullptr) {
-      Node *replace = SearchMinimum(deleted_node->right_);
+      Node *replace = deleted_node->Next();
       SwapNodesForErase(deleted_node, replace);
     }
-    if (deleted_node->color_ == black &&
+    if (deleted_node->Color() == black &&
         ((deleted_node->left_ == nullptr && deleted_node->right_ != nullptr) ||
          (deleted_node->left_ != nullptr && deleted_node->right_ == nullptr))) {
       Node *replace;
@@ -410,130 +2308,140 @@ class tree {
       }
       SwapNodesForErase(deleted_node, replace);
     }
-    if (deleted_node->color_ == black && deleted_node->left_ == nullptr &&
+    if (deleted_node->Color() == black && deleted_node->left_ == nullptr &&
         deleted_node->right_ == nullptr) {
       EraseBalancing(deleted_node);
     }
     if (deleted_node == Root()) {
       InitializeHead();
     } else {
-      if (deleted_node == deleted_node->parent_->left_) {
-        deleted_node->parent_->left_ = nullptr;
+      if (deleted_node == deleted_node->Parent()->left_) {
+        deleted_node->Parent()->left_ = nullptr;
       } else {
-        deleted_node->parent_->right_ = nullptr;
-      }
-      if (MostLeft() == deleted_node) {
-        MostLeft() = SearchMinimum(Root());
-      }
-      if (MostRight() == deleted_node) {
-        MostRight() = SearchMaximum(Root());
+        deleted_node->Parent()->right_ = nullptr;
       }
+      UpdatePath(deleted_node->Parent());
+      MostLeft() = most_left;
+      MostRight() = most_right;
     }
     --size_;
     deleted_node->left_ = nullptr;
     deleted_node->right_ = nullptr;
-    deleted_node->parent_ = nullptr;
-    deleted_node->color_ = red;
+    deleted_node->SetParent(nullptr);
+    deleted_node->SetColor(red);
+    Update(deleted_node);
     return deleted_node;
   }
 
   void SwapNodesForErase(Node *node, Node *other) {
-    if (other->parent_->left_ == other) {
-      other->parent_->left_ = node;
+    if (other->Parent()->left_ == other) {
+      other->Parent()->left_ = node;
     } else {
-      other->parent_->right_ = node;
+      other->Parent()->right_ = node;
     }
     if (node == Root()) {
-      Root() = other;
+      SetRoot(other);
     } else {
-      if (node->parent_->left_ == node) {
-        node->parent_->left_ = other;
+      if (node->Parent()->left_ == node) {
+        node->Parent()->left_ = other;
       } else {
-        node->parent_->right_ = other;
+        node->Parent()->right_ = other;
       }
     }
-    std::swap(node->parent_, other->parent_);
+    Node *parent = node->Parent();
+    node->SetParent(other->Parent());
+    other->SetParent(parent);
     std::swap(node->left_, other->left_);
     std::swap(node->right_, other->right_);
-    std::swap(node->color_, other->color_);
+    SwapColors(node, other);
+    if constexpr (kOrderStatistics) {
+      std::swap(node->size_, other->size_);
+    }
+    if constexpr (kSummary) {
+      std::swap(node->summary_, other->summary_);
+    }
     if (node->left_) {
-      node->left_->parent_ = node;
+      node->left_->SetParent(node);
     }
     if (node->right_) {
-      node->right_->parent_ = node;
+      node->right_->SetParent(node);
     }
     if (other->left_) {
-      other->left_->parent_ = other;
+      other->left_->SetParent(other);
     }
     if (other->right_) {
-      other->right_->parent_ = other;
+      other->right_->SetParent(other);
     }
   }
 
   void EraseBalancing(Node *deleted_node) {
     Node *check_node = deleted_node;
-    Node *parent = deleted_node->parent_;
-    while (check_node != Root() && check_node->color_ == black) {
+    Node *parent = deleted_node->Parent();
+    while (check_node != Root() && check_node->Color() == black) {
       if (check_node == parent->left_) {
         Node *sibling = parent->right_;
-        if (sibling->color_ == red) {
-          std::swap(sibling->color_, parent->color_);
+        if (sibling->Color() == red) {
+          Record(counter::kRecolorings, 2);
+          SwapColors(sibling, parent);
           RotateLeft(parent);
-          parent = check_node->parent_;
+          parent = check_node->Parent();
           sibling = parent->right_;
         }
-        if (sibling->color_ == black &&
-            (sibling->left_ == nullptr || sibling->left_->color_ == black) &&
-            (sibling->right_ == nullptr || sibling->right_->color_ == black)) {
-          sibling->color_ = red;
-          if (parent->color_ == red) {
-            parent->color_ = black;
+        if (sibling->Color() == black &&
+            (sibling->left_ == nullptr || sibling->left_->Color() == black) &&
+            (sibling->right_ == nullptr || sibling->right_->Color() == black)) {
+          Recolor(sibling, red);
+          if (parent->Color() == red) {
+            Recolor(parent, black);
             break;
           }
           check_node = parent;
-          parent = check_node->parent_;
+          parent = check_node->Parent();
         } else {
-          if (sibling->left_ != nullptr && sibling->left_->color_ == red &&
+          if (sibling->left_ != nullptr && sibling->left_->Color() == red &&
               (sibling->right_ == nullptr ||
-               sibling->right_->color_ == black)) {
-            std::swap(sibling->color_, sibling->left_->color_);
+               sibling->right_->Color() == black)) {
+            Record(counter::kRecolorings, 2);
+            SwapColors(sibling, sibling->left_);
             RotateRight(sibling);
             sibling = parent->right_;
           }
-          sibling->right_->color_ = black;
-          sibling->color_ = parent->color_;
-          parent->color_ = black;
+          Recolor(sibling->right_, black);
+          Recolor(sibling, parent->Color());
+          Recolor(parent, black);
           RotateLeft(parent);
           break;
         }
       } else {
         Node *sibling = parent->left_;
-        if (sibling->color_ == red) {
-          std::swap(sibling->color_, parent->color_);
+        if (sibling->Color() == red) {
+          Record(counter::kRecolorings, 2);
+          SwapColors(sibling, parent);
           RotateRight(parent);
-          parent = check_node->parent_;
+          parent = check_node->Parent();
           sibling = parent->left_;
         }
-        if (sibling->color_ == black &&
-            (sibling->left_ == nullptr || sibling->left_->color_ == black) &&
-            (sibling->right_ == nullptr || sibling->right_->color_ == black)) {
-          sibling->color_ = red;
-          if (parent->color_ == red) {
-            parent->color_ = black;
+        if (sibling->Color() == black &&
+            (sibling->left_ == nullptr || sibling->left_->Color() == black) &&
+            (sibling->right_ == nullptr || sibling->right_->Color() == black)) {
+          Recolor(sibling, red);
+          if (parent->Color() == red) {
+            Recolor(parent, black);
             break;
           }
           check_node = parent;
-          parent = check_node->parent_;
+          parent = check_node->Parent();
         } else {
-          if (sibling->right_ != nullptr && sibling->right_->color_ == red &&
-              (sibling->left_ == nullptr || sibling->left_->color_ == black)) {
-            std::swap(sibling->color_, sibling->right_->color_);
+          if (sibling->right_ != nullptr && sibling->right_->Color() == red &&
+              (sibling->left_ == nullptr || sibling->left_->Color() == black)) {
+            Record(counter::kRecolorings, 2);
+            SwapColors(sibling, sibling->right_);
             RotateLeft(sibling);
             sibling = parent->left_;
           }
-          sibling->left_->color_ = black;
-          sibling->color_ = parent->color_;
-          parent->color_ = black;
+          Recolor(sibling->left_, black);
+          Recolor(sibling, parent->Color());
+          Recolor(parent, black);
           RotateRight(parent);
           break;
         }
@@ -555,39 +2463,79 @@ class tree {
     return node;
   }
 
-  struct Node {
-    Node()
-        : parent_(nullptr),
-          left_(this),
-          right_(this),
-          key_(key_type{}),
-          color_(red) {}
-
-    Node(const key_type &key)
-        : parent_(nullptr),
-          left_(nullptr),
-          right_(nullptr),
-          key_(key),
-          color_(red) {}
-
-    Node(key_type &&key)
-        : parent_(nullptr),
-          left_(nullptr),
-          right_(nullptr),
-          key_(std::move(key)),
-          color_(red) {}
-
-    Node(key_type key, color color_)
-        : parent_(nullptr),
-          left_(nullptr),
-          right_(nullptr),
-          key_(key),
-          color_(color_) {}
+  struct Node : tree_node_size<kOrderStatistics>,
+                tree_node_summary<typename traits_type::summary_type>,
+                tree_node_thread<Node, kThreaded>,
+                tree_node_links<Node, key_type, kCompactNodes> {
+    using links_type = tree_node_links<Node, key_type, kCompactNodes>;
+
+    Node() {
+      this->left_ = this;
+      this->right_ = this;
+      if constexpr (kThreaded) {
+        this->prev_ = this;
+        this->next_ = this;
+      }
+    }
+
+    Node(const key_type &key) : links_type(red, key) {}
+
+    Node(key_type &&key) : links_type(red, std::move(key)) {}
+
+    template <typename... Args>
+    explicit Node(std::in_place_t, Args &&...args)
+        : links_type(red, std::forward<Args>(args)...) {}
+
+    Node(const key_type &key, color node_color) : links_type(node_color, key) {}
+
+    void DestroyKey() noexcept { this->key_.~key_type(); }
 
     Node *Next() const noexcept {
+      if constexpr (kThreaded) {
+        return this->next_;
+      } else {
+        return NextInTree();
+      }
+    }
+
+    Node *Prev() const noexcept {
+      if constexpr (kThreaded) {
+        return this->prev_;
+      } else {
+        return PrevInTree();
+      }
+    }
+
+    // The head node is red and is the parent of its root, which is black.
+    bool IsHead() const noexcept {
+      return this->Color() == red && (this->Parent() == nullptr ||
+                                      this->Parent()->Parent() == this);
+    }
+
+    // Neighbours found from the tree links alone.
+    Node *PrevInTree() const noexcept {
+      Node *node = const_cast<Node *>(this);
+      if (IsHead()) {
+        return node->right_;
+      }
+      if (node->left_ != nullptr) {
+        node = node->left_;
+        while (node->right_ != nullptr) {
+          node = node->right_;
+        }
+        return node;
+      }
+      Node *parent = node->Parent();
+      while (node == parent->left_) {
+        node = parent;
+        parent = parent->Parent();
+      }
+      return parent;
+    }
+
+    Node *NextInTree() const noexcept {
       Node *node = const_cast<Node *>(this);
-      if (node->color_ == red &&
-          (node->parent_ == nullptr || node->parent_->parent_ == node)) {
+      if (IsHead()) {
         node = node->left_;
       } else if (node->right_ != nullptr) {
         node = node->right_;
@@ -595,10 +2543,10 @@ class tree {
           node = node->left_;
         }
       } else {
-        Node *parent = node->parent_;
+        Node *parent = node->Parent();
         while (node == parent->right_) {
           node = parent;
-          parent = parent->parent_;
+          parent = parent->Parent();
         }
         if (node->right_ != parent) {
           node = parent;
@@ -606,16 +2554,10 @@ class tree {
       }
       return node;
     }
-
-    Node *parent_;
-    Node *left_;
-    Node *right_;
-    key_type key_;
-    color color_;
   };
 
   struct Iterator {
-    using iterator_category = std::forward_iterator_tag;
+    using iterator_category = std::bidirectional_iterator_tag;
     using difference_type = std::ptrdiff_t;
     using value_type = tree::key_type;
     using pointer = value_type *;
@@ -630,6 +2572,11 @@ class tree {
       return *this;
     }
 
+    iterator &operator--() noexcept {
+      node_ = node_->Prev();
+      return *this;
+    }
+
     bool operator==(const iterator &other) const noexcept {
       return node_ == other.node_;
     }
@@ -642,7 +2589,7 @@ class tree {
   };
 
   struct IteratorConst {
-    using iterator_category = std::forward_iterator_tag;
+    using iterator_category = std::bidirectional_iterator_tag;
     using difference_type = std::ptrdiff_t;
     using value_type = tree::key_type;
     using pointer = const value_type *;
@@ -657,6 +2604,11 @@ class tree {
       return *this;
     }
 
+    const_iterator &operator--() noexcept {
+      node_ = node_->Prev();
+      return *this;
+    }
+
     friend bool operator==(const const_iterator &it1,
                            const const_iterator &it2) noexcept {
       return it1.node_ == it2.node_;
@@ -670,9 +2622,92 @@ class tree {
     const Node *node_;
   };
 
+  // Owner of an extracted node, like std::set::node_type. It keeps the pool
+  // of the node alive, so the tree it came from may be cleared or destroyed
+  // meanwhile. key() and mapped() exist for map nodes only.
+  class NodeHandle {
+   public:
+    using value_type = tree::key_type;
+
+    NodeHandle() = default;
+
+    NodeHandle(NodeHandle &&other) noexcept
+        : node_(other.node_),
+          pool_(std::move(other.pool_)),
+          chunk_(std::move(other.chunk_)) {
+      other.node_ = nullptr;
+    }
+
+    NodeHandle &operator=(NodeHandle &&other) noexcept {
+      if (this != &other) {
+        Reset();
+        node_ = other.node_;
+        pool_ = std::move(other.pool_);
+        chunk_ = std::move(other.chunk_);
+        other.node_ = nullptr;
+      }
+      return *this;
+    }
+
+    ~NodeHandle() { Reset(); }
+
+    bool empty() const noexcept { return node_ == nullptr; }
+
+    explicit operator bool() const noexcept { return node_ != nullptr; }
+
+    value_type &value() const noexcept { return node_->key_; }
+
+    template <typename V = value_type>
+    std::remove_const_t<typename V::first_type> &key() const noexcept {
+      return const_cast<std::remove_const_t<typename V::first_type> &>(
+          node_->key_.first);
+    }
+
+    template <typename V = value_type>
+    typename V::second_type &mapped() const noexcept {
+      return node_->key_.second;
+    }
+
+    void swap(NodeHandle &other) noexcept {
+      std::swap(node_, other.node_);
+      pool_.swap(other.pool_);
+      std::swap(chunk_, other.chunk_);
+    }
+
+   private:
+    friend class tree;
+
+    NodeHandle(Node *node, std::shared_ptr<node_pool_type> pool,
+               typename node_pool_type::chunk_share chunk) noexcept
+        : node_(node), pool_(std::move(pool)), chunk_(std::move(chunk)) {}
+
+    // Gives up the node, which now belongs to a tree.
+    void Release() noexcept {
+      node_ = nullptr;
+      pool_.reset();
+      chunk_ = typename node_pool_type::chunk_share();
+    }
+
+    void Reset() noexcept {
+      if (node_ != nullptr) {
+        node_->DestroyKey();
+        node_->~Node();
+        pool_->Reclaim(node_);
+      }
+      Release();
+    }
+
+    Node *node_ = nullptr;
+    std::shared_ptr<node_pool_type> pool_;
+    typename node_pool_type::chunk_share chunk_;
+  };
+
   Node *head_;
   size_type size_;
-  Comparison cmp_;
+  std::conditional_t<kStatistics, statistics_comparison<Comparison>,
+                     Comparison>
+      cmp_;
+  std::shared_ptr<node_pool_type> pool_;
 };
 
 }  // namespace s21
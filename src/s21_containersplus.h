@@ -2,6 +2,18 @@
 #define CONTAINERS_S21_CONTAINERSPLUS_H
 
 #include "headers/s21_array.h"
+#include "headers/s21_art_map.h"
+#include "headers/s21_art_set.h"
+#include "headers/s21_btree_map.h"
+#include "headers/s21_btree_multiset.h"
+#include "headers/s21_btree_set.h"
+#include "headers/s21_concurrent_map.h"
+#include "headers/s21_frozen_map.h"
+#include "headers/s21_frozen_set.h"
+#include "headers/s21_interval_map.h"
 #include "headers/s21_multiset.h"
+#include "headers/s21_persistent_map.h"
+#include "headers/s21_persistent_set.h"
+#include "headers/s21_rcu_map.h"
 
 #endif  // CONTAINERS_S21_CONTAINERSPLUS_H
\ No newline at end of file
@@ -1,10 +1,24 @@
 #include "array_tests.h"
+#include "art_map_tests.h"
+#include "art_set_tests.h"
+#include "btree_map_tests.h"
+#include "btree_multiset_tests.h"
+#include "btree_set_tests.h"
+#include "concurrent_map_tests.h"
+#include "frozen_map_tests.h"
+#include "frozen_set_tests.h"
+#include "interval_map_tests.h"
 #include "list_tests.h"
 #include "map_tests.h"
 #include "multiset_tests.h"
+#include "node_pool_tests.h"
+#include "persistent_map_tests.h"
+#include "persistent_set_tests.h"
 #include "queue_tests.h"
+#include "rcu_map_tests.h"
 #include "set_tests.h"
 #include "stack_test.h"
+#include "thread_pool_tests.h"
 #include "vector_tests.h"
 
 int main(int argc, char **argv) {
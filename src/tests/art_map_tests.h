@@ -0,0 +1,113 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <map>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "../headers/s21_art_map.h"
+
+TEST(art_map, Access) {
+  s21::art_map<int, std::string> my_map{std::make_pair(1, "one"),
+                                        std::make_pair(2, "two")};
+  ASSERT_EQ(my_map.at(1), "one");
+  ASSERT_THROW(my_map.at(3), std::out_of_range);
+  my_map[3] = "three";
+  ASSERT_EQ(my_map.size(), 3U);
+  ASSERT_EQ(my_map[3], "three");
+  ASSERT_FALSE(my_map.insert(3, "drei").second);
+  ASSERT_FALSE(my_map.insert_or_assign(3, "drei").second);
+  ASSERT_EQ(my_map.at(3), "drei");
+  ASSERT_FALSE(my_map.try_emplace(2, 5, 'x').second);
+  ASSERT_EQ(my_map.try_emplace(4, 5, 'x').first->second, "xxxxx");
+  ASSERT_TRUE(my_map.contains(2));
+  ASSERT_FALSE(my_map.contains(5));
+  s21::art_map<int, std::string> copy = my_map;
+  my_map.clear();
+  ASSERT_EQ(copy.size(), 4U);
+  ASSERT_EQ(copy.at(1), "one");
+  ASSERT_TRUE(my_map.begin() == my_map.end());
+}
+
+TEST(art_map, Random_Against_Std_Map) {
+  s21::art_map<std::int64_t, int> my_map;
+  std::map<std::int64_t, int> std_map;
+  std::mt19937_64 random(25);
+  std::vector<std::int64_t> pool;
+  for (int i = 0; i < 3000; ++i) {
+    std::int64_t key = static_cast<std::int64_t>(random());
+    pool.push_back(key);
+    pool.push_back(key + 1);
+    pool.push_back(-key);
+    pool.push_back(static_cast<std::int64_t>(random() % 600) - 300);
+  }
+  for (int i = 0; i < 60000; ++i) {
+    std::int64_t key = pool[random() % pool.size()];
+    if (random() % 3 != 0) {
+      ASSERT_EQ(my_map.insert(key, i).second,
+                std_map.insert({key, i}).second);
+    } else {
+      ASSERT_EQ(my_map.erase(key), std_map.erase(key));
+    }
+  }
+  ASSERT_EQ(my_map.size(), std_map.size());
+  ASSERT_TRUE(std::equal(my_map.begin(), my_map.end(), std_map.begin(),
+                         std_map.end()));
+  auto back = my_map.end();
+  for (auto it = std_map.rbegin(); it != std_map.rend(); ++it) {
+    --back;
+    ASSERT_EQ(back->first, it->first);
+  }
+  for (int i = 0; i < 5000; ++i) {
+    std::int64_t key = pool[random() % pool.size()] + (i % 3) - 1;
+    auto lower = my_map.lower_bound(key);
+    auto std_lower = std_map.lower_bound(key);
+    ASSERT_EQ(lower == my_map.end(), std_lower == std_map.end());
+    if (std_lower != std_map.end()) {
+      ASSERT_EQ(lower->first, std_lower->first);
+    }
+    auto upper = my_map.upper_bound(key);
+    auto std_upper = std_map.upper_bound(key);
+    ASSERT_EQ(upper == my_map.end(), std_upper == std_map.end());
+    if (std_upper != std_map.end()) {
+      ASSERT_EQ(upper->first, std_upper->first);
+    }
+    ASSERT_EQ(my_map.count(key), std_map.count(key));
+  }
+  for (auto it = my_map.begin(); it != my_map.end();) {
+    it = it->second % 2 == 0 ? my_map.erase(it) : std::next(it);
+  }
+  for (auto it = std_map.begin(); it != std_map.end();) {
+    it = it->second % 2 == 0 ? std_map.erase(it) : std::next(it);
+  }
+  ASSERT_TRUE(std::equal(my_map.begin(), my_map.end(), std_map.begin(),
+                         std_map.end()));
+  for (auto &item : std_map) {
+    ASSERT_EQ(my_map.erase(item.first), 1U);
+  }
+  ASSERT_TRUE(my_map.empty());
+  ASSERT_TRUE(my_map.begin() == my_map.end());
+}
+
+TEST(art_map, Unsigned_Order_And_Swap) {
+  s21::art_map<std::uint64_t, int> first;
+  s21::art_map<std::uint64_t, int> second{{7, 7}};
+  std::vector<std::uint64_t> keys = {~0ULL, 0, 1ULL << 63, 255, 256, 65535};
+  for (std::uint64_t key : keys) {
+    first.insert(key, 0);
+  }
+  first.swap(second);
+  ASSERT_EQ(first.size(), 1U);
+  ASSERT_EQ(first.begin()->first, 7U);
+  std::vector<std::uint64_t> order;
+  for (const auto &item : second) {
+    order.push_back(item.first);
+  }
+  std::sort(keys.begin(), keys.end());
+  ASSERT_EQ(order, keys);
+  s21::art_map<std::uint64_t, int> moved = std::move(second);
+  ASSERT_EQ(moved.size(), keys.size());
+  ASSERT_TRUE(moved.lower_bound(257)->first == 65535U);
+}
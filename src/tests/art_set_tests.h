@@ -0,0 +1,80 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "../headers/s21_art_set.h"
+
+TEST(art_set, Strings_Against_Std_Set) {
+  s21::art_set<std::string> my_set;
+  std::set<std::string> std_set;
+  std::mt19937 random(25);
+  const std::string alphabet("ab\0z", 4);
+  const std::string stem = "common/prefix/longer/than/a/node/";
+  auto make_key = [&] {
+    std::string key = random() % 2 == 0 ? stem : "";
+    for (int length = static_cast<int>(random() % 6); length > 0; --length) {
+      key += alphabet[random() % alphabet.size()];
+    }
+    return key;
+  };
+  for (int i = 0; i < 20000; ++i) {
+    std::string key = make_key();
+    if (random() % 3 != 0) {
+      ASSERT_EQ(my_set.insert(key).second, std_set.insert(key).second);
+    } else {
+      ASSERT_EQ(my_set.erase(key), std_set.erase(key));
+    }
+  }
+  ASSERT_EQ(my_set.size(), std_set.size());
+  ASSERT_TRUE(std::equal(my_set.begin(), my_set.end(), std_set.begin(),
+                         std_set.end()));
+  for (int i = 0; i < 1000; ++i) {
+    std::string key = make_key();
+    ASSERT_EQ(my_set.contains(key), std_set.count(key) == 1);
+    auto lower = my_set.lower_bound(key);
+    auto std_lower = std_set.lower_bound(key);
+    ASSERT_EQ(lower == my_set.end(), std_lower == std_set.end());
+    if (std_lower != std_set.end()) {
+      ASSERT_EQ(*lower, *std_lower);
+    }
+    auto upper = my_set.upper_bound(key);
+    auto std_upper = std_set.upper_bound(key);
+    ASSERT_EQ(upper == my_set.end(), std_upper == std_set.end());
+    if (std_upper != std_set.end()) {
+      ASSERT_EQ(*upper, *std_upper);
+    }
+    std::string prefix = key.substr(0, random() % (key.size() + 1));
+    auto range = my_set.prefix_range(prefix);
+    std::vector<std::string> found(range.first, range.second);
+    std::vector<std::string> expected;
+    for (const std::string &item : std_set) {
+      if (item.compare(0, prefix.size(), prefix) == 0) {
+        expected.push_back(item);
+      }
+    }
+    ASSERT_EQ(found, expected) << prefix;
+  }
+}
+
+TEST(art_set, Prefix_Range) {
+  s21::art_set<std::string> my_set{"car",  "card", "care", "cart",
+                                   "cat",  "",     "c",    "dog"};
+  auto range = my_set.prefix_range("car");
+  ASSERT_EQ(std::vector<std::string>(range.first, range.second),
+            std::vector<std::string>({"car", "card", "care", "cart"}));
+  range = my_set.prefix_range("cars");
+  ASSERT_TRUE(range.first == range.second);
+  range = my_set.prefix_range("");
+  ASSERT_EQ(static_cast<std::size_t>(std::distance(range.first, range.second)),
+            my_set.size());
+  ASSERT_EQ(*my_set.begin(), "");
+  ASSERT_EQ(my_set.erase("car"), 1U);
+  ASSERT_EQ(my_set.erase("car"), 0U);
+  ASSERT_EQ(*my_set.lower_bound("car"), "card");
+  ASSERT_EQ(*my_set.upper_bound("c"), "card");
+  ASSERT_TRUE(my_set.find("ca") == my_set.end());
+}
@@ -0,0 +1,77 @@
+#include <gtest/gtest.h>
+
+#include <map>
+#include <random>
+#include <string>
+
+#include "../headers/s21_btree_map.h"
+
+TEST(test, btreeMapAccess) {
+  s21::btree_map<int, std::string> my_map{std::make_pair(1, "one"),
+                                          std::make_pair(2, "two")};
+  ASSERT_EQ(my_map.at(1), "one");
+  ASSERT_THROW(my_map.at(3), std::out_of_range);
+  my_map[3] = "three";
+  ASSERT_EQ(my_map.size(), 3U);
+  ASSERT_EQ(my_map[3], "three");
+  ASSERT_FALSE(my_map.insert(3, "drei").second);
+  ASSERT_FALSE(my_map.insert_or_assign(3, "drei").second);
+  ASSERT_EQ(my_map.at(3), "drei");
+  ASSERT_TRUE(my_map.contains(2));
+  ASSERT_FALSE(my_map.contains(4));
+}
+
+TEST(test, btreeMapRandom) {
+  s21::btree_map<int, int> my_map;
+  std::map<int, int> std_map;
+  std::mt19937 random(8);
+  for (int i = 0; i < 20000; ++i) {
+    int key = static_cast<int>(random() % 3000);
+    if (random() % 4 != 0) {
+      my_map[key] += i;
+      std_map[key] += i;
+    } else if (my_map.contains(key)) {
+      my_map.erase(my_map.find(key));
+      std_map.erase(key);
+    }
+  }
+  ASSERT_EQ(my_map.size(), std_map.size());
+  auto it = my_map.begin();
+  for (const auto &item : std_map) {
+    ASSERT_EQ(it->first, item.first);
+    ASSERT_EQ(it->second, item.second);
+    ++it;
+  }
+  ASSERT_TRUE(it == my_map.end());
+}
+
+TEST(test, btreeMapCompareReverse) {
+  s21::btree_map<int, int, std::greater<int>> my_map;
+  std::map<int, int, std::greater<int>> std_map;
+  for (int i = 0; i < 2000; ++i) {
+    my_map[i % 700] += i;
+    std_map[i % 700] += i;
+  }
+  auto it = my_map.rbegin();
+  for (auto std_it = std_map.rbegin(); std_it != std_map.rend(); ++std_it) {
+    ASSERT_EQ(it->first, std_it->first);
+    ASSERT_EQ(it->second, std_it->second);
+    ++it;
+  }
+  ASSERT_TRUE(it == my_map.rend());
+  ASSERT_EQ(my_map.begin()->first, 699);
+  const s21::btree_map<int, int, std::greater<int>> &const_map = my_map;
+  ASSERT_EQ(const_map.rbegin()->first, 0);
+}
+
+TEST(test, btreeMapMerge) {
+  s21::btree_map<int, std::string> first{std::make_pair(1, "a"),
+                                         std::make_pair(2, "b")};
+  s21::btree_map<int, std::string> second{std::make_pair(2, "x"),
+                                          std::make_pair(3, "y")};
+  first.merge(second);
+  ASSERT_EQ(first.size(), 3U);
+  ASSERT_EQ(first.at(2), "b");
+  ASSERT_EQ(second.size(), 1U);
+  ASSERT_EQ(second.at(2), "x");
+}
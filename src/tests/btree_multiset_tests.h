@@ -0,0 +1,75 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "../headers/s21_btree_multiset.h"
+
+TEST(BtreeMultisetTest, InsertKeepsDuplicates) {
+  s21::btree_multiset<int> s = {3, 1, 3, 2, 3};
+  EXPECT_EQ(s.size(), 5U);
+  EXPECT_EQ(s.count(3), 3U);
+  EXPECT_EQ(s.count(4), 0U);
+  auto range = s.equal_range(3);
+  EXPECT_EQ(std::distance(range.first, range.second), 3);
+}
+
+TEST(BtreeMultisetTest, CountAcrossLeaves) {
+  s21::btree_multiset<int> s;
+  for (int i = 0; i < 1000; ++i) {
+    s.insert(i % 3);
+  }
+  EXPECT_EQ(s.count(0), 334U);
+  EXPECT_EQ(s.count(1), 333U);
+  EXPECT_EQ(s.count(2), 333U);
+  EXPECT_EQ(*s.lower_bound(1), 1);
+  EXPECT_EQ(*s.upper_bound(1), 2);
+}
+
+TEST(BtreeMultisetTest, CompareReverseIterators) {
+  s21::btree_multiset<int, std::greater<int>> s;
+  std::multiset<int, std::greater<int>> std_s;
+  for (int i = 0; i < 1000; ++i) {
+    s.insert(i % 37);
+    std_s.insert(i % 37);
+  }
+  EXPECT_TRUE(std::equal(s.begin(), s.end(), std_s.begin(), std_s.end()));
+  EXPECT_TRUE(std::equal(s.rbegin(), s.rend(), std_s.rbegin(), std_s.rend()));
+  EXPECT_EQ(*s.upper_bound(10), 9);
+  EXPECT_EQ(s.count(10), std_s.count(10));
+}
+
+TEST(BtreeMultisetTest, EraseRandom) {
+  s21::btree_multiset<std::string> s;
+  std::multiset<std::string> std_s;
+  std::mt19937 random(5);
+  for (int i = 0; i < 10000; ++i) {
+    std::string key = std::to_string(random() % 700);
+    if (random() % 2 == 0) {
+      s.insert(key);
+      std_s.insert(key);
+    } else if (s.contains(key)) {
+      s.erase(s.find(key));
+      std_s.erase(std_s.find(key));
+    }
+  }
+  EXPECT_EQ(s.size(), std_s.size());
+  EXPECT_TRUE(std::equal(std_s.begin(), std_s.end(), s.begin()));
+}
+
+TEST(BtreeMultisetTest, MergeAndAssignSorted) {
+  s21::btree_multiset<int> first = {1, 2, 2};
+  s21::btree_multiset<int> second = {2, 3};
+  first.merge(second);
+  EXPECT_TRUE(second.empty());
+  EXPECT_EQ(first.count(2), 3U);
+  std::vector<int> keys(100, 7);
+  first.assign_sorted(keys.begin(), keys.end());
+  EXPECT_EQ(first.size(), 100U);
+  EXPECT_EQ(first.count(7), 100U);
+  EXPECT_EQ(*first.emplace(7), 7);
+  EXPECT_EQ(first.count(7), 101U);
+}
@@ -0,0 +1,133 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <random>
+#include <set>
+#include <vector>
+
+#include "../headers/s21_btree_set.h"
+
+TEST(btree_set, Constructor_Initializer_List) {
+  s21::btree_set<int> s21_set = {5, 1, 3, 1, 4};
+  std::set<int> std_set = {5, 1, 3, 1, 4};
+  EXPECT_EQ(s21_set.size(), std_set.size());
+  EXPECT_TRUE(std::equal(std_set.begin(), std_set.end(), s21_set.begin()));
+}
+
+TEST(btree_set, Constructor_Copy_Move) {
+  s21::btree_set<int> s21_set;
+  for (int i = 0; i < 1000; ++i) {
+    s21_set.insert(i * 3 % 1000);
+  }
+  s21::btree_set<int> copy(s21_set);
+  EXPECT_EQ(copy.size(), 1000U);
+  EXPECT_TRUE(std::equal(s21_set.begin(), s21_set.end(), copy.begin()));
+  s21::btree_set<int> moved(std::move(copy));
+  EXPECT_EQ(moved.size(), 1000U);
+  EXPECT_TRUE(copy.empty());
+  copy = moved;
+  EXPECT_TRUE(std::equal(moved.begin(), moved.end(), copy.begin()));
+}
+
+TEST(btree_set, Insert_Erase_Random) {
+  s21::btree_set<int> s21_set;
+  std::set<int> std_set;
+  std::mt19937 random(21);
+  for (int i = 0; i < 20000; ++i) {
+    int key = static_cast<int>(random() % 5000);
+    if (random() % 3 != 0) {
+      EXPECT_EQ(s21_set.insert(key).second, std_set.insert(key).second);
+    } else {
+      auto it = s21_set.find(key);
+      ASSERT_EQ(it == s21_set.end(), std_set.count(key) == 0);
+      if (it != s21_set.end()) {
+        auto next = s21_set.erase(it);
+        auto std_next = std_set.erase(std_set.find(key));
+        if (std_next == std_set.end()) {
+          EXPECT_TRUE(next == s21_set.end());
+        } else {
+          EXPECT_EQ(*next, *std_next);
+        }
+      }
+    }
+  }
+  EXPECT_EQ(s21_set.size(), std_set.size());
+  EXPECT_TRUE(std::equal(std_set.begin(), std_set.end(), s21_set.begin()));
+}
+
+TEST(btree_set, Lookup_Bounds) {
+  s21::btree_set<int> s21_set;
+  for (int i = 0; i < 500; ++i) {
+    s21_set.insert(i * 2);
+  }
+  EXPECT_TRUE(s21_set.contains(500));
+  EXPECT_FALSE(s21_set.contains(501));
+  EXPECT_EQ(s21_set.count(8), 1U);
+  EXPECT_EQ(s21_set.count(9), 0U);
+  EXPECT_EQ(*s21_set.lower_bound(301), 302);
+  EXPECT_EQ(*s21_set.upper_bound(302), 304);
+  EXPECT_TRUE(s21_set.lower_bound(999) == s21_set.end());
+  const s21::btree_set<int> &const_set = s21_set;
+  EXPECT_EQ(*const_set.find(40), 40);
+  EXPECT_TRUE(const_set.find(41) == const_set.end());
+}
+
+TEST(btree_set, Reverse_Iteration) {
+  s21::btree_set<int> s21_set;
+  for (int i = 0; i < 300; ++i) {
+    s21_set.insert(i);
+  }
+  auto it = s21_set.end();
+  for (int i = 299; i >= 0; --i) {
+    --it;
+    EXPECT_EQ(*it, i);
+  }
+  EXPECT_TRUE(it == s21_set.begin());
+}
+
+TEST(btree_set, Compare_Reverse_Iterators) {
+  s21::btree_set<int, std::greater<int>> s21_set;
+  std::set<int, std::greater<int>> std_set;
+  for (int i = 0; i < 1000; ++i) {
+    int key = i * 7919 % 1009;
+    s21_set.insert(key);
+    std_set.insert(key);
+  }
+  EXPECT_TRUE(std::equal(s21_set.begin(), s21_set.end(), std_set.begin(),
+                         std_set.end()));
+  EXPECT_TRUE(std::equal(s21_set.rbegin(), s21_set.rend(), std_set.rbegin(),
+                         std_set.rend()));
+  EXPECT_EQ(*s21_set.lower_bound(500), *std_set.lower_bound(500));
+  const s21::btree_set<int, std::greater<int>> &const_set = s21_set;
+  EXPECT_EQ(*const_set.rbegin(), *std_set.rbegin());
+  s21::btree_set<int> empty;
+  EXPECT_TRUE(empty.rbegin() == empty.rend());
+}
+
+TEST(btree_set, Assign_Sorted_Merge) {
+  std::vector<int> keys = {1, 1, 2, 3, 5, 8, 13};
+  s21::btree_set<int> s21_set;
+  s21_set.assign_sorted(keys.begin(), keys.end());
+  EXPECT_EQ(s21_set.size(), 6U);
+  s21::btree_set<int> other = {2, 4, 8, 16};
+  s21_set.merge(other);
+  EXPECT_EQ(s21_set.size(), 8U);
+  EXPECT_EQ(other.size(), 2U);
+  EXPECT_TRUE(other.contains(2));
+  EXPECT_TRUE(other.contains(8));
+  EXPECT_EQ(s21_set.emplace(21).second, true);
+  EXPECT_EQ(s21_set.emplace(21).second, false);
+}
+
+TEST(btree_set, Clear_Swap) {
+  s21::btree_set<int> first = {1, 2, 3};
+  s21::btree_set<int> second = {4, 5};
+  first.swap(second);
+  EXPECT_EQ(first.size(), 2U);
+  EXPECT_EQ(second.size(), 3U);
+  first.clear();
+  EXPECT_TRUE(first.empty());
+  EXPECT_TRUE(first.begin() == first.end());
+  first.insert(7);
+  EXPECT_EQ(*first.begin(), 7);
+}
@@ -0,0 +1,79 @@
+#include <gtest/gtest.h>
+
+#include <map>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "../headers/s21_concurrent_map.h"
+
+TEST(concurrent_map, Basic_Operations) {
+  s21::concurrent_map<int, int, 4> map = {{1, 10}, {2, 20}, {1, 11}};
+  EXPECT_EQ(map.size(), 2U);
+  EXPECT_TRUE(map.insert(3, 30));
+  EXPECT_FALSE(map.insert(3, 31));
+  map.insert_or_assign(3, 33);
+  EXPECT_EQ(map.at(3), 33);
+  EXPECT_EQ(map.find(1), 10);
+  EXPECT_EQ(map.erase(1), 1U);
+  EXPECT_EQ(map.erase(1), 0U);
+  EXPECT_FALSE(map.find(1).has_value());
+  EXPECT_THROW(map.at(1), std::out_of_range);
+  map.clear();
+  EXPECT_TRUE(map.empty());
+}
+
+TEST(concurrent_map, Batches_And_Ordered_Scan) {
+  s21::concurrent_map<int, int, 8> map;
+  std::vector<std::pair<int, int>> items;
+  std::map<int, int> std_map;
+  for (int i = 0; i < 1000; ++i) {
+    int key = i * 7919 % 1000;
+    items.emplace_back(key, i);
+    std_map.emplace(key, i);
+  }
+  items.emplace_back(5, -1);
+  EXPECT_EQ(map.insert_many(items.begin(), items.end()), 1000U);
+  std::vector<int> odd;
+  for (int key = 1; key < 1000; key += 2) {
+    odd.push_back(key);
+    std_map.erase(key);
+  }
+  odd.push_back(5000);
+  EXPECT_EQ(map.erase_many(odd.begin(), odd.end()), 500U);
+
+  auto view = map.ordered();
+  auto std_it = std_map.begin();
+  for (const auto &item : view) {
+    ASSERT_TRUE(std_it != std_map.end());
+    EXPECT_EQ(item.first, std_it->first);
+    EXPECT_EQ(item.second, std_it->second);
+    ++std_it;
+  }
+  EXPECT_TRUE(std_it == std_map.end());
+}
+
+TEST(concurrent_map, Parallel_Writers) {
+  s21::concurrent_map<int, int> map;
+  std::vector<std::thread> writers;
+  for (int writer = 0; writer < 4; ++writer) {
+    writers.emplace_back([&map, writer] {
+      for (int key = writer; key < 20000; key += 4) {
+        map.insert(key, key);
+      }
+      for (int key = writer; key < 20000; key += 8) {
+        map.erase(key);
+      }
+    });
+  }
+  for (std::thread &writer : writers) {
+    writer.join();
+  }
+  EXPECT_EQ(map.size(), 10000U);
+  int previous = -1;
+  for (const auto &item : map.ordered()) {
+    EXPECT_LT(previous, item.first);
+    previous = item.first;
+  }
+}
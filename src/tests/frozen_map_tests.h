@@ -0,0 +1,75 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <map>
+#include <stdexcept>
+#include <string>
+
+#include "../headers/s21_frozen_image.h"
+#include "../headers/s21_map.h"
+
+TEST(frozen_map, Lookups) {
+  s21::map<int, int> s21_map;
+  std::map<int, int> std_map;
+  for (int i = 0; i < 5000; ++i) {
+    int key = i * 7919 % 10007;
+    s21_map.insert(key, i);
+    std_map.insert({key, i});
+  }
+  s21::frozen_map<int, int> frozen = s21_map.freeze();
+  EXPECT_EQ(frozen.size(), std_map.size());
+  EXPECT_TRUE(std::equal(frozen.begin(), frozen.end(), std_map.begin(),
+                         std_map.end()));
+  for (int key = 0; key < 10007; ++key) {
+    auto it = frozen.find(key);
+    auto std_it = std_map.find(key);
+    ASSERT_EQ(it == frozen.end(), std_it == std_map.end());
+    if (std_it != std_map.end()) {
+      EXPECT_EQ(it->second, std_it->second);
+      EXPECT_EQ(frozen.at(key), std_it->second);
+    }
+  }
+  EXPECT_THROW(frozen.at(-1), std::out_of_range);
+  s21::frozen_map<int, int> empty;
+  EXPECT_TRUE(empty.begin() == empty.end());
+  EXPECT_TRUE(empty.find(0) == empty.end());
+}
+
+TEST(frozen_map, Save_And_Open_Mapped) {
+  struct Record {
+    double price;
+    int quantity;
+  };
+  std::string path = testing::TempDir() + "s21_frozen_map.img";
+  s21::map<int, Record> s21_map;
+  for (int i = 0; i < 3000; ++i) {
+    s21_map.insert(i * 7919 % 10007, Record{i * 0.5, i});
+  }
+  s21_map.save(path);
+  auto mapped = s21::map<int, Record>::open_mapped(path);
+  EXPECT_EQ(mapped.size(), s21_map.size());
+  auto same = [](const auto &left, const auto &right) {
+    return left.first == right.first &&
+           left.second.quantity == right.second.quantity;
+  };
+  EXPECT_TRUE(std::equal(mapped.begin(), mapped.end(), s21_map.begin(),
+                         s21_map.end(), same));
+  EXPECT_EQ(mapped.at(7919).quantity, 1);
+  EXPECT_EQ(mapped.at(7919).price, 0.5);
+  EXPECT_TRUE(mapped.find(10008) == mapped.end());
+  auto lower = std::find_if(s21_map.begin(), s21_map.end(), [](auto &item) {
+    return item.first >= 9000;
+  });
+  EXPECT_EQ(mapped.lower_bound(9000)->first, (*lower).first);
+  s21::frozen_map<int, Record> moved = std::move(mapped);
+  EXPECT_EQ(moved.at(0).quantity, 0);
+  s21::frozen_map<int, Record> copy = moved;
+  moved = s21::frozen_map<int, Record>();
+  EXPECT_EQ(copy.size(), s21_map.size());
+  EXPECT_EQ(copy.at(7919).quantity, 1);
+  moved.save(path);
+  using record_map = s21::map<int, Record>;
+  EXPECT_TRUE(record_map::open_mapped(path).empty());
+  std::remove(path.c_str());
+}
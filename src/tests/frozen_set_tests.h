@@ -0,0 +1,81 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+
+#include "../headers/s21_frozen_image.h"
+#include "../headers/s21_set.h"
+
+TEST(frozen_set, Lookups) {
+  for (int count : {0, 1, 2, 7, 8, 9, 100, 1023, 1024, 1025}) {
+    s21::set<int> s21_set;
+    std::set<int> std_set;
+    for (int i = 0; i < count; ++i) {
+      s21_set.insert(i * 3);
+      std_set.insert(i * 3);
+    }
+    s21::frozen_set<int> frozen = s21_set.freeze();
+    EXPECT_EQ(frozen.size(), std_set.size());
+    EXPECT_TRUE(std::equal(frozen.begin(), frozen.end(), std_set.begin(),
+                           std_set.end()));
+    for (int key = -2; key <= count * 3 + 2; ++key) {
+      EXPECT_EQ(frozen.contains(key), std_set.count(key) == 1);
+      auto lower = frozen.lower_bound(key);
+      auto std_lower = std_set.lower_bound(key);
+      ASSERT_EQ(lower == frozen.end(), std_lower == std_set.end());
+      if (std_lower != std_set.end()) {
+        EXPECT_EQ(*lower, *std_lower);
+      }
+      auto upper = frozen.upper_bound(key);
+      auto std_upper = std_set.upper_bound(key);
+      ASSERT_EQ(upper == frozen.end(), std_upper == std_set.end());
+      if (std_upper != std_set.end()) {
+        EXPECT_EQ(*upper, *std_upper);
+      }
+    }
+  }
+}
+
+TEST(frozen_set, Copy_Strings) {
+  s21::set<std::string> s21_set = {"pear", "apple", "fig", "quince"};
+  s21::frozen_set<std::string> frozen = s21_set.freeze();
+  s21_set.clear();
+  s21::frozen_set<std::string> copy = frozen;
+  s21::frozen_set<std::string> moved = std::move(frozen);
+  EXPECT_TRUE(std::equal(copy.begin(), copy.end(), moved.begin(),
+                         moved.end()));
+  EXPECT_EQ(*copy.begin(), "apple");
+  EXPECT_EQ(*copy.find("fig"), "fig");
+  EXPECT_TRUE(copy.find("plum") == copy.end());
+  EXPECT_EQ(copy.count("quince"), 1U);
+}
+
+TEST(frozen_set, Save_And_Open_Mapped) {
+  std::string path = testing::TempDir() + "s21_frozen_set.img";
+  s21::set<long> s21_set;
+  for (long i = 0; i < 4000; ++i) {
+    s21_set.insert(i * 7919 % 10007);
+  }
+  s21_set.save(path);
+  s21::frozen_set<long> mapped = s21::set<long>::open_mapped(path);
+  EXPECT_TRUE(std::equal(mapped.begin(), mapped.end(), s21_set.begin(),
+                         s21_set.end()));
+  for (long key = -1; key <= 10007; ++key) {
+    EXPECT_EQ(mapped.contains(key), s21_set.contains(key));
+  }
+  s21::frozen_set<long> frozen = s21_set.freeze();
+  frozen.save(path);
+  EXPECT_TRUE(std::equal(mapped.begin(), mapped.end(),
+                         s21::frozen_set<long>::open_mapped(path).begin()));
+  EXPECT_THROW(s21::set<int>::open_mapped(path), std::runtime_error);
+  std::FILE *file = std::fopen(path.c_str(), "wb");
+  std::fputs("not an image", file);
+  std::fclose(file);
+  EXPECT_THROW(s21::set<long>::open_mapped(path), std::runtime_error);
+  std::remove(path.c_str());
+  EXPECT_THROW(s21::set<long>::open_mapped(path), std::system_error);
+}
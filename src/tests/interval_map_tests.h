@@ -0,0 +1,75 @@
+#include <gtest/gtest.h>
+
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "../headers/s21_interval_map.h"
+
+TEST(interval_map, OverlapAndStab) {
+  s21::interval_map<int, std::string> ranges{
+      {{1, 5}, "a"}, {{3, 3}, "b"}, {{6, 10}, "c"}, {{1, 5}, "d"}};
+  EXPECT_EQ(ranges.size(), 4U);
+  EXPECT_EQ(ranges.count({1, 5}), 2U);
+  std::vector<s21::interval_map<int, std::string>::iterator> found;
+  ranges.stab(3, std::back_inserter(found));
+  ASSERT_EQ(found.size(), 3U);
+  EXPECT_EQ((*found[2]).second, "b");
+  found.clear();
+  ranges.overlap(5, 6, std::back_inserter(found));
+  ASSERT_EQ(found.size(), 3U);
+  EXPECT_EQ((*found[2]).second, "c");
+  EXPECT_TRUE(ranges.overlaps(10, 20));
+  EXPECT_FALSE(ranges.overlaps(11, 20));
+  EXPECT_FALSE(ranges.overlaps(-5, 0));
+  EXPECT_FALSE(ranges.overlaps(7, 6));
+  EXPECT_EQ(ranges.erase({1, 5}), 2U);
+  EXPECT_FALSE(ranges.overlaps(4, 5));
+  EXPECT_THROW(ranges.insert({4, 2}, "e"), std::invalid_argument);
+}
+
+TEST(interval_map, MatchesBruteForce) {
+  s21::interval_map<int, int> ranges;
+  std::vector<std::pair<int, int>> intervals;
+  for (int i = 0; i < 3000; ++i) {
+    int low = (i * 7919) % 10000;
+    int high = low + (i * 31) % 200;
+    intervals.emplace_back(low, high);
+    ranges.insert({low, high}, i);
+  }
+  for (int i = 0; i < 3000; i += 3) {
+    ranges.erase(ranges.find(intervals[i]));
+  }
+  std::vector<std::pair<int, int>> queries;
+  for (int low = -100; low < 10300; low += 97) {
+    queries.emplace_back(low, low + (low % 5) * 40);
+  }
+  std::size_t batch_matches = 0;
+  ranges.overlap_batch(queries.begin(), queries.end(),
+                       [&](const std::pair<int, int> &query, auto it) {
+                         EXPECT_LE((*it).first.first, query.second);
+                         EXPECT_GE((*it).first.second, query.first);
+                         ++batch_matches;
+                       });
+  std::size_t matches = 0;
+  for (const std::pair<int, int> &query : queries) {
+    std::vector<int> expected;
+    for (int i = 1; i < 3000; ++i) {
+      if (i % 3 != 0 && intervals[i].first <= query.second &&
+          intervals[i].second >= query.first) {
+        expected.push_back(i);
+      }
+    }
+    const s21::interval_map<int, int> &view = ranges;
+    std::vector<s21::interval_map<int, int>::const_iterator> found;
+    view.overlap(query.first, query.second, std::back_inserter(found));
+    ASSERT_EQ(found.size(), expected.size());
+    EXPECT_EQ(view.overlaps(query.first, query.second), !expected.empty());
+    for (std::size_t k = 1; k < found.size(); ++k) {
+      EXPECT_LE((*found[k - 1]).first, (*found[k]).first);
+    }
+    matches += found.size();
+  }
+  EXPECT_EQ(batch_matches, matches);
+}
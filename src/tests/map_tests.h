@@ -1,5 +1,11 @@
 #include <gtest/gtest.h>
 
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
 #include "../headers/s21_map.h"
 
 TEST(test, mapConstructorsList) {
@@ -411,4 +417,291 @@ TEST(test, mapEmplace) {
     ++std_iter;
   }
   ASSERT_TRUE(my_iter == my_map.end());
-}
\ No newline at end of file
+}
+
+TEST(test, mapRangeConstructorSorted) {
+  std::vector<std::pair<const int, std::string>> items = {
+      {1, "a"}, {2, "b"}, {2, "c"}, {5, "d"}};
+  s21::map<int, std::string> my_map(items.begin(), items.end());
+  std::map<int, std::string> std_map(items.begin(), items.end());
+  ASSERT_EQ(my_map.size(), std_map.size());
+  auto my_iter = my_map.begin();
+  for (const auto &item : std_map) {
+    ASSERT_EQ((*my_iter).first, item.first);
+    ASSERT_EQ((*my_iter).second, item.second);
+    ++my_iter;
+  }
+}
+
+TEST(test, mapAssignSorted) {
+  std::vector<std::pair<const int, std::string>> items;
+  for (int i = 0; i < 100; ++i) {
+    items.emplace_back(i, std::to_string(i));
+  }
+  s21::map<int, std::string> my_map{std::make_pair(500, "x")};
+  my_map.assign_sorted(items.begin(), items.end());
+  ASSERT_EQ(my_map.size(), 100U);
+  ASSERT_EQ(my_map.at(42), "42");
+  ASSERT_FALSE(my_map.contains(500));
+  my_map[150] = "y";
+  ASSERT_EQ(my_map.size(), 101U);
+}
+
+TEST(test, mapSetAlgebra) {
+  s21::map<int, std::string> first{std::make_pair(1, "a"),
+                                   std::make_pair(2, "b"),
+                                   std::make_pair(4, "d")};
+  s21::map<int, std::string> second{std::make_pair(2, "x"),
+                                    std::make_pair(3, "y")};
+  s21::map<int, std::string> united = s21::set_union(first, second);
+  ASSERT_EQ(united.size(), 4U);
+  ASSERT_EQ(united.at(2), "b");
+  ASSERT_EQ(united.at(3), "y");
+  s21::map<int, std::string> common = s21::set_intersection(first, second);
+  ASSERT_EQ(common.size(), 1U);
+  ASSERT_EQ(common.at(2), "b");
+  s21::map<int, std::string> rest = s21::set_difference(first, second);
+  ASSERT_EQ(rest.size(), 2U);
+  ASSERT_FALSE(rest.contains(2));
+}
+
+TEST(test, mapOrderStatistics) {
+  s21::map<int, std::string, std::less<int>, s21::order_statistics_traits>
+      my_map;
+  for (int i = 100; i > 0; --i) {
+    my_map[i * 10] = std::to_string(i);
+  }
+  ASSERT_EQ((*my_map.nth(0)).first, 10);
+  ASSERT_EQ((*my_map.nth(49)).second, "50");
+  ASSERT_EQ(my_map.rank(505), 50U);
+  ASSERT_EQ(my_map.count(500), 1U);
+  ASSERT_EQ(my_map.count(505), 0U);
+  ASSERT_TRUE(my_map.nth(100) == my_map.end());
+}
+
+namespace {
+struct NoDefault {
+  explicit NoDefault(int value) : value(value) {}
+  int value;
+};
+}  // namespace
+
+TEST(test, mapLookupWithoutMappedDefault) {
+  s21::map<int, NoDefault> my_map;
+  my_map.insert(1, NoDefault(10));
+  my_map.insert(std::make_pair(2, NoDefault(20)));
+  ASSERT_EQ(my_map.at(2).value, 20);
+  ASSERT_TRUE(my_map.contains(1));
+  ASSERT_FALSE(my_map.contains(3));
+  ASSERT_EQ(my_map.count(1), 1U);
+  ASSERT_THROW(my_map.at(3), std::out_of_range);
+  my_map.insert_or_assign(1, NoDefault(11));
+  ASSERT_EQ(my_map.at(1).value, 11);
+}
+
+TEST(test, mapTransparentLookup) {
+  s21::map<std::string, int, std::less<>> my_map{
+      std::make_pair("apple", 1), std::make_pair("pear", 2)};
+  std::string_view key = "pear";
+  ASSERT_EQ(my_map.at(key), 2);
+  ASSERT_TRUE(my_map.contains(key));
+  ASSERT_FALSE(my_map.contains(std::string_view("plum")));
+  ASSERT_EQ((*my_map.find(key)).second, 2);
+  const auto &const_map = my_map;
+  ASSERT_TRUE(const_map.find(std::string_view("plum")) == const_map.end());
+  ASSERT_EQ(my_map.count("apple"), 1U);
+  ASSERT_EQ(my_map["apple"], 1);
+}
+
+TEST(test, mapInsertHint) {
+  s21::map<int, std::string> my_map;
+  for (int key = 0; key < 20; ++key) {
+    auto it = my_map.emplace_hint(my_map.end(), key, std::to_string(key));
+    ASSERT_EQ((*it).first, key);
+  }
+  auto it = my_map.insert(my_map.begin(), std::make_pair(5, "five"));
+  ASSERT_EQ((*it).second, "5");
+  it = my_map.insert(my_map.end(), std::make_pair(-1, "minus"));
+  ASSERT_EQ((*it).second, "minus");
+  ASSERT_EQ((*my_map.begin()).first, -1);
+  ASSERT_EQ(my_map.size(), 21U);
+}
+
+TEST(test, mapFindBatch) {
+  s21::map<std::string, int> my_map = {{"apple", 1}, {"fig", 2}, {"pear", 3}};
+  std::vector<std::string> keys = {"pear", "plum", "apple", "", "fig"};
+  std::vector<s21::map<std::string, int>::iterator> found;
+  my_map.find_batch(keys.begin(), keys.end(), std::back_inserter(found));
+  ASSERT_EQ(found.size(), keys.size());
+  ASSERT_EQ((*found[0]).second, 3);
+  ASSERT_TRUE(found[1] == my_map.end());
+  ASSERT_EQ((*found[2]).second, 1);
+  ASSERT_TRUE(found[3] == my_map.end());
+  ASSERT_EQ((*found[4]).second, 2);
+  bool contained[5];
+  my_map.contains_batch(keys.begin(), keys.end(), contained);
+  ASSERT_TRUE(contained[0] && !contained[1] && contained[2]);
+  ASSERT_TRUE(!contained[3] && contained[4]);
+}
+
+TEST(test, mapEraseKeyAndIf) {
+  s21::map<std::string, int> my_map = {
+      {"apple", 1}, {"fig", 2}, {"pear", 3}, {"plum", 4}};
+  ASSERT_EQ(my_map.erase("fig"), 1U);
+  ASSERT_EQ(my_map.erase("kiwi"), 0U);
+  ASSERT_EQ(my_map.erase_if([](const auto &item) { return item.second > 2; }),
+            2U);
+  ASSERT_EQ(my_map.size(), 1U);
+  ASSERT_EQ((*my_map.begin()).first, "apple");
+}
+
+TEST(test, mapNodeHandle) {
+  s21::map<int, std::string> hot;
+  s21::map<int, std::string>::node_type node;
+  {
+    s21::map<int, std::string> cold = {{1, "one"}, {2, "two"}, {3, "three"}};
+    node = cold.extract(2);
+    ASSERT_TRUE(static_cast<bool>(node));
+    ASSERT_EQ(cold.size(), 2U);
+    auto moved = hot.insert(cold.extract(cold.begin()));
+    ASSERT_TRUE(moved.inserted);
+  }
+  // The node outlives the map it came from.
+  node.key() = 20;
+  node.mapped() += "nty";
+  auto result = hot.insert(std::move(node));
+  ASSERT_TRUE(result.inserted);
+  ASSERT_EQ((*result.position).second, "twonty");
+  ASSERT_EQ(hot.size(), 2U);
+  ASSERT_EQ(hot.at(1), "one");
+  hot.clear();
+  ASSERT_TRUE(hot.empty());
+}
+
+TEST(test, mapTryEmplace) {
+  struct Counted {
+    explicit Counted(int value, int &constructions) : value_(value) {
+      ++constructions;
+    }
+    int value_;
+  };
+  int constructions = 0;
+  s21::map<int, Counted> my_map;
+  auto result = my_map.try_emplace(1, 10, constructions);
+  ASSERT_TRUE(result.second);
+  ASSERT_EQ((*result.first).second.value_, 10);
+  result = my_map.try_emplace(1, 20, constructions);
+  ASSERT_FALSE(result.second);
+  ASSERT_EQ((*result.first).second.value_, 10);
+  ASSERT_EQ(constructions, 1);
+
+  s21::map<std::string, std::string> strings;
+  std::string key = "apple";
+  strings.try_emplace(std::move(key), 3, 'a');
+  ASSERT_EQ(strings.at("apple"), "aaa");
+  std::string again = "apple";
+  ASSERT_FALSE(strings.try_emplace(std::move(again), "b").second);
+  ASSERT_EQ(again, "apple");
+  auto emplaced = strings.emplace(std::make_pair("fig", "f"),
+                                  std::make_pair(std::string("pear"), "p"));
+  ASSERT_EQ(emplaced.size(), 2U);
+  ASSERT_EQ(strings.size(), 3U);
+}
+
+namespace {
+// Non-commutative: concatenates the mapped values in key order.
+struct MappedConcat {
+  using value_type = std::string;
+
+  static value_type Identity() { return value_type(); }
+
+  static value_type Of(const std::pair<const int, std::string> &element) {
+    return element.second;
+  }
+
+  static value_type Combine(const value_type &left, const value_type &right) {
+    return left + right;
+  }
+};
+}  // namespace
+
+TEST(test, mapAggregate) {
+  s21::map<int, long, std::less<int>,
+           s21::summary_traits<s21::mapped_sum<long>>>
+      volume;
+  std::map<int, long> expected;
+  for (int i = 0; i < 2000; ++i) {
+    int key = (i * 7919) % 1000;
+    volume.insert_or_assign(key, i);
+    expected[key] = i;
+    if (i % 3 == 0) {
+      volume.erase((i * 31) % 1000);
+      expected.erase((i * 31) % 1000);
+    }
+  }
+  volume.erase(volume.find(100), volume.find(200));
+  expected.erase(expected.find(100), expected.find(200));
+  volume.erase_if([](const auto &item) { return item.second % 5 == 0; });
+  for (auto it = expected.begin(); it != expected.end();) {
+    it = it->second % 5 == 0 ? expected.erase(it) : std::next(it);
+  }
+  for (int low = -10; low < 1010; low += 37) {
+    for (int high = low; high < 1010; high += 101) {
+      long sum = 0;
+      for (auto it = expected.lower_bound(low);
+           it != expected.end() && it->first < high; ++it) {
+        sum += it->second;
+      }
+      ASSERT_EQ(volume.aggregate(low, high), sum);
+    }
+  }
+  ASSERT_EQ(volume.aggregate(50, 10), 0);
+  auto it = volume.begin();
+  long total = volume.aggregate();
+  (*it).second += 1000;
+  volume.refresh(it);
+  ASSERT_EQ(volume.aggregate(), total + 1000);
+  volume.modify(volume.try_emplace(2000).first,
+                [](long &value) { value += 500; });
+  ASSERT_EQ(volume.aggregate(), total + 1500);
+  ASSERT_EQ(volume.aggregate(1500, 2500), 500);
+  ASSERT_THROW(volume.modify(volume.find(2000),
+                             [](long &value) {
+                               value = 0;
+                               throw std::runtime_error("modify");
+                             }),
+               std::runtime_error);
+  ASSERT_EQ(volume.aggregate(), total + 1000);
+
+  s21::map<int, std::string, std::less<int>,
+           s21::summary_traits<MappedConcat, s21::order_statistics_traits>>
+      letters;
+  for (int i = 25; i >= 0; --i) {
+    letters.insert(i, std::string(1, static_cast<char>('a' + i)));
+  }
+  ASSERT_EQ(letters.aggregate(), "abcdefghijklmnopqrstuvwxyz");
+  ASSERT_EQ(letters.aggregate(3, 9), "defghi");
+  ASSERT_EQ((*letters.nth(3)).second, "d");
+  letters.erase(5);
+  ASSERT_EQ(letters.aggregate(3, 9), "deghi");
+  letters.insert_or_assign(4, "E");
+  ASSERT_EQ(letters.aggregate(0, 6), "abcdE");
+}
+
+TEST(test, mapStatistics) {
+  s21::map<int, int, std::less<int>, s21::statistics_traits> my_map;
+  for (int i = 0; i < 100; ++i) {
+    my_map[i * 37 % 101] = i;
+  }
+  std::size_t comparisons = my_map.stats().comparisons;
+  ASSERT_TRUE(my_map.contains(37));
+  ASSERT_GT(my_map.stats().comparisons, comparisons);
+  s21::map<int, int, std::less<int>, s21::statistics_traits> other;
+  other.insert(1000, 1);
+  auto node = other.extract(1000);
+  my_map.insert(std::move(node));
+  s21::tree_stats stats = my_map.stats();
+  ASSERT_EQ(stats.allocations, 101U);
+  ASSERT_EQ(stats.frees, 0U);
+  ASSERT_EQ(stats.depth_histogram[0], 1U);
+}
@@ -1,6 +1,11 @@
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <iterator>
+#include <set>
+#include <string>
+#include <string_view>
 #include <unordered_set>
 
 #include "../s21_containersplus.h"
@@ -349,4 +354,304 @@ TEST(MultisetTest, MultisetEmplace) {
     ++my_iter;
     ++std_iter;
   }
-}
\ No newline at end of file
+}
+
+TEST(MultisetTest, RangeConstructorKeepsDuplicates) {
+  std::vector<int> keys = {1, 1, 2, 3, 3, 3, 7};
+  s21::multiset<int> s21_(keys.begin(), keys.end());
+  EXPECT_EQ(s21_.size(), keys.size());
+  EXPECT_EQ(s21_.count(3), 3U);
+  s21_.insert(3);
+  EXPECT_EQ(s21_.count(3), 4U);
+}
+
+TEST(MultisetTest, AssignSorted) {
+  std::vector<int> keys = {2, 2, 4, 4, 4, 9};
+  s21::multiset<int> s21_ = {100};
+  s21_.assign_sorted(keys.begin(), keys.end());
+  std::multiset<int> std_(keys.begin(), keys.end());
+  auto my_iter = s21_.begin();
+  for (int key : std_) {
+    EXPECT_EQ(*my_iter, key);
+    ++my_iter;
+  }
+  EXPECT_FALSE(s21_.contains(100));
+}
+
+TEST(MultisetTest, MergeLarge) {
+  s21::multiset<int> s1;
+  s21::multiset<int> s2;
+  std::multiset<int> std1;
+  std::multiset<int> std2;
+  for (int i = 0; i < 1500; ++i) {
+    s1.insert(i % 300);
+    std1.insert(i % 300);
+  }
+  for (int i = 0; i < 700; ++i) {
+    s2.insert(i % 450);
+    std2.insert(i % 450);
+  }
+  s1.merge(s2);
+  std1.merge(std2);
+  EXPECT_TRUE(s2.empty());
+  EXPECT_EQ(s1.size(), std1.size());
+  auto my_iter = s1.begin();
+  for (int key : std1) {
+    EXPECT_EQ(*my_iter, key);
+    ++my_iter;
+  }
+}
+
+TEST(MultisetTest, CountMissingKey) {
+  s21::multiset<int> s = {1, 2, 2, 5};
+  EXPECT_EQ(s.count(2), 2);
+  EXPECT_EQ(s.count(3), 0);
+  EXPECT_EQ(s.count(9), 0);
+  EXPECT_EQ(s21::multiset<int>().count(1), 0);
+}
+
+TEST(MultisetTest, OrderStatistics) {
+  s21::multiset<int, std::less<int>, s21::order_statistics_traits> s;
+  std::multiset<int> std_s;
+  for (int i = 0; i < 2000; ++i) {
+    int key = (i * 7919) % 500;
+    s.insert(key);
+    std_s.insert(key);
+  }
+  for (int i = 0; i < 2000; i += 3) {
+    auto it = s.find((i * 31) % 500);
+    if (it != s.end()) {
+      std_s.erase(std_s.find(*it));
+      s.erase(it);
+    }
+  }
+  ASSERT_EQ(s.size(), std_s.size());
+  std::size_t index = 0;
+  for (int key : std_s) {
+    EXPECT_EQ(*s.nth(index), key);
+    ++index;
+  }
+  EXPECT_TRUE(s.nth(s.size()) == s.end());
+  for (int key = -1; key <= 500; ++key) {
+    EXPECT_EQ(s.count(key), std_s.count(key));
+    EXPECT_EQ(s.rank(key), static_cast<std::size_t>(std::distance(
+                               std_s.begin(), std_s.lower_bound(key))));
+  }
+}
+
+TEST(MultisetTest, TransparentLookup) {
+  s21::multiset<std::string, std::less<>> s = {"a", "b", "b", "c"};
+  std::string_view key = "b";
+  EXPECT_EQ(s.count(key), 2);
+  EXPECT_TRUE(s.contains(key));
+  EXPECT_EQ(*s.lower_bound(key), "b");
+  EXPECT_EQ(*s.upper_bound(key), "c");
+  auto range = s.equal_range(key);
+  EXPECT_EQ(std::distance(range.first, range.second), 2);
+}
+
+TEST(MultisetTest, InsertHint) {
+  s21::multiset<int> s;
+  std::multiset<int> std_s;
+  for (int key = 0; key < 50; ++key) {
+    s.insert(s.end(), key / 2);
+    std_s.insert(std_s.end(), key / 2);
+  }
+  auto hint = s.find(10);
+  auto it = s.insert(hint, 10);
+  std_s.insert(10);
+  EXPECT_EQ(*it, 10);
+  EXPECT_TRUE(std::next(it) == hint);
+  s.emplace_hint(s.begin(), 30);
+  s.emplace_hint(s.end(), -5);
+  std_s.insert({30, -5});
+  ASSERT_EQ(s.size(), std_s.size());
+  EXPECT_TRUE(std::equal(s.begin(), s.end(), std_s.begin()));
+}
+
+TEST(MultisetTest, FindBatch) {
+  s21::multiset<int> s21_multiset;
+  for (int key = 0; key < 1000; ++key) {
+    s21_multiset.insert(key % 300);
+  }
+  std::vector<int> keys = {299, -1, 0, 150, 300, 7, 7, 1000};
+  std::vector<s21::multiset<int>::const_iterator> found;
+  const s21::multiset<int> &view = s21_multiset;
+  view.find_batch(keys.begin(), keys.end(), std::back_inserter(found));
+  ASSERT_EQ(found.size(), keys.size());
+  for (std::size_t i = 0; i < keys.size(); ++i) {
+    EXPECT_TRUE(found[i] == view.find(keys[i]));
+  }
+}
+
+TEST(MultisetTest, EraseKeyAndRange) {
+  s21::multiset<int> s21_multiset;
+  std::multiset<int> std_multiset;
+  for (int key = 0; key < 600; ++key) {
+    s21_multiset.insert(key % 20);
+    std_multiset.insert(key % 20);
+  }
+  EXPECT_EQ(s21_multiset.erase(7), 30U);
+  EXPECT_EQ(s21_multiset.erase(7), 0U);
+  std_multiset.erase(7);
+  // A range that starts and ends among equal keys.
+  auto first = std::next(s21_multiset.lower_bound(3), 10);
+  auto last = std::next(s21_multiset.lower_bound(12), 5);
+  s21_multiset.erase(first, last);
+  std_multiset.erase(std::next(std_multiset.lower_bound(3), 10),
+                     std::next(std_multiset.lower_bound(12), 5));
+  ASSERT_EQ(s21_multiset.size(), std_multiset.size());
+  EXPECT_TRUE(std::equal(s21_multiset.begin(), s21_multiset.end(),
+                         std_multiset.begin()));
+  auto below =
+      std::distance(std_multiset.begin(), std_multiset.lower_bound(12));
+  EXPECT_EQ(s21_multiset.erase_if([](int key) { return key < 12; }),
+            static_cast<std::size_t>(below));
+  EXPECT_EQ(*s21_multiset.begin(), 12);
+}
+
+TEST(MultisetTest, NodeHandle) {
+  s21::multiset<int> s21_multiset = {1, 2, 2, 3};
+  auto node = s21_multiset.extract(2);
+  EXPECT_EQ(node.value(), 2);
+  node.value() = 3;
+  auto it = s21_multiset.insert(std::move(node));
+  EXPECT_EQ(*it, 3);
+  EXPECT_EQ(s21_multiset.count(3), 2U);
+  EXPECT_EQ(s21_multiset.count(2), 1U);
+}
+
+TEST(MultisetTest, CountedMode) {
+  using counted = s21::multiset<int, std::less<int>, s21::counted_traits>;
+  counted s21_multiset;
+  std::multiset<int> std_multiset;
+  for (int i = 0; i < 5000; ++i) {
+    int key = i * 7919 % 37;
+    s21_multiset.insert(key);
+    std_multiset.insert(key);
+  }
+  EXPECT_EQ(s21_multiset.size(), std_multiset.size());
+  EXPECT_EQ(s21_multiset.distinct_size(), 37U);
+  EXPECT_TRUE(std::equal(s21_multiset.begin(), s21_multiset.end(),
+                         std_multiset.begin(), std_multiset.end()));
+  EXPECT_EQ(s21_multiset.count(5), std_multiset.count(5));
+  EXPECT_EQ(s21_multiset.erase(5), std_multiset.erase(5));
+  EXPECT_EQ(s21_multiset.count(5), 0U);
+  s21_multiset.erase(s21_multiset.find(6));
+  std_multiset.erase(std_multiset.find(6));
+  auto range = s21_multiset.equal_range(7);
+  EXPECT_EQ(std::distance(range.first, range.second),
+            static_cast<std::ptrdiff_t>(std_multiset.count(7)));
+  EXPECT_TRUE(range.second == s21_multiset.lower_bound(8));
+  auto it = s21_multiset.insert(40, 3);
+  std_multiset.insert({40, 40, 40});
+  EXPECT_EQ(*it, 40);
+  counted copy = s21_multiset;
+  copy.merge(s21_multiset);
+  EXPECT_TRUE(s21_multiset.empty());
+  ASSERT_EQ(copy.size(), std_multiset.size() * 2);
+  EXPECT_EQ(copy.count(40), 6U);
+}
+
+TEST(MultisetTest, CountedEraseKeepsLaterIterators) {
+  s21::multiset<int, std::less<int>, s21::counted_traits> s21_multiset = {
+      1, 1, 2};
+  auto next = std::next(s21_multiset.begin());
+  auto after = s21_multiset.erase(s21_multiset.begin());
+  EXPECT_EQ(*after, 1);
+  std::vector<int> rest(next, s21_multiset.end());
+  EXPECT_EQ(rest, std::vector<int>({1, 2}));
+  after = s21_multiset.erase(s21_multiset.begin());
+  EXPECT_EQ(*after, 2);
+  EXPECT_TRUE(after == s21_multiset.begin());
+  EXPECT_TRUE(s21_multiset.erase(after) == s21_multiset.end());
+  EXPECT_TRUE(s21_multiset.empty());
+}
+
+namespace {
+struct CountedOrderTraits : s21::counted_traits {
+  static constexpr bool kOrderStatistics = true;
+  static constexpr bool kStatistics = true;
+  static constexpr bool kThreaded = true;
+};
+}  // namespace
+
+TEST(MultisetTest, CountedModeWithOtherTraits) {
+  using counted = s21::multiset<int, std::less<int>, CountedOrderTraits>;
+  counted s21_multiset;
+  std::multiset<int> std_multiset;
+  for (int i = 0; i < 3000; ++i) {
+    int key = i * 7919 % 41;
+    s21_multiset.insert(key);
+    std_multiset.insert(key);
+  }
+  s21_multiset.insert(s21_multiset.find(3), 3);
+  s21_multiset.emplace_hint(s21_multiset.end(), 50);
+  s21_multiset.emplace(1, 2, 60);
+  std_multiset.insert({3, 50, 1, 2, 60});
+  ASSERT_EQ(s21_multiset.size(), std_multiset.size());
+  EXPECT_EQ(s21_multiset.stats().allocations, 43U);
+  auto std_it = std_multiset.begin();
+  for (std::size_t index = 0; index < std_multiset.size(); ++index) {
+    EXPECT_EQ(*s21_multiset.nth(index), *std_it++);
+  }
+  EXPECT_TRUE(s21_multiset.nth(std_multiset.size()) == s21_multiset.end());
+  for (int key = -1; key < 62; ++key) {
+    EXPECT_EQ(s21_multiset.rank(key),
+              static_cast<std::size_t>(std::distance(
+                  std_multiset.begin(), std_multiset.lower_bound(key))));
+  }
+  auto it = s21_multiset.erase(s21_multiset.nth(100), s21_multiset.nth(2000));
+  auto std_erased = std_multiset.erase(std::next(std_multiset.begin(), 100),
+                                       std::next(std_multiset.begin(), 2000));
+  EXPECT_EQ(*it, *std_erased);
+  it = s21_multiset.erase(s21_multiset.nth(10), s21_multiset.nth(12));
+  std_erased = std_multiset.erase(std::next(std_multiset.begin(), 10),
+                                  std::next(std_multiset.begin(), 12));
+  EXPECT_EQ(*it, *std_erased);
+  EXPECT_EQ(s21_multiset.erase_if([](int key) { return key % 2 == 1; }),
+            static_cast<std::size_t>(std::count_if(
+                std_multiset.begin(), std_multiset.end(),
+                [](int key) { return key % 2 == 1; })));
+  for (auto odd = std_multiset.begin(); odd != std_multiset.end();) {
+    odd = *odd % 2 == 1 ? std_multiset.erase(odd) : ++odd;
+  }
+  ASSERT_EQ(s21_multiset.size(), std_multiset.size());
+  EXPECT_TRUE(std::equal(s21_multiset.rbegin(), s21_multiset.rend(),
+                         std_multiset.rbegin(), std_multiset.rend()));
+  EXPECT_EQ(s21_multiset.rank(40),
+            static_cast<std::size_t>(std::distance(
+                std_multiset.begin(), std_multiset.lower_bound(40))));
+  std::vector<int> keys = {2, 3, 60, 61};
+  std::vector<counted::iterator> found;
+  s21_multiset.find_batch(keys.begin(), keys.end(),
+                          std::back_inserter(found));
+  std::vector<bool> contained;
+  s21_multiset.contains_batch(keys.begin(), keys.end(),
+                              std::back_inserter(contained));
+  ASSERT_EQ(found.size(), keys.size());
+  for (std::size_t i = 0; i < keys.size(); ++i) {
+    EXPECT_TRUE(found[i] == s21_multiset.find(keys[i]));
+    EXPECT_EQ(contained[i], s21_multiset.contains(keys[i]));
+  }
+}
+
+TEST(MultisetTest, ReverseIteration) {
+  std::vector<int> values = {4, 1, 4, 2, 4, 1};
+  std::multiset<int> std_multiset(values.begin(), values.end());
+  s21::multiset<int, std::less<int>, s21::threaded_traits> threaded(
+      values.begin(), values.end());
+  s21::multiset<int, std::less<int>, s21::counted_traits> counted(
+      values.begin(), values.end());
+  EXPECT_TRUE(std::equal(threaded.rbegin(), threaded.rend(),
+                         std_multiset.rbegin(), std_multiset.rend()));
+  EXPECT_TRUE(std::equal(counted.rbegin(), counted.rend(),
+                         std_multiset.rbegin(), std_multiset.rend()));
+  threaded.erase(threaded.find(4));
+  auto it = threaded.end();
+  --it;
+  --it;
+  EXPECT_EQ(*it, 4);
+  --it;
+  EXPECT_EQ(*it, 2);
+}
@@ -0,0 +1,93 @@
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <string>
+#include <thread>
+
+#include "../headers/s21_node_pool.h"
+#include "../s21_containers.h"
+
+TEST(node_pool, ReusesFreedSlots) {
+  s21::node_pool<long> pool;
+  long *first = pool.Allocate();
+  long *second = pool.Allocate();
+  EXPECT_NE(first, second);
+  pool.Deallocate(first);
+  EXPECT_EQ(pool.Allocate(), first);
+  EXPECT_EQ(pool.ChunkCount(), 1U);
+}
+
+TEST(node_pool, ReleaseDropsAllChunks) {
+  s21::node_pool<long> pool;
+  for (int i = 0; i < 1000; ++i) {
+    pool.Allocate();
+  }
+  EXPECT_GT(pool.ChunkCount(), 1U);
+  EXPECT_GE(pool.Capacity(), 1000U);
+  pool.Release();
+  EXPECT_EQ(pool.ChunkCount(), 0U);
+  EXPECT_EQ(pool.Capacity(), 0U);
+}
+
+TEST(node_pool, AbsorbMovesChunks) {
+  s21::node_pool<long, true> pool;
+  s21::node_pool<long, true> other;
+  long *slot = other.Allocate();
+  other.Deallocate(other.Allocate());
+  pool.Absorb(other);
+  EXPECT_EQ(other.ChunkCount(), 0U);
+  EXPECT_EQ(pool.ChunkCount(), 1U);
+  EXPECT_EQ(pool.Allocations(), 2U);
+  EXPECT_EQ(pool.Frees(), 1U);
+  EXPECT_NE(pool.Allocate(), slot);
+}
+
+TEST(node_pool, HandOverKeepsChunkAlive) {
+  s21::node_pool<long, true> pool;
+  auto other = std::make_unique<s21::node_pool<long, true>>();
+  long *slot = other->Allocate();
+  *slot = 42;
+  pool.TakeOver(other->HandOver(slot));
+  EXPECT_EQ(other->Frees(), 1U);
+  other.reset();
+  EXPECT_EQ(*slot, 42);
+  pool.Deallocate(slot);
+  EXPECT_EQ(pool.Allocate(), slot);
+  EXPECT_EQ(pool.Allocations(), 2U);
+}
+
+TEST(node_pool, MergedTreesOutliveEachOther) {
+  s21::set<std::string> *source = new s21::set<std::string>{"b", "d", "f"};
+  s21::set<std::string> target = {"a", "d"};
+  target.merge(*source);
+  source->insert("z");
+  delete source;
+  EXPECT_EQ(target.size(), 4U);
+  target.insert("c");
+  target.erase(target.find("b"));
+  target.clear();
+  target.insert("e");
+  EXPECT_TRUE(target.contains("e"));
+}
+
+TEST(node_pool, MergedTreesChangeOnDifferentThreads) {
+  s21::set<int> first;
+  s21::set<int> second;
+  for (int key = 0; key < 1000; ++key) {
+    first.insert(key * 2);
+    second.insert(key * 2 + 1);
+  }
+  first.merge(second);
+  second.insert(1);
+  auto churn = [](s21::set<int> &set, int base) {
+    for (int key = 0; key < 20000; ++key) {
+      set.insert(base + key % 500);
+      set.erase(set.find(base + key % 500));
+    }
+  };
+  std::thread worker([&] { churn(second, 100000); });
+  churn(first, 200000);
+  worker.join();
+  EXPECT_EQ(first.size(), 2000U);
+  EXPECT_EQ(second.size(), 1U);
+}
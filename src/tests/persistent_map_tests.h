@@ -0,0 +1,75 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <map>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../headers/s21_persistent_map.h"
+
+TEST(persistent_map, Insert_Erase_Random) {
+  s21::persistent_map<int, int> s21_map;
+  std::map<int, int> std_map;
+  std::mt19937 random(21);
+  for (int i = 0; i < 20000; ++i) {
+    int key = static_cast<int>(random() % 3000);
+    if (random() % 3 != 0) {
+      EXPECT_EQ(s21_map.insert(key, i).second,
+                std_map.insert({key, i}).second);
+    } else {
+      EXPECT_EQ(s21_map.erase(key), std_map.erase(key));
+    }
+  }
+  ASSERT_EQ(s21_map.size(), std_map.size());
+  EXPECT_TRUE(std::equal(s21_map.begin(), s21_map.end(), std_map.begin()));
+}
+
+TEST(persistent_map, Snapshot_Isolation) {
+  s21::persistent_map<int, std::string> s21_map = {{1, "one"}, {2, "two"}};
+  auto snapshot = s21_map.snapshot();
+  s21_map[1] = "uno";
+  s21_map.insert(3, "three");
+  s21_map.erase(2);
+  s21_map.insert_or_assign(4, "four");
+  EXPECT_EQ(snapshot.size(), 2U);
+  EXPECT_EQ(snapshot.at(1), "one");
+  EXPECT_EQ(snapshot.at(2), "two");
+  EXPECT_FALSE(snapshot.contains(3));
+  EXPECT_EQ(s21_map.at(1), "uno");
+  EXPECT_FALSE(s21_map.contains(2));
+  EXPECT_EQ(s21_map.size(), 3U);
+  EXPECT_THROW(snapshot.at(3), std::out_of_range);
+
+  snapshot.at(2) = "dos";
+  EXPECT_EQ(snapshot.at(2), "dos");
+  EXPECT_EQ(s21_map.count(2), 0U);
+}
+
+TEST(persistent_map, Snapshot_Across_Threads) {
+  s21::persistent_map<int, int> s21_map;
+  for (int key = 0; key < 10000; ++key) {
+    s21_map.insert(key, key);
+  }
+  std::vector<std::thread> readers;
+  std::vector<long long> sums(4);
+  for (std::size_t reader = 0; reader < sums.size(); ++reader) {
+    readers.emplace_back([&sums, reader, snapshot = s21_map.snapshot()] {
+      for (const auto &item : snapshot) {
+        sums[reader] += item.second;
+      }
+    });
+  }
+  for (int key = 0; key < 10000; ++key) {
+    s21_map[key] = -1;
+  }
+  for (std::thread &reader : readers) {
+    reader.join();
+  }
+  for (long long sum : sums) {
+    EXPECT_EQ(sum, 49995000LL);
+  }
+  EXPECT_EQ(s21_map.at(5000), -1);
+}
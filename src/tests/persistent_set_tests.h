@@ -0,0 +1,44 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <set>
+#include <vector>
+
+#include "../headers/s21_persistent_set.h"
+
+TEST(persistent_set, Versions) {
+  s21::persistent_set<int> s21_set;
+  std::set<int> std_set;
+  std::vector<s21::persistent_set<int>> versions;
+  std::vector<std::set<int>> std_versions;
+  for (int i = 0; i < 3000; ++i) {
+    int key = i * 7919 % 1000;
+    if (i % 4 == 3) {
+      EXPECT_EQ(s21_set.erase(key), std_set.erase(key));
+    } else {
+      EXPECT_EQ(s21_set.insert(key).second, std_set.insert(key).second);
+    }
+    if (i % 500 == 0) {
+      versions.push_back(s21_set.snapshot());
+      std_versions.push_back(std_set);
+    }
+  }
+  EXPECT_TRUE(std::equal(s21_set.begin(), s21_set.end(), std_set.begin(),
+                         std_set.end()));
+  for (std::size_t i = 0; i < versions.size(); ++i) {
+    EXPECT_TRUE(std::equal(versions[i].begin(), versions[i].end(),
+                           std_versions[i].begin(), std_versions[i].end()));
+  }
+}
+
+TEST(persistent_set, Find) {
+  s21::persistent_set<int> s21_set = {5, 1, 9, 3};
+  auto it = s21_set.find(3);
+  ASSERT_TRUE(it != s21_set.end());
+  EXPECT_EQ(*it, 3);
+  EXPECT_EQ(*++it, 5);
+  EXPECT_TRUE(s21_set.find(4) == s21_set.end());
+  s21_set.clear();
+  EXPECT_TRUE(s21_set.empty());
+  EXPECT_TRUE(s21_set.begin() == s21_set.end());
+}
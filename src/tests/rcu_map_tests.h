@@ -0,0 +1,70 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "../headers/s21_rcu_map.h"
+
+TEST(rcu_map, Basic_Operations) {
+  s21::rcu_map<int, int> map = {{1, 10}, {2, 20}};
+  EXPECT_EQ(map.size(), 2U);
+  EXPECT_TRUE(map.insert(3, 30));
+  EXPECT_FALSE(map.insert(3, 31));
+  EXPECT_EQ(map.at(3), 30);
+  map.insert_or_assign(3, 33);
+  EXPECT_EQ(map.find(3), 33);
+  EXPECT_EQ(map.erase(1), 1U);
+  EXPECT_EQ(map.erase(1), 0U);
+  EXPECT_FALSE(map.contains(1));
+  EXPECT_FALSE(map.find(1).has_value());
+  EXPECT_THROW(map.at(1), std::out_of_range);
+
+  auto snapshot = map.snapshot();
+  map.clear();
+  EXPECT_TRUE(map.empty());
+  EXPECT_EQ(snapshot.size(), 2U);
+  EXPECT_EQ(snapshot.at(2), 20);
+}
+
+TEST(rcu_map, Readers_See_Whole_Updates) {
+  const int count = 500;
+  s21::rcu_map<int, int> map;
+  map.update([&](auto &version) {
+    for (int key = 0; key < count; ++key) {
+      version[key] = 0;
+    }
+  });
+  std::atomic<bool> done{false};
+  std::atomic<int> torn{0};
+  std::vector<std::thread> readers;
+  for (int reader = 0; reader < 4; ++reader) {
+    readers.emplace_back([&] {
+      while (!done.load()) {
+        int seen = 0;
+        bool started = false;
+        int first = 0;
+        map.for_each([&](const auto &item) {
+          seen += !started || item.second == first ? 0 : 1;
+          started = true;
+          first = item.second;
+        });
+        torn += seen;
+      }
+    });
+  }
+  for (int round = 1; round <= 100; ++round) {
+    map.update([&](auto &version) {
+      for (int key = 0; key < count; ++key) {
+        version[key] = round;
+      }
+    });
+  }
+  done = true;
+  for (std::thread &reader : readers) {
+    reader.join();
+  }
+  EXPECT_EQ(torn.load(), 0);
+  EXPECT_EQ(map.at(count - 1), 100);
+}
@@ -1,8 +1,13 @@
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <iterator>
 #include <set>
+#include <string>
+#include <string_view>
 #include <unordered_set>
+#include <vector>
 
 #include "../s21_containers.h"
 
@@ -283,6 +288,41 @@ TEST(set, Modifier_Merge) {
   EXPECT_EQ(s21_set_1.size(), s21_set_3.size());
 }
 
+TEST(set, Modifier_Merge_Large) {
+  s21::set<int> s21_set_1;
+  s21::set<int> s21_set_2;
+  std::set<int> std_set_1;
+  std::set<int> std_set_2;
+  for (int i = 0; i < 2000; ++i) {
+    s21_set_1.insert(i * 3);
+    std_set_1.insert(i * 3);
+  }
+  for (int i = 0; i < 500; ++i) {
+    s21_set_2.insert(i * 7);
+    std_set_2.insert(i * 7);
+  }
+  const int *moved = &*s21_set_2.find(7);
+  const int *kept = &*s21_set_2.find(21);
+  s21_set_1.merge(s21_set_2);
+  std_set_1.merge(std_set_2);
+  EXPECT_EQ(&*s21_set_1.find(7), moved);
+  EXPECT_EQ(&*s21_set_2.find(21), kept);
+  EXPECT_EQ(s21_set_1.size(), std_set_1.size());
+  EXPECT_EQ(s21_set_2.size(), std_set_2.size());
+  auto it1 = s21_set_1.begin();
+  for (int key : std_set_1) {
+    EXPECT_EQ(*it1, key);
+    ++it1;
+  }
+  auto it2 = s21_set_2.begin();
+  for (int key : std_set_2) {
+    EXPECT_EQ(*it2, key);
+    ++it2;
+  }
+  s21_set_2.insert(1);
+  EXPECT_TRUE(s21_set_2.contains(1));
+}
+
 TEST(set, Lookup_Contains) {
   s21::set<int> s21_set;
   s21_set.insert(1);
@@ -373,4 +413,420 @@ TEST(set, Rehash_And_Insert_In_Collision) {
     EXPECT_TRUE(s21_set.find(i) != s21_set.end());
   }
   EXPECT_EQ(s21_set.size(), std_set.size());
-}
\ No newline at end of file
+}
+
+TEST(set, Constructor_Range_Sorted) {
+  std::vector<int> keys = {1, 2, 2, 3, 5, 8, 8, 13};
+  s21::set<int> s21_set(keys.begin(), keys.end());
+  std::set<int> std_set(keys.begin(), keys.end());
+  EXPECT_EQ(s21_set.size(), std_set.size());
+  auto it = s21_set.begin();
+  for (int key : std_set) {
+    EXPECT_EQ(*it, key);
+    ++it;
+  }
+  EXPECT_TRUE(it == s21_set.end());
+}
+
+TEST(set, Constructor_Range_Unsorted) {
+  std::vector<int> keys = {5, 1, 8, 3, 1};
+  s21::set<int> s21_set(keys.begin(), keys.end());
+  std::set<int> std_set(keys.begin(), keys.end());
+  EXPECT_EQ(s21_set.size(), std_set.size());
+  for (int key : std_set) {
+    EXPECT_TRUE(s21_set.contains(key));
+  }
+}
+
+TEST(set, Assign_Sorted) {
+  s21::set<int> s21_set = {100, 200};
+  std::vector<int> keys(1000);
+  for (int i = 0; i < 1000; ++i) {
+    keys[i] = i * 2;
+  }
+  s21_set.assign_sorted(keys.begin(), keys.end());
+  EXPECT_EQ(s21_set.size(), 1000U);
+  EXPECT_EQ(*s21_set.begin(), 0);
+  EXPECT_FALSE(s21_set.insert(100).second);
+  EXPECT_TRUE(s21_set.insert(101).second);
+  for (int i = 0; i < 1000; i += 3) {
+    s21_set.erase(s21_set.find(i * 2));
+  }
+  int previous = -1;
+  for (int key : s21_set) {
+    EXPECT_LT(previous, key);
+    previous = key;
+  }
+  s21_set.assign_sorted(keys.begin(), keys.begin());
+  EXPECT_TRUE(s21_set.empty());
+}
+
+TEST(set, Set_Algebra) {
+  s21::set<int> first;
+  s21::set<int> second;
+  std::set<int> std_first;
+  std::set<int> std_second;
+  for (int i = 0; i < 30000; ++i) {
+    first.insert(i * 2);
+    std_first.insert(i * 2);
+    second.insert(i * 3);
+    std_second.insert(i * 3);
+  }
+  s21::thread_pool pool(3);
+  std::vector<int> expected;
+  std::set_union(std_first.begin(), std_first.end(), std_second.begin(),
+                 std_second.end(), std::back_inserter(expected));
+  s21::set<int> result = s21::set_union(first, second, pool);
+  EXPECT_TRUE(std::equal(result.begin(), result.end(), expected.begin()));
+  EXPECT_EQ(result.size(), expected.size());
+
+  expected.clear();
+  std::set_intersection(std_first.begin(), std_first.end(),
+                        std_second.begin(), std_second.end(),
+                        std::back_inserter(expected));
+  result = s21::set_intersection(first, second, pool);
+  EXPECT_TRUE(std::equal(result.begin(), result.end(), expected.begin()));
+  EXPECT_EQ(result.size(), expected.size());
+
+  expected.clear();
+  std::set_difference(std_first.begin(), std_first.end(), std_second.begin(),
+                      std_second.end(), std::back_inserter(expected));
+  result = s21::set_difference(first, second);
+  EXPECT_TRUE(std::equal(result.begin(), result.end(), expected.begin()));
+  EXPECT_EQ(result.size(), expected.size());
+  EXPECT_EQ(first.size(), std_first.size());
+  EXPECT_EQ(second.size(), std_second.size());
+}
+
+TEST(set, Set_Algebra_Empty) {
+  s21::set<int> empty;
+  s21::set<int> some = {1, 2, 3};
+  EXPECT_EQ(s21::set_union(empty, some).size(), 3U);
+  EXPECT_EQ(s21::set_union(some, empty).size(), 3U);
+  EXPECT_TRUE(s21::set_intersection(some, empty).empty());
+  EXPECT_EQ(s21::set_difference(some, empty).size(), 3U);
+  EXPECT_TRUE(s21::set_difference(empty, some).empty());
+}
+
+TEST(set, Order_Statistics) {
+  using ordered_set =
+      s21::set<int, std::less<int>, s21::order_statistics_traits>;
+  ordered_set s21_set;
+  std::vector<int> keys;
+  for (int i = 0; i < 1000; ++i) {
+    keys.push_back((i * 7919) % 1000 * 2);
+  }
+  for (int key : keys) {
+    s21_set.insert(key);
+  }
+  ordered_set merged(keys.begin(), keys.begin() + 10);
+  ordered_set other = {-3, 1, 5001};
+  merged.merge(other);
+  EXPECT_EQ(*merged.nth(0), -3);
+  EXPECT_EQ(*merged.nth(12), 5001);
+  EXPECT_EQ(merged.rank(5001), 12U);
+
+  for (int i = 0; i < 1000; ++i) {
+    EXPECT_EQ(*s21_set.nth(i), 2 * i);
+    EXPECT_EQ(s21_set.rank(2 * i), static_cast<std::size_t>(i));
+    EXPECT_EQ(s21_set.rank(2 * i + 1), static_cast<std::size_t>(i + 1));
+  }
+  s21_set.erase(s21_set.nth(500));
+  EXPECT_EQ(*s21_set.nth(500), 1002);
+  EXPECT_EQ(s21_set.count(1000), 0U);
+  EXPECT_EQ(s21_set.count(1002), 1U);
+  EXPECT_TRUE(s21_set.nth(999) == s21_set.end());
+}
+
+TEST(set, Transparent_Lookup) {
+  s21::set<std::string, std::less<>> s21_set = {"alpha", "beta", "gamma"};
+  std::string_view key = "beta";
+  EXPECT_EQ(*s21_set.find(key), "beta");
+  EXPECT_TRUE(s21_set.contains(key));
+  EXPECT_FALSE(s21_set.contains(std::string_view("delta")));
+  EXPECT_EQ(s21_set.count(std::string_view("gamma")), 1U);
+  EXPECT_TRUE(s21_set.find(std::string_view("omega")) == s21_set.end());
+}
+
+TEST(set, Insert_Hint) {
+  s21::set<int> s21_set;
+  std::set<int> std_set;
+  for (int key = 0; key < 100; ++key) {
+    auto it = s21_set.insert(s21_set.end(), 2 * key);
+    std_set.insert(std_set.end(), 2 * key);
+    EXPECT_EQ(*it, 2 * key);
+  }
+  auto hint = s21_set.find(50);
+  EXPECT_EQ(*s21_set.insert(hint, 49), 49);
+  EXPECT_TRUE(s21_set.insert(hint, 50) == hint);
+  EXPECT_EQ(*s21_set.insert(s21_set.begin(), 101), 101);
+  EXPECT_EQ(*s21_set.emplace_hint(s21_set.begin(), -1), -1);
+  std_set.insert({49, 101, -1});
+  EXPECT_EQ(s21_set.size(), std_set.size());
+  EXPECT_TRUE(std::equal(s21_set.begin(), s21_set.end(), std_set.begin()));
+}
+
+TEST(set, Copy_Large) {
+  s21::set<std::string> s21_set;
+  for (int key = 0; key < 40000; ++key) {
+    s21_set.insert(std::to_string(key));
+  }
+  s21::set<std::string> copy(s21_set);
+  ASSERT_EQ(copy.size(), s21_set.size());
+  EXPECT_TRUE(std::equal(copy.begin(), copy.end(), s21_set.begin()));
+  s21::set<std::string> merged = {"x"};
+  merged.merge(copy);
+  EXPECT_EQ(merged.size(), 40001U);
+  merged.clear();
+  copy.insert("y");
+  EXPECT_EQ(copy.size(), 1U);
+  s21_set.clear();
+  EXPECT_TRUE(s21_set.empty());
+}
+
+TEST(set, Compact_Nodes) {
+  using compact_set = s21::set<long, std::less<long>, s21::compact_traits>;
+  EXPECT_LT(compact_set::tree_type::NodeSize(),
+            s21::set<long>::tree_type::NodeSize());
+  compact_set s21_set;
+  std::set<long> std_set;
+  for (long key = 0; key < 2000; ++key) {
+    long value = key * 7919 % 2000;
+    s21_set.insert(value);
+    std_set.insert(value);
+  }
+  for (long key = 0; key < 2000; key += 3) {
+    s21_set.erase(s21_set.find(key));
+    std_set.erase(key);
+  }
+  compact_set copy(s21_set);
+  ASSERT_EQ(copy.size(), std_set.size());
+  EXPECT_TRUE(std::equal(copy.begin(), copy.end(), std_set.begin()));
+}
+
+TEST(set, Find_Batch) {
+  s21::set<int> s21_set;
+  for (int key = 0; key < 3000; key += 2) {
+    s21_set.insert(key);
+  }
+  std::vector<int> keys;
+  for (int key = -5; key < 3005; ++key) {
+    keys.push_back(key * 7 % 3010);
+  }
+  std::vector<s21::set<int>::iterator> found;
+  s21_set.find_batch(keys.begin(), keys.end(), std::back_inserter(found));
+  std::vector<bool> contained;
+  s21_set.contains_batch(keys.begin(), keys.end(),
+                         std::back_inserter(contained));
+  ASSERT_EQ(found.size(), keys.size());
+  ASSERT_EQ(contained.size(), keys.size());
+  for (std::size_t i = 0; i < keys.size(); ++i) {
+    EXPECT_TRUE(found[i] == s21_set.find(keys[i]));
+    EXPECT_EQ(contained[i], s21_set.contains(keys[i]));
+  }
+}
+
+TEST(set, Erase_Range) {
+  s21::set<int> s21_set;
+  std::set<int> std_set;
+  for (int key = 0; key < 1000; ++key) {
+    s21_set.insert(key);
+    std_set.insert(key);
+  }
+  auto first = s21_set.find(100);
+  auto last = s21_set.find(900);
+  auto it = s21_set.erase(first, last);
+  std_set.erase(std_set.find(100), std_set.find(900));
+  EXPECT_EQ(*it, 900);
+  s21_set.erase(s21_set.find(950), s21_set.end());
+  std_set.erase(std_set.find(950), std_set.end());
+  s21_set.erase(s21_set.begin(), s21_set.find(3));
+  std_set.erase(std_set.begin(), std_set.find(3));
+  EXPECT_EQ(s21_set.erase(50), 1U);
+  EXPECT_EQ(s21_set.erase(50), 0U);
+  std_set.erase(50);
+  ASSERT_EQ(s21_set.size(), std_set.size());
+  EXPECT_TRUE(std::equal(s21_set.begin(), s21_set.end(), std_set.begin()));
+  s21_set.erase(s21_set.begin(), s21_set.end());
+  EXPECT_TRUE(s21_set.empty());
+}
+
+TEST(set, Erase_If) {
+  s21::set<int> s21_set;
+  for (int key = 0; key < 1000; ++key) {
+    s21_set.insert(key);
+  }
+  EXPECT_EQ(s21_set.erase_if([](int key) { return key % 3 != 0; }), 666U);
+  EXPECT_EQ(s21_set.size(), 334U);
+  int expected = 0;
+  for (int key : s21_set) {
+    EXPECT_EQ(key, expected);
+    expected += 3;
+  }
+  EXPECT_EQ(*s21_set.begin(), 0);
+  s21_set.insert(1000);
+  EXPECT_TRUE(s21_set.contains(1000));
+}
+
+TEST(set, Node_Handle) {
+  s21::set<std::string> s21_set = {"apple", "fig", "pear"};
+  s21::set<std::string>::node_type node = s21_set.extract("fig");
+  ASSERT_FALSE(node.empty());
+  EXPECT_EQ(s21_set.size(), 2U);
+  node.value() = "kiwi";
+  auto result = s21_set.insert(std::move(node));
+  EXPECT_TRUE(result.inserted);
+  EXPECT_EQ(*result.position, "kiwi");
+  EXPECT_TRUE(node.empty());
+  node = s21_set.extract(s21_set.begin());
+  node.value() = "pear";
+  result = s21_set.insert(std::move(node));
+  EXPECT_FALSE(result.inserted);
+  EXPECT_EQ(result.node.value(), "pear");
+  EXPECT_TRUE(s21_set.extract("plum").empty());
+  std::vector<std::string> expected = {"kiwi", "pear"};
+  EXPECT_TRUE(std::equal(s21_set.begin(), s21_set.end(), expected.begin(),
+                         expected.end()));
+}
+
+TEST(set, Emplace_In_Place) {
+  s21::set<std::string> s21_set;
+  auto result =
+      s21_set.emplace(std::string("fig"), "apple", std::string(3, 'z'));
+  ASSERT_EQ(result.size(), 3U);
+  EXPECT_TRUE(result[0].second && result[1].second && result[2].second);
+  std::string duplicate = "fig";
+  result = s21_set.emplace(std::move(duplicate));
+  EXPECT_FALSE(result[0].second);
+  EXPECT_EQ(duplicate, "fig");
+  auto it = s21_set.emplace_hint(s21_set.end(), 2, 'q');
+  EXPECT_EQ(*it, "qq");
+  EXPECT_EQ(s21_set.size(), 4U);
+}
+
+TEST(set, Statistics) {
+  using stats_set = s21::set<int, std::less<int>, s21::statistics_traits>;
+  EXPECT_EQ(stats_set::tree_type::NodeSize(),
+            s21::set<int>::tree_type::NodeSize());
+  stats_set s21_set;
+  for (int key = 0; key < 1023; ++key) {
+    s21_set.insert(key);
+  }
+  s21::tree_stats stats = s21_set.stats();
+  EXPECT_GT(stats.comparisons, 1023U);
+  EXPECT_GT(stats.rotations, 0U);
+  EXPECT_GT(stats.recolorings, 0U);
+  EXPECT_EQ(stats.allocations, 1023U);
+  EXPECT_EQ(stats.frees, 0U);
+  std::size_t nodes = 0;
+  for (std::size_t count : stats.depth_histogram) {
+    nodes += count;
+  }
+  EXPECT_EQ(nodes, 1023U);
+  EXPECT_EQ(stats.depth_histogram[0], 1U);
+  EXPECT_LE(stats.depth_histogram.size(), 20U);
+  s21_set.erase(s21_set.begin());
+  s21_set.erase(s21_set.find(1022));
+  s21_set.erase(s21_set.find(500));
+  stats = s21_set.stats();
+  EXPECT_EQ(stats.extreme_updates, 2U);
+  EXPECT_EQ(stats.frees, 3U);
+  stats_set copy(s21_set);
+  EXPECT_EQ(copy.stats().allocations, 1020U);
+  s21_set.clear();
+  stats = s21_set.stats();
+  EXPECT_EQ(stats.frees, stats.allocations);
+  EXPECT_TRUE(stats.depth_histogram.empty());
+}
+
+TEST(set, Statistics_Swap) {
+  using stats_set = s21::set<int, std::less<int>, s21::statistics_traits>;
+  stats_set small;
+  stats_set large;
+  for (int key = 0; key < 10; ++key) {
+    small.insert(key);
+  }
+  for (int key = 0; key < 1000; ++key) {
+    large.insert(key);
+  }
+  s21::tree_stats small_stats = small.stats();
+  s21::tree_stats large_stats = large.stats();
+  small.swap(large);
+  EXPECT_EQ(small.stats().comparisons, large_stats.comparisons);
+  EXPECT_EQ(small.stats().rotations, large_stats.rotations);
+  EXPECT_EQ(small.stats().allocations, 1000U);
+  EXPECT_EQ(large.stats().comparisons, small_stats.comparisons);
+  EXPECT_EQ(large.stats().rotations, small_stats.rotations);
+  EXPECT_EQ(large.stats().allocations, 10U);
+  stats_set moved(std::move(small));
+  EXPECT_EQ(moved.stats().comparisons, large_stats.comparisons);
+  EXPECT_EQ(moved.stats().recolorings, large_stats.recolorings);
+  stats_set assigned;
+  assigned = std::move(moved);
+  EXPECT_EQ(assigned.stats().comparisons, large_stats.comparisons);
+  EXPECT_EQ(assigned.stats().allocations, 1000U);
+}
+
+TEST(set, Threaded_And_Reverse) {
+  using threaded_set = s21::set<int, std::less<int>, s21::threaded_traits>;
+  threaded_set s21_set;
+  std::set<int> std_set;
+  for (int i = 0; i < 3000; ++i) {
+    int key = i * 7919 % 4001;
+    s21_set.insert(key);
+    std_set.insert(key);
+    if (i % 4 == 0) {
+      s21_set.erase(s21_set.find(key));
+      std_set.erase(key);
+    }
+  }
+  auto node = s21_set.extract(s21_set.begin());
+  int extracted = node.value();
+  std_set.erase(std_set.begin());
+  for (int key : {2000, 3000}) {
+    s21_set.insert(key);
+    std_set.insert(key);
+  }
+  s21_set.erase(s21_set.find(2000), s21_set.find(3000));
+  std_set.erase(std_set.find(2000), std_set.find(3000));
+  s21_set.erase_if([](int key) { return key % 5 == 0; });
+  for (auto it = std_set.begin(); it != std_set.end();) {
+    it = *it % 5 == 0 ? std_set.erase(it) : std::next(it);
+  }
+  s21_set.insert(std::move(node));
+  std_set.insert(extracted);
+  threaded_set other{-5, -1, 5000};
+  s21_set.merge(other);
+  std_set.insert({-5, -1, 5000});
+  EXPECT_TRUE(std::equal(s21_set.begin(), s21_set.end(), std_set.begin(),
+                         std_set.end()));
+  EXPECT_TRUE(std::equal(s21_set.rbegin(), s21_set.rend(), std_set.rbegin(),
+                         std_set.rend()));
+  const threaded_set copy(s21_set);
+  EXPECT_TRUE(std::equal(copy.rbegin(), copy.rend(), std_set.rbegin(),
+                         std_set.rend()));
+  auto last = s21_set.end();
+  --last;
+  EXPECT_EQ(*last, 5000);
+  s21::set<int> plain{1, 2, 3};
+  std::vector<int> reversed(plain.rbegin(), plain.rend());
+  EXPECT_EQ(reversed, std::vector<int>({3, 2, 1}));
+  s21_set.clear();
+  EXPECT_TRUE(s21_set.rbegin() == s21_set.rend());
+}
+
+TEST(set, Clear_Large_Shared_Pool) {
+  using stats_set =
+      s21::set<std::string, std::less<std::string>, s21::statistics_traits>;
+  stats_set s21_set;
+  for (int key = 0; key < 40000; ++key) {
+    s21_set.insert("key number " + std::to_string(key));
+  }
+  stats_set other{"merged"};
+  s21_set.merge(other);
+  s21_set.clear();
+  s21::tree_stats stats = s21_set.stats();
+  EXPECT_EQ(stats.allocations, 40001U);
+  EXPECT_EQ(stats.frees, stats.allocations);
+  EXPECT_TRUE(s21_set.empty());
+}
@@ -0,0 +1,56 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <stdexcept>
+
+#include "../headers/s21_thread_pool.h"
+
+namespace {
+long ParallelSum(s21::thread_pool &pool, long first, long last) {
+  if (last - first < 64) {
+    long sum = 0;
+    for (long value = first; value < last; ++value) {
+      sum += value;
+    }
+    return sum;
+  }
+  long middle = first + (last - first) / 2;
+  long left = 0;
+  long right = 0;
+  pool.Invoke([&] { left = ParallelSum(pool, first, middle); },
+              [&] { right = ParallelSum(pool, middle, last); });
+  return left + right;
+}
+}  // namespace
+
+TEST(thread_pool, NestedInvoke) {
+  s21::thread_pool pool(4);
+  EXPECT_EQ(pool.Size(), 4U);
+  EXPECT_EQ(pool.ThisThreadIndex(), 0U);
+  EXPECT_EQ(ParallelSum(pool, 0, 100000), 4999950000L);
+}
+
+TEST(thread_pool, SingleThread) {
+  s21::thread_pool pool(1);
+  EXPECT_EQ(pool.Size(), 1U);
+  EXPECT_EQ(ParallelSum(pool, 0, 1000), 499500L);
+}
+
+TEST(thread_pool, RethrowsTaskException) {
+  s21::thread_pool pool(2);
+  std::atomic<int> runs{0};
+  EXPECT_THROW(pool.Invoke([&] { ++runs; },
+                           [&] {
+                             ++runs;
+                             throw std::runtime_error("task");
+                           }),
+               std::runtime_error);
+  EXPECT_EQ(runs.load(), 2);
+}
+
+TEST(thread_pool, SharedIfAlive) {
+  s21::thread_pool pool(2);
+  s21::thread_pool &shared = s21::thread_pool::Shared();
+  EXPECT_EQ(s21::thread_pool::SharedIfAlive(), &shared);
+  EXPECT_NE(s21::thread_pool::SharedIfAlive(), &pool);
+}